@@ -83,6 +83,8 @@
 #include "cally-actor.h"
 #include "cally-actor-private.h"
 
+#include "clutter-actor-private.h"
+
 typedef struct _CallyActorActionInfo CallyActorActionInfo;
 
 /*< private >
@@ -172,6 +174,13 @@ static void cally_actor_notify_clutter          (GObject    *obj,
                                                 GParamSpec *pspec);
 static void cally_actor_real_notify_clutter     (GObject    *obj,
                                                  GParamSpec *pspec);
+static void cally_actor_update_children         (CallyActor   *self,
+                                                 ClutterActor *actor);
+static gint cally_actor_find_child_index        (ClutterActor *container,
+                                                 ClutterActor *child);
+static gint cally_actor_get_child_index         (CallyActor   *self,
+                                                 ClutterActor *actor,
+                                                 ClutterActor *child);
 
 struct _CallyActorPrivate
 {
@@ -179,7 +188,17 @@ struct _CallyActorPrivate
   guint   action_idle_handler;
   GList  *action_list;
 
-  GList *children;
+  /* cache of the children of the actor, used to map between children
+   * and their index in O(1); children_first is the number of slots at
+   * the start of the array that were freed by removing the first child,
+   * and children_age is the age of the list of children of the actor
+   * at the time the cache was last updated
+   */
+  GPtrArray  *children;
+  GHashTable *children_index;
+  guint       children_first;
+  gint        children_age;
+  guint       children_valid : 1;
 };
 
 G_DEFINE_TYPE_WITH_CODE (CallyActor,
@@ -240,7 +259,12 @@ cally_actor_initialize (AtkObject *obj,
   g_object_set_data (G_OBJECT (obj), "atk-component-layer",
                      GINT_TO_POINTER (ATK_LAYER_MDI));
 
-  priv->children = clutter_actor_get_children (actor);
+  /* lets the children find the cache of their index, without creating
+   * the accessible of the actor if it does not exist yet
+   */
+  g_object_set_data (G_OBJECT (actor), "cally-actor", obj);
+
+  cally_actor_update_children (self, actor);
 
   /*
    * We store the handler ids for these signals in case some objects
@@ -298,7 +322,8 @@ cally_actor_init (CallyActor *cally_actor)
 
   priv->action_list = NULL;
 
-  priv->children = NULL;
+  priv->children = g_ptr_array_new ();
+  priv->children_index = g_hash_table_new (NULL, NULL);
 }
 
 static void
@@ -306,10 +331,16 @@ cally_actor_finalize (GObject *obj)
 {
   CallyActor        *cally_actor = NULL;
   CallyActorPrivate *priv       = NULL;
+  ClutterActor      *actor      = NULL;
 
   cally_actor = CALLY_ACTOR (obj);
   priv = cally_actor->priv;
 
+  actor = CALLY_GET_CLUTTER_ACTOR (cally_actor);
+  if (actor != NULL &&
+      g_object_get_data (G_OBJECT (actor), "cally-actor") == obj)
+    g_object_set_data (G_OBJECT (actor), "cally-actor", NULL);
+
   _cally_actor_clean_action_list (cally_actor);
 
   if (priv->action_idle_handler)
@@ -323,11 +354,8 @@ cally_actor_finalize (GObject *obj)
       g_queue_free (priv->action_queue);
     }
 
-  if (priv->children)
-    {
-      g_list_free (priv->children);
-      priv->children = NULL;
-    }
+  g_ptr_array_unref (priv->children);
+  g_hash_table_unref (priv->children_index);
 
   G_OBJECT_CLASS (cally_actor_parent_class)->finalize (obj);
 }
@@ -373,8 +401,7 @@ cally_actor_get_index_in_parent (AtkObject *obj)
   CallyActor *cally_actor = NULL;
   ClutterActor *actor = NULL;
   ClutterActor *parent_actor = NULL;
-  ClutterActor *iter;
-  gint index = -1;
+  AtkObject *parent;
 
   g_return_val_if_fail (CALLY_IS_ACTOR (obj), -1);
 
@@ -404,19 +431,18 @@ cally_actor_get_index_in_parent (AtkObject *obj)
   if (actor == NULL) /* Object is defunct */
     return -1;
 
-  index = 0;
   parent_actor = clutter_actor_get_parent (actor);
   if (parent_actor == NULL)
     return -1;
 
-  for (iter = clutter_actor_get_first_child (parent_actor);
-       iter != NULL && iter != actor;
-       iter = clutter_actor_get_next_sibling (iter))
-    {
-      index += 1;
-    }
+  /* use the cache of the accessible of the parent, if it exists */
+  parent = g_object_get_data (G_OBJECT (parent_actor), "cally-actor");
+  if (parent != NULL)
+    return cally_actor_get_child_index (CALLY_ACTOR (parent),
+                                        parent_actor,
+                                        actor);
 
-  return index;
+  return cally_actor_find_child_index (parent_actor, actor);
 }
 
 static AtkStateSet*
@@ -494,6 +520,7 @@ static AtkObject*
 cally_actor_ref_child (AtkObject *obj,
                        gint       i)
 {
+  CallyActorPrivate *priv;
   ClutterActor *actor = NULL;
   ClutterActor *child = NULL;
 
@@ -505,10 +532,15 @@ cally_actor_ref_child (AtkObject *obj,
 
   g_return_val_if_fail (CLUTTER_IS_ACTOR (actor), NULL);
 
-  if (i >= clutter_actor_get_n_children (actor))
+  if (i < 0 || i >= clutter_actor_get_n_children (actor))
     return NULL;
 
-  child = clutter_actor_get_child_at_index (actor, i);
+  priv = CALLY_ACTOR (obj)->priv;
+  if (!priv->children_valid ||
+      priv->children_age != _clutter_actor_get_children_age (actor))
+    cally_actor_update_children (CALLY_ACTOR (obj), actor);
+
+  child = g_ptr_array_index (priv->children, priv->children_first + i);
   if (child == NULL)
     return NULL;
 
@@ -530,6 +562,175 @@ cally_actor_get_attributes (AtkObject *obj)
   return attributes;
 }
 
+/* Children cache */
+
+static void
+cally_actor_update_children (CallyActor   *self,
+                             ClutterActor *actor)
+{
+  CallyActorPrivate *priv = self->priv;
+  ClutterActor *iter;
+
+  g_ptr_array_set_size (priv->children, 0);
+  g_hash_table_remove_all (priv->children_index);
+  priv->children_first = 0;
+
+  /* the index is stored with a bias of one, so that a NULL value
+   * can be used to mark children that are not in the cache
+   */
+  for (iter = clutter_actor_get_first_child (actor);
+       iter != NULL;
+       iter = clutter_actor_get_next_sibling (iter))
+    {
+      g_hash_table_insert (priv->children_index, iter,
+                           GUINT_TO_POINTER (priv->children->len + 1));
+      g_ptr_array_add (priv->children, iter);
+    }
+
+  priv->children_age = _clutter_actor_get_children_age (actor);
+  priv->children_valid = TRUE;
+}
+
+static gint
+cally_actor_get_child_index (CallyActor   *self,
+                             ClutterActor *actor,
+                             ClutterActor *child)
+{
+  CallyActorPrivate *priv = self->priv;
+  guint index;
+
+  if (!priv->children_valid ||
+      priv->children_age != _clutter_actor_get_children_age (actor))
+    cally_actor_update_children (self, actor);
+
+  index = GPOINTER_TO_UINT (g_hash_table_lookup (priv->children_index, child));
+  if (index == 0)
+    return -1;
+
+  return index - 1 - priv->children_first;
+}
+
+/* Computes the index of @child inside @container, without using the
+ * cache, by walking the siblings of @child towards the closest end of
+ * the list of children
+ */
+static gint
+cally_actor_find_child_index (ClutterActor *container,
+                              ClutterActor *child)
+{
+  ClutterActor *prev, *next;
+  gint n_children, i;
+
+  n_children = clutter_actor_get_n_children (container);
+  prev = next = child;
+  for (i = 0; ; i++)
+    {
+      prev = clutter_actor_get_previous_sibling (prev);
+      if (prev == NULL)
+        return i;
+
+      next = clutter_actor_get_next_sibling (next);
+      if (next == NULL)
+        return n_children - 1 - i;
+    }
+}
+
+/* Updates the cache after @child has been added to @container, and
+ * returns the index of @child.
+ *
+ * Appending and prepending children are the common cases, and both
+ * can be handled without rebuilding the cache; in every other case
+ * the cache is rebuilt lazily the next time it is queried, and the
+ * index is computed by walking the siblings towards the closest end
+ * of the list of children.
+ */
+static gint
+cally_actor_child_added (CallyActor   *self,
+                         ClutterActor *container,
+                         ClutterActor *child)
+{
+  CallyActorPrivate *priv = self->priv;
+  gint age = _clutter_actor_get_children_age (container);
+
+  if (priv->children_valid && priv->children_age == age - 1)
+    {
+      if (clutter_actor_get_next_sibling (child) == NULL)
+        {
+          g_hash_table_insert (priv->children_index, child,
+                               GUINT_TO_POINTER (priv->children->len + 1));
+          g_ptr_array_add (priv->children, child);
+          priv->children_age = age;
+
+          return priv->children->len - 1 - priv->children_first;
+        }
+
+      if (clutter_actor_get_previous_sibling (child) == NULL &&
+          priv->children_first > 0)
+        {
+          priv->children_first -= 1;
+          g_ptr_array_index (priv->children, priv->children_first) = child;
+          g_hash_table_insert (priv->children_index, child,
+                               GUINT_TO_POINTER (priv->children_first + 1));
+          priv->children_age = age;
+
+          return 0;
+        }
+    }
+
+  priv->children_valid = FALSE;
+
+  return cally_actor_find_child_index (container, child);
+}
+
+/* Updates the cache after @child has been removed from @container, and
+ * returns the index @child had, or -1 if the cache was out of date.
+ */
+static gint
+cally_actor_child_removed (CallyActor   *self,
+                           ClutterActor *container,
+                           ClutterActor *child)
+{
+  CallyActorPrivate *priv = self->priv;
+  gint age = _clutter_actor_get_children_age (container);
+  guint slot;
+  gint index;
+
+  if (!priv->children_valid || priv->children_age != age - 1)
+    {
+      priv->children_valid = FALSE;
+      return -1;
+    }
+
+  slot = GPOINTER_TO_UINT (g_hash_table_lookup (priv->children_index, child));
+  if (slot == 0)
+    {
+      priv->children_valid = FALSE;
+      return -1;
+    }
+
+  slot -= 1;
+  index = slot - priv->children_first;
+
+  g_hash_table_remove (priv->children_index, child);
+
+  if (slot == priv->children->len - 1)
+    {
+      g_ptr_array_set_size (priv->children, slot);
+      priv->children_age = age;
+    }
+  else if (slot == priv->children_first &&
+           priv->children_first < priv->children->len / 2)
+    {
+      g_ptr_array_index (priv->children, slot) = NULL;
+      priv->children_first += 1;
+      priv->children_age = age;
+    }
+  else
+    cally_actor_update_children (self, container);
+
+  return index;
+}
+
 /* ClutterContainer */
 static gint
 cally_actor_add_actor (ClutterActor *container,
@@ -572,7 +773,6 @@ cally_actor_real_add_actor (ClutterActor *container,
   AtkObject        *atk_parent = ATK_OBJECT (data);
   AtkObject        *atk_child  = clutter_actor_get_accessible (actor);
   CallyActor        *cally_actor = CALLY_ACTOR (atk_parent);
-  CallyActorPrivate *priv       = cally_actor->priv;
   gint              index;
 
   g_return_val_if_fail (CLUTTER_IS_CONTAINER (container), 0);
@@ -580,11 +780,7 @@ cally_actor_real_add_actor (ClutterActor *container,
 
   g_object_notify (G_OBJECT (atk_child), "accessible_parent");
 
-  g_list_free (priv->children);
-
-  priv->children = clutter_actor_get_children (CLUTTER_ACTOR (container));
-
-  index = g_list_index (priv->children, actor);
+  index = cally_actor_child_added (cally_actor, container, actor);
   g_signal_emit_by_name (atk_parent, "children_changed::add",
                          index, atk_child, NULL);
 
@@ -599,7 +795,6 @@ cally_actor_real_remove_actor (ClutterActor *container,
   AtkPropertyValues  values      = { NULL };
   AtkObject*         atk_parent  = NULL;
   AtkObject         *atk_child   = NULL;
-  CallyActorPrivate  *priv        = NULL;
   gint               index;
 
   g_return_val_if_fail (CLUTTER_IS_CONTAINER (container), 0);
@@ -621,15 +816,11 @@ cally_actor_real_remove_actor (ClutterActor *container,
       g_object_unref (atk_child);
     }
 
-  priv = CALLY_ACTOR (atk_parent)->priv;
-  index = g_list_index (priv->children, actor);
-  g_list_free (priv->children);
-
-  priv->children = clutter_actor_get_children (CLUTTER_ACTOR (container));
-
-  if (index >= 0 && index <= g_list_length (priv->children))
-    g_signal_emit_by_name (atk_parent, "children_changed::remove",
-                           index, atk_child, NULL);
+  index = cally_actor_child_removed (CALLY_ACTOR (atk_parent),
+                                     container,
+                                     actor);
+  g_signal_emit_by_name (atk_parent, "children_changed::remove",
+                         index, atk_child, NULL);
 
   return 1;
 }
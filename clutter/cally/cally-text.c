@@ -132,7 +132,8 @@ static void                 _cally_text_delete_text_cb           (ClutterText *c
                                                                   gint         start_pos,
                                                                   gint         end_pos,
                                                                   gpointer     data);
-static gboolean             _idle_notify_insert                  (gpointer data);
+static void                 _queue_notify                        (CallyText *cally_text);
+static gboolean             _flush_notify                        (gpointer data);
 static void                 _notify_insert                       (CallyText *cally_text);
 static void                 _notify_delete                       (CallyText *cally_text);
 
@@ -184,17 +185,26 @@ struct _CallyTextPrivate
   const gchar *signal_name_insert;
   gint position_insert;
   gint length_insert;
-  guint insert_idle_handler;
 
   /* text_changed::delete stuff */
   const gchar *signal_name_delete;
   gint position_delete;
   gint length_delete;
 
+  /* Insertions and caret moves are coalesced and emitted once per
+   * frame; deletions are emitted immediately, after the pending
+   * insertion, so that their order is preserved
+   */
+  guint notify_id;
+  guint caret_moved : 1;
+  guint selection_changed : 1;
+
   /* action */
   guint activate_action_id;
 };
 
+static GQuark quark_text_offsets = 0;
+
 G_DEFINE_TYPE_WITH_CODE (CallyText,
                          cally_text,
                          CALLY_TYPE_ACTOR,
@@ -217,6 +227,8 @@ cally_text_class_init (CallyTextClass *klass)
   class->ref_state_set = cally_text_ref_state_set;
 
   cally_class->notify_clutter = cally_text_notify_clutter;
+
+  quark_text_offsets = g_quark_from_static_string ("-cally-text-offsets");
 }
 
 static void
@@ -232,12 +244,15 @@ cally_text_init (CallyText *cally_text)
   priv->signal_name_insert = NULL;
   priv->position_insert = -1;
   priv->length_insert = -1;
-  priv->insert_idle_handler = 0;
 
   priv->signal_name_delete = NULL;
   priv->position_delete = -1;
   priv->length_delete = -1;
 
+  priv->notify_id = 0;
+  priv->caret_moved = FALSE;
+  priv->selection_changed = FALSE;
+
   priv->activate_action_id = 0;
 }
 
@@ -249,10 +264,10 @@ cally_text_finalize   (GObject *obj)
 /*   g_object_unref (cally_text->priv->textutil); */
 /*   cally_text->priv->textutil = NULL; */
 
-  if (cally_text->priv->insert_idle_handler)
+  if (cally_text->priv->notify_id)
     {
-      g_source_remove (cally_text->priv->insert_idle_handler);
-      cally_text->priv->insert_idle_handler = 0;
+      clutter_threads_remove_repaint_func (cally_text->priv->notify_id);
+      cally_text->priv->notify_id = 0;
     }
 
   G_OBJECT_CLASS (cally_text_parent_class)->finalize (obj);
@@ -543,6 +558,146 @@ _gtk_pango_is_inside_sentence (PangoLayout  *layout,
   return FALSE;
 }
 
+/* Offsets */
+
+/* The distance, in characters, between two entries of the table of byte
+ * indices kept for the text of a layout
+ */
+#define OFFSETS_STRIDE  64
+
+typedef struct _CallyTextOffsets        CallyTextOffsets;
+
+/*< private >
+ * CallyTextOffsets:
+ * @text: the text of the layout
+ * @n_chars: the number of characters in @text
+ * @n_indices: the number of entries in @indices
+ * @indices: the byte index of every %OFFSETS_STRIDE-th character
+ *
+ * Maps character offsets to byte indices, and back, in O(1) for the
+ * text of a #PangoLayout, instead of walking the UTF-8 text from its
+ * start for every AtkText query. The table is attached to the layout,
+ * and goes away with it when the text changes.
+ */
+struct _CallyTextOffsets
+{
+  const gchar *text;
+  gint n_chars;
+
+  gint n_indices;
+  gint *indices;
+};
+
+static void
+_cally_text_offsets_free (gpointer data)
+{
+  CallyTextOffsets *offsets = data;
+
+  g_free (offsets->indices);
+  g_slice_free (CallyTextOffsets, offsets);
+}
+
+static CallyTextOffsets *
+_cally_text_get_offsets (PangoLayout *layout)
+{
+  CallyTextOffsets *offsets;
+  const gchar *text, *p;
+  gint n_chars, i;
+
+  text = pango_layout_get_text (layout);
+  n_chars = pango_layout_get_character_count (layout);
+
+  offsets = g_object_get_qdata (G_OBJECT (layout), quark_text_offsets);
+  if (offsets != NULL &&
+      offsets->text == text &&
+      offsets->n_chars == n_chars)
+    return offsets;
+
+  offsets = g_slice_new (CallyTextOffsets);
+  offsets->text = text;
+  offsets->n_chars = n_chars;
+  offsets->n_indices = n_chars / OFFSETS_STRIDE + 1;
+  offsets->indices = g_new (gint, offsets->n_indices);
+
+  for (i = 0, p = text; i <= n_chars; i++)
+    {
+      if (i % OFFSETS_STRIDE == 0)
+        offsets->indices[i / OFFSETS_STRIDE] = p - text;
+
+      if (i < n_chars)
+        p = g_utf8_next_char (p);
+    }
+
+  g_object_set_qdata_full (G_OBJECT (layout), quark_text_offsets,
+                           offsets,
+                           _cally_text_offsets_free);
+
+  return offsets;
+}
+
+static const gchar *
+_cally_text_offset_to_pointer (CallyTextOffsets *offsets,
+                               gint              offset)
+{
+  const gchar *p;
+  gint i;
+
+  offset = CLAMP (offset, 0, offsets->n_chars);
+
+  p = offsets->text + offsets->indices[offset / OFFSETS_STRIDE];
+  for (i = offset % OFFSETS_STRIDE; i > 0; i--)
+    p = g_utf8_next_char (p);
+
+  return p;
+}
+
+static gint
+_cally_text_index_to_offset (CallyTextOffsets *offsets,
+                             gint              index_)
+{
+  const gchar *p, *end;
+  gint lo, hi, offset;
+
+  /* find the last entry of the table before index_ */
+  lo = 0;
+  hi = offsets->n_indices - 1;
+  while (lo < hi)
+    {
+      gint mid = (lo + hi + 1) / 2;
+
+      if (offsets->indices[mid] <= index_)
+        lo = mid;
+      else
+        hi = mid - 1;
+    }
+
+  offset = lo * OFFSETS_STRIDE;
+  p = offsets->text + offsets->indices[lo];
+  end = offsets->text + index_;
+  while (p < end && offset < offsets->n_chars)
+    {
+      p = g_utf8_next_char (p);
+      offset += 1;
+    }
+
+  return offset;
+}
+
+static gchar *
+_cally_text_offsets_substring (CallyTextOffsets *offsets,
+                               gint              start_offset,
+                               gint              end_offset)
+{
+  const gchar *start, *end;
+
+  start = _cally_text_offset_to_pointer (offsets, start_offset);
+  end = _cally_text_offset_to_pointer (offsets, end_offset);
+  if (end < start)
+    end = start;
+
+  return g_strndup (start, end - start);
+}
+
 static void
 pango_layout_get_line_before (PangoLayout     *layout,
                               AtkTextBoundary  boundary_type,
@@ -553,11 +708,13 @@ pango_layout_get_line_before (PangoLayout     *layout,
   PangoLayoutIter *iter;
   PangoLayoutLine *line, *prev_line = NULL, *prev_prev_line = NULL;
   gint index, start_index, end_index;
+  CallyTextOffsets *offsets;
   const gchar *text;
   gboolean found = FALSE;
 
   text = pango_layout_get_text (layout);
-  index = g_utf8_offset_to_pointer (text, offset) - text;
+  offsets = _cally_text_get_offsets (layout);
+  index = _cally_text_offset_to_pointer (offsets, offset) - text;
   iter = pango_layout_get_iter (layout);
   do
     {
@@ -606,8 +763,8 @@ pango_layout_get_line_before (PangoLayout     *layout,
     }
   pango_layout_iter_free (iter);
 
-  *start_offset = g_utf8_pointer_to_offset (text, text + start_index);
-  *end_offset = g_utf8_pointer_to_offset (text, text + end_index);
+  *start_offset = _cally_text_index_to_offset (offsets, start_index);
+  *end_offset = _cally_text_index_to_offset (offsets, end_index);
 }
 
 static void
@@ -620,11 +777,13 @@ pango_layout_get_line_at (PangoLayout     *layout,
   PangoLayoutIter *iter;
   PangoLayoutLine *line, *prev_line = NULL;
   gint index, start_index, end_index;
+  CallyTextOffsets *offsets;
   const gchar *text;
   gboolean found = FALSE;
 
   text = pango_layout_get_text (layout);
-  index = g_utf8_offset_to_pointer (text, offset) - text;
+  offsets = _cally_text_get_offsets (layout);
+  index = _cally_text_offset_to_pointer (offsets, offset) - text;
   iter = pango_layout_get_iter (layout);
   do
     {
@@ -664,8 +823,8 @@ pango_layout_get_line_at (PangoLayout     *layout,
     }
   pango_layout_iter_free (iter);
 
-  *start_offset = g_utf8_pointer_to_offset (text, text + start_index);
-  *end_offset = g_utf8_pointer_to_offset (text, text + end_index);
+  *start_offset = _cally_text_index_to_offset (offsets, start_index);
+  *end_offset = _cally_text_index_to_offset (offsets, end_index);
 }
 
 static void
@@ -678,11 +837,13 @@ pango_layout_get_line_after (PangoLayout     *layout,
   PangoLayoutIter *iter;
   PangoLayoutLine *line, *prev_line = NULL;
   gint index, start_index, end_index;
+  CallyTextOffsets *offsets;
   const gchar *text;
   gboolean found = FALSE;
 
   text = pango_layout_get_text (layout);
-  index = g_utf8_offset_to_pointer (text, offset) - text;
+  offsets = _cally_text_get_offsets (layout);
+  index = _cally_text_offset_to_pointer (offsets, offset) - text;
   iter = pango_layout_get_iter (layout);
   do
     {
@@ -731,8 +892,8 @@ pango_layout_get_line_after (PangoLayout     *layout,
     }
   pango_layout_iter_free (iter);
 
-  *start_offset = g_utf8_pointer_to_offset (text, text + start_index);
-  *end_offset = g_utf8_pointer_to_offset (text, text + end_index);
+  *start_offset = _cally_text_index_to_offset (offsets, start_index);
+  *end_offset = _cally_text_index_to_offset (offsets, end_index);
 }
 
 /*
@@ -831,7 +992,8 @@ _gtk_pango_get_text_at (PangoLayout     *layout,
 
   g_assert (start <= end);
 
-  return g_utf8_substring (text, start, end);
+  return _cally_text_offsets_substring (_cally_text_get_offsets (layout),
+                                        start, end);
 }
 
 /*
@@ -932,7 +1094,8 @@ _gtk_pango_get_text_before (PangoLayout     *layout,
 
   g_assert (start <= end);
 
-  return g_utf8_substring (text, start, end);
+  return _cally_text_offsets_substring (_cally_text_get_offsets (layout),
+                                        start, end);
 }
 
 /*
@@ -1039,7 +1202,8 @@ _gtk_pango_get_text_after (PangoLayout     *layout,
 
   g_assert (start <= end);
 
-  return g_utf8_substring (text, start, end);
+  return _cally_text_offsets_substring (_cally_text_get_offsets (layout),
+                                        start, end);
 }
 
 /***** atktext.h ******/
@@ -1096,7 +1260,8 @@ cally_text_get_text (AtkText *text,
   if (string[0] == 0)
     return g_strdup("");
   else
-    return g_utf8_substring (string, start_offset, end_offset);
+    return _cally_text_offsets_substring (_cally_text_get_offsets (layout),
+                                          start_offset, end_offset);
 }
 
 static gunichar
@@ -1104,8 +1269,7 @@ cally_text_get_character_at_offset (AtkText *text,
                                     gint     offset)
 {
   ClutterActor *actor      = NULL;
-  const gchar  *string     = NULL;
-  gchar        *index      = NULL;
+  CallyTextOffsets *offsets = NULL;
   gunichar      unichar;
   PangoLayout  *layout = NULL;
 
@@ -1117,17 +1281,16 @@ cally_text_get_character_at_offset (AtkText *text,
      it take into account password-char */
 
   layout = clutter_text_get_layout (CLUTTER_TEXT (actor));
-  string = pango_layout_get_text (layout);
+  offsets = _cally_text_get_offsets (layout);
 
-  if (offset >= g_utf8_strlen (string, -1))
+  if (offset < 0 || offset >= offsets->n_chars)
     {
       unichar = '\0';
     }
   else
     {
-      index = g_utf8_offset_to_pointer (string, offset);
-
-      unichar = g_utf8_get_char (index);
+      unichar = g_utf8_get_char (_cally_text_offset_to_pointer (offsets,
+                                                                offset));
     }
 
   return unichar;
@@ -1227,7 +1390,7 @@ cally_text_get_character_count (AtkText *text)
     return 0;
 
   clutter_text = CLUTTER_TEXT (actor);
-  return g_utf8_strlen (clutter_text_get_text (clutter_text), -1);
+  return clutter_text_buffer_get_length (clutter_text_get_buffer (clutter_text));
 }
 
 static gint
@@ -1555,6 +1718,8 @@ _cally_text_delete_text_cb (ClutterText *clutter_text,
                             gpointer     data)
 {
   CallyText *cally_text = NULL;
+  CallyTextPrivate *priv = NULL;
+  gint length;
 
   g_return_if_fail (CALLY_IS_TEXT (data));
 
@@ -1563,14 +1728,35 @@ _cally_text_delete_text_cb (ClutterText *clutter_text,
     return;
 
   cally_text = CALLY_TEXT (data);
+  priv = cally_text->priv;
+  length = end_pos - start_pos;
 
-  if (!cally_text->priv->signal_name_delete)
+  if (priv->signal_name_insert != NULL &&
+      start_pos >= priv->position_insert &&
+      end_pos <= priv->position_insert + priv->length_insert)
     {
-      cally_text->priv->signal_name_delete = "text_changed::delete";
-      cally_text->priv->position_delete = start_pos;
-      cally_text->priv->length_delete = end_pos - start_pos;
+      /* the deleted text was inserted in the same frame and it has
+       * not been announced yet, so the two changes cancel each other
+       * out
+       */
+      priv->length_insert -= length;
+      if (priv->length_insert == 0)
+        priv->signal_name_insert = NULL;
+
+      return;
     }
 
+  /* ClutterText emits ::delete-text before changing the buffer, so
+   * that the deleted text can still be retrieved (BG#722220); the
+   * pending insertion is still valid at this point, so it must be
+   * announced first, and the deletion cannot be deferred
+   */
+  _notify_insert (cally_text);
+
+  priv->signal_name_delete = "text_changed::delete";
+  priv->position_delete = start_pos;
+  priv->length_delete = length;
+
   _notify_delete (cally_text);
 }
 
@@ -1582,25 +1768,39 @@ _cally_text_insert_text_cb (ClutterText *clutter_text,
                             gpointer     data)
 {
   CallyText *cally_text = NULL;
+  CallyTextPrivate *priv = NULL;
+  gint length;
 
   g_return_if_fail (CALLY_IS_TEXT (data));
 
   cally_text = CALLY_TEXT (data);
+  priv = cally_text->priv;
+  length = g_utf8_strlen (new_text, new_text_length);
+
+  if (length == 0)
+    return;
 
-  if (!cally_text->priv->signal_name_insert)
+  if (priv->signal_name_insert != NULL &&
+      *position >= priv->position_insert &&
+      *position <= priv->position_insert + priv->length_insert)
+    {
+      /* typing, or pasting, inside the pending insertion */
+      priv->length_insert += length;
+    }
+  else
     {
-      cally_text->priv->signal_name_insert = "text_changed::insert";
-      cally_text->priv->position_insert = *position;
-      cally_text->priv->length_insert = g_utf8_strlen (new_text, new_text_length);
+      _notify_insert (cally_text);
+
+      priv->signal_name_insert = "text_changed::insert";
+      priv->position_insert = *position;
+      priv->length_insert = length;
     }
 
   /*
-   * The signal will be emitted when the cursor position is updated,
-   * or in an idle handler if it not updated.
+   * The signal will be emitted at the end of the next frame, together
+   * with any other change happening before then.
    */
-  if (cally_text->priv->insert_idle_handler == 0)
-    cally_text->priv->insert_idle_handler = clutter_threads_add_idle (_idle_notify_insert,
-                                                                      cally_text);
+  _queue_notify (cally_text);
 }
 
 /***** atkeditabletext.h ******/
@@ -1699,15 +1899,18 @@ cally_text_notify_clutter (GObject    *obj,
     {
       /* the selection can change also for the cursor position */
       if (_check_for_selection_change (cally_text, clutter_text))
-        g_signal_emit_by_name (atk_obj, "text_selection_changed");
+        cally_text->priv->selection_changed = TRUE;
 
-      g_signal_emit_by_name (atk_obj, "text_caret_moved",
-                             clutter_text_get_cursor_position (clutter_text));
+      cally_text->priv->caret_moved = TRUE;
+      _queue_notify (cally_text);
     }
   else if (g_strcmp0 (pspec->name, "selection-bound") == 0)
     {
       if (_check_for_selection_change (cally_text, clutter_text))
-        g_signal_emit_by_name (atk_obj, "text_selection_changed");
+        {
+          cally_text->priv->selection_changed = TRUE;
+          _queue_notify (cally_text);
+        }
     }
   else if (g_strcmp0 (pspec->name, "editable") == 0)
     {
@@ -1767,16 +1970,53 @@ _check_for_selection_change (CallyText *cally_text,
   return ret_val;
 }
 
+static void
+_queue_notify (CallyText *cally_text)
+{
+  if (cally_text->priv->notify_id != 0)
+    return;
+
+  /* Flushing the pending events after painting a frame rate-limits them
+   * to the frame rate, instead of emitting them for every keystroke or
+   * every change to the buffer; the text is also going to be redrawn,
+   * so we queue a new frame in case none is scheduled
+   */
+  cally_text->priv->notify_id =
+    clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_POST_PAINT |
+                                           CLUTTER_REPAINT_FLAGS_QUEUE_REDRAW_ON_ADD,
+                                           _flush_notify,
+                                           cally_text,
+                                           NULL);
+}
+
 static gboolean
-_idle_notify_insert (gpointer data)
+_flush_notify (gpointer data)
 {
   CallyText *cally_text = NULL;
+  CallyTextPrivate *priv = NULL;
+  ClutterActor *actor = NULL;
 
   cally_text = CALLY_TEXT (data);
-  cally_text->priv->insert_idle_handler = 0;
+  priv = cally_text->priv;
+  priv->notify_id = 0;
 
   _notify_insert (cally_text);
 
+  if (priv->selection_changed)
+    {
+      g_signal_emit_by_name (cally_text, "text_selection_changed");
+      priv->selection_changed = FALSE;
+    }
+
+  actor = CALLY_GET_CLUTTER_ACTOR (cally_text);
+  if (priv->caret_moved && actor != NULL)
+    {
+      g_signal_emit_by_name (cally_text, "text_caret_moved",
+                             clutter_text_get_cursor_position (CLUTTER_TEXT (actor)));
+    }
+
+  priv->caret_moved = FALSE;
+
   return FALSE;
 }
 
@@ -2059,7 +2299,7 @@ _cally_misc_layout_get_run_attributes (AtkAttributeSet *attrib_set,
   PangoLayout *layout = clutter_text_get_layout (clutter_text);
   gchar *text = (gchar*) clutter_text_get_text (clutter_text);
 
-  len = g_utf8_strlen (text, -1);
+  len = clutter_text_buffer_get_length (clutter_text_get_buffer (clutter_text));
   /* Grab the attributes of the PangoLayout, if any */
   if ((attr = pango_layout_get_attributes (layout)) == NULL)
     {
@@ -298,6 +298,12 @@ const gchar *                   _clutter_actor_get_debug_name
 void                            _clutter_actor_push_clone_paint                         (void);
 void                            _clutter_actor_pop_clone_paint                          (void);
 
+void                            _clutter_actor_push_deferred_notify                     (void);
+void                            _clutter_actor_pop_deferred_notify                      (void);
+
+void                            _clutter_actor_invalidate_geometry_snapshots            (void);
+const CoglMatrix *              _clutter_actor_get_geometry_transform                   (ClutterActor *self);
+
 guint32                         _clutter_actor_get_pick_id                              (ClutterActor *self);
 
 void                            _clutter_actor_shader_pre_paint                         (ClutterActor *actor,
@@ -319,6 +325,8 @@ void                            _clutter_actor_queue_only_relayout
 
 CoglFramebuffer *               _clutter_actor_get_active_framebuffer                   (ClutterActor *actor);
 
+gint                            _clutter_actor_get_children_age                         (ClutterActor *self);
+
 ClutterPaintNode *              clutter_actor_create_texture_paint_node                 (ClutterActor *self,
                                                                                          CoglTexture  *texture);
 
@@ -635,10 +635,12 @@
 #include "clutter-interval.h"
 #include "clutter-main.h"
 #include "clutter-marshal.h"
+#include "clutter-master-clock.h"
 #include "clutter-paint-nodes.h"
 #include "clutter-paint-node-private.h"
 #include "clutter-paint-volume-private.h"
 #include "clutter-private.h"
+#include "clutter-profiler-private.h"
 #include "clutter-property-transition.h"
 #include "clutter-scriptable.h"
 #include "clutter-script-private.h"
@@ -672,40 +674,55 @@ typedef enum {
  * will ask for 3 different preferred size in each allocation cycle */
 #define N_CACHED_SIZE_REQUESTS 3
 
-struct _ClutterActorPrivate
-{
-  /* request mode */
-  ClutterRequestMode request_mode;
+/* The state below is only needed by some actors, so it is allocated
+ * on demand instead of being part of ClutterActorPrivate; this keeps
+ * the state used when traversing the scene graph close together
+ */
+typedef struct _ClutterContentInfo      ClutterContentInfo;
+typedef struct _ClutterChildModelInfo   ClutterChildModelInfo;
+typedef struct _ClutterGeometrySnapshot ClutterGeometrySnapshot;
 
-  /* our cached size requests for different width / height */
-  SizeRequest width_requests[N_CACHED_SIZE_REQUESTS];
-  SizeRequest height_requests[N_CACHED_SIZE_REQUESTS];
+struct _ClutterContentInfo
+{
+  ClutterActorBox content_box;
+  ClutterContentGravity content_gravity;
+  ClutterScalingFilter min_filter;
+  ClutterScalingFilter mag_filter;
+  ClutterContentRepeat content_repeat;
+};
 
-  /* An age of 0 means the entry is not set */
-  guint cached_height_age;
-  guint cached_width_age;
+struct _ClutterChildModelInfo
+{
+  GListModel *child_model;
+  ClutterActorCreateChildFunc create_child_func;
+  gpointer create_child_data;
+  GDestroyNotify create_child_notify;
 
-  /* the bounding box of the actor, relative to the parent's
-   * allocation
+  /* the children for the items in [0, n_created) have been created;
+   * the remaining ones are created in batches by a repaint function
    */
-  ClutterActorBox allocation;
-  ClutterAllocationFlags allocation_flags;
-
-  /* clip, in actor coordinates */
-  ClutterRect clip;
+  guint n_created;
+  guint create_id;
+};
 
-  /* the cached transformation matrix; see apply_transform() */
-  CoglMatrix transform;
+struct _ClutterGeometrySnapshot
+{
+  /* the value of geometry_serial when the snapshot was taken */
+  guint serial;
 
-  guint8 opacity;
-  gint opacity_override;
+  guint transform_valid : 1;
+  guint paint_box_valid : 1;
+  guint has_paint_box   : 1;
 
-  ClutterOffscreenRedirect offscreen_redirect;
+  /* from actor coordinates to eye coordinates */
+  CoglMatrix transform;
 
-  /* This is an internal effect used to implement the
-     offscreen-redirect property */
-  ClutterEffect *flatten_effect;
+  /* the paint volume, in stage coordinates */
+  ClutterActorBox paint_box;
+};
 
+struct _ClutterActorPrivate
+{
   /* scene graph */
   ClutterActor *parent;
   ClutterActor *prev_sibling;
@@ -723,39 +740,35 @@ struct _ClutterActorPrivate
    */
   gint age;
 
-  gchar *name; /* a non-unique name, used for debugging */
+  /* the bounding box of the actor, relative to the parent's
+   * allocation
+   */
+  ClutterActorBox allocation;
+  ClutterAllocationFlags allocation_flags;
+
+  guint8 opacity;
+  gint opacity_override;
 
   gint32 pick_id; /* per-stage unique id, used for picking */
 
-  /* a back-pointer to the Pango context that we can use
-   * to create pre-configured PangoLayout
-   */
-  PangoContext *pango_context;
+  /* request mode */
+  ClutterRequestMode request_mode;
 
   /* the text direction configured for this child - either by
    * application code, or by the actor's parent
    */
   ClutterTextDirection text_direction;
 
-  /* a counter used to toggle the CLUTTER_INTERNAL_CHILD flag */
-  gint internal_child;
-
-  /* meta classes */
-  ClutterMetaGroup *actions;
-  ClutterMetaGroup *constraints;
-  ClutterMetaGroup *effects;
-
   /* delegate object used to allocate the children of this actor */
   ClutterLayoutManager *layout_manager;
 
   /* delegate object used to paint the contents of this actor */
   ClutterContent *content;
 
-  ClutterActorBox content_box;
-  ClutterContentGravity content_gravity;
-  ClutterScalingFilter min_filter;
-  ClutterScalingFilter mag_filter;
-  ClutterContentRepeat content_repeat;
+  /* meta classes */
+  ClutterMetaGroup *actions;
+  ClutterMetaGroup *constraints;
+  ClutterMetaGroup *effects;
 
   /* used when painting, to update the paint volume */
   ClutterEffect *current_effect;
@@ -774,6 +787,29 @@ struct _ClutterActorPrivate
      the list of effects that is next in the chain */
   const GList *next_effect_to_paint;
 
+  ClutterStageQueueRedrawEntry *queue_redraw_entry;
+
+  /* whether the actor is inside a cloned branch; this
+   * value is propagated to all the actor's children
+   */
+  gulong in_cloned_branch;
+
+  ClutterColor bg_color;
+
+  /* the cached transformation matrix; see apply_transform() */
+  CoglMatrix transform;
+
+  /* clip, in actor coordinates */
+  ClutterRect clip;
+
+  /* our cached size requests for different width / height */
+  SizeRequest width_requests[N_CACHED_SIZE_REQUESTS];
+  SizeRequest height_requests[N_CACHED_SIZE_REQUESTS];
+
+  /* An age of 0 means the entry is not set */
+  guint cached_height_age;
+  guint cached_width_age;
+
   ClutterPaintVolume paint_volume;
 
   /* NB: This volume isn't relative to this actor, it is in eye
@@ -781,9 +817,26 @@ struct _ClutterActorPrivate
    */
   ClutterPaintVolume last_paint_volume;
 
-  ClutterStageQueueRedrawEntry *queue_redraw_entry;
+  /* state allocated on demand; see above */
+  ClutterContentInfo *content_info;
+  ClutterChildModelInfo *model_info;
+  ClutterGeometrySnapshot *geometry;
 
-  ClutterColor bg_color;
+  ClutterOffscreenRedirect offscreen_redirect;
+
+  /* This is an internal effect used to implement the
+     offscreen-redirect property */
+  ClutterEffect *flatten_effect;
+
+  gchar *name; /* a non-unique name, used for debugging */
+
+  /* a back-pointer to the Pango context that we can use
+   * to create pre-configured PangoLayout
+   */
+  PangoContext *pango_context;
+
+  /* a counter used to toggle the CLUTTER_INTERNAL_CHILD flag */
+  gint internal_child;
 
 #ifdef CLUTTER_ENABLE_DEBUG
   /* a string used for debugging messages */
@@ -793,16 +846,6 @@ struct _ClutterActorPrivate
   /* a set of clones of the actor */
   GHashTable *clones;
 
-  /* whether the actor is inside a cloned branch; this
-   * value is propagated to all the actor's children
-   */
-  gulong in_cloned_branch;
-
-  GListModel *child_model;
-  ClutterActorCreateChildFunc create_child_func;
-  gpointer create_child_data;
-  GDestroyNotify create_child_notify;
-
   /* bitfields: KEEP AT THE END */
 
   /* fixed position and sizes */
@@ -840,6 +883,12 @@ struct _ClutterActorPrivate
   guint needs_compute_expand        : 1;
   guint needs_x_expand              : 1;
   guint needs_y_expand              : 1;
+  /* the notifications are frozen until the end of a deferred
+   * notification section
+   */
+  guint notify_deferred             : 1;
+  /* queued for clutter_actor_destroy_deferred() */
+  guint destroy_deferred            : 1;
 };
 
 enum
@@ -1080,6 +1129,10 @@ static void on_layout_manager_changed (ClutterLayoutManager *manager,
 
 static inline void clutter_actor_queue_compute_expand (ClutterActor *self);
 
+static void clutter_actor_unbind_child_model (ClutterActor *self);
+
+static void clutter_actor_queue_destroy_deferred (ClutterActor *self);
+
 static inline void clutter_actor_set_margin_internal (ClutterActor *self,
                                                       gfloat        margin,
                                                       GParamSpec   *pspec);
@@ -1105,6 +1158,7 @@ static GQuark quark_shader_data = 0;
 static GQuark quark_actor_layout_info = 0;
 static GQuark quark_actor_transform_info = 0;
 static GQuark quark_actor_animation_info = 0;
+static GQuark quark_bind_child = 0;
 
 G_DEFINE_TYPE_WITH_CODE (ClutterActor,
                          clutter_actor,
@@ -1119,6 +1173,250 @@ G_DEFINE_TYPE_WITH_CODE (ClutterActor,
                          G_IMPLEMENT_INTERFACE (ATK_TYPE_IMPLEMENTOR,
                                                 atk_implementor_iface_init));
 
+static const ClutterContentInfo default_content_info = {
+  { 0.f, 0.f, 0.f, 0.f },                       /* content-box */
+  CLUTTER_CONTENT_GRAVITY_RESIZE_FILL,          /* content-gravity */
+  CLUTTER_SCALING_FILTER_LINEAR,                /* minification-filter */
+  CLUTTER_SCALING_FILTER_LINEAR,                /* magnification-filter */
+  CLUTTER_REPEAT_NONE,                          /* content-repeat */
+};
+
+/* Retrieves the content state of @self, creating it if needed; this
+ * should only be used by setters
+ */
+static ClutterContentInfo *
+clutter_actor_get_content_info (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (priv->content_info == NULL)
+    {
+      priv->content_info = g_slice_new (ClutterContentInfo);
+      *priv->content_info = default_content_info;
+    }
+
+  return priv->content_info;
+}
+
+static inline const ClutterContentInfo *
+clutter_actor_get_content_info_or_defaults (ClutterActor *self)
+{
+  if (self->priv->content_info != NULL)
+    return self->priv->content_info;
+
+  return &default_content_info;
+}
+
+/* The geometry snapshots of all actors are valid as long as their serial
+ * matches this one; it is bumped by anything that may change the
+ * transformation or the paint volume of any actor, including the view
+ * and the projection of the stage, as well as once per frame by the
+ * stage after the relayout
+ */
+static guint geometry_serial = 1;
+
+static inline void
+clutter_actor_invalidate_transform (ClutterActor *self)
+{
+  self->priv->transform_valid = FALSE;
+  geometry_serial += 1;
+}
+
+/*< private >
+ * _clutter_actor_invalidate_geometry_snapshots:
+ *
+ * Invalidates the geometry snapshots of all actors.
+ */
+void
+_clutter_actor_invalidate_geometry_snapshots (void)
+{
+  geometry_serial += 1;
+}
+
+static ClutterGeometrySnapshot *
+clutter_actor_get_geometry_snapshot (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterGeometrySnapshot *geometry = priv->geometry;
+
+  if (G_UNLIKELY (geometry == NULL))
+    {
+      geometry = g_slice_new0 (ClutterGeometrySnapshot);
+      priv->geometry = geometry;
+    }
+
+  if (geometry->serial != geometry_serial)
+    {
+      geometry->serial = geometry_serial;
+      geometry->transform_valid = FALSE;
+      geometry->paint_box_valid = FALSE;
+    }
+
+  return geometry;
+}
+
+/*< private >
+ * _clutter_actor_get_geometry_transform:
+ * @self: a #ClutterActor
+ *
+ * Retrieves the transformation from the coordinate space of @self into
+ * eye coordinates, like _clutter_actor_get_relative_transformation_matrix()
+ * with a %NULL ancestor.
+ *
+ * The transformation is computed from the one of the parent of @self, and
+ * it is cached until the geometry of any actor changes.
+ *
+ * Return value: (transfer none): the transformation matrix
+ */
+const CoglMatrix *
+_clutter_actor_get_geometry_transform (ClutterActor *self)
+{
+  ClutterGeometrySnapshot *geometry = clutter_actor_get_geometry_snapshot (self);
+
+  if (!geometry->transform_valid)
+    {
+      ClutterActor *parent = self->priv->parent;
+
+      if (parent != NULL)
+        geometry->transform = *_clutter_actor_get_geometry_transform (parent);
+      else
+        cogl_matrix_init_identity (&geometry->transform);
+
+      _clutter_actor_apply_modelview_transform (self, &geometry->transform);
+
+      geometry->transform_valid = TRUE;
+    }
+
+  return &geometry->transform;
+}
+
+/* The ::notify signal id, and the detail quark of each ClutterActor
+ * property, used to check whether anything is listening to a property
+ * without going through a full signal emission
+ */
+static guint notify_signal_id = 0;
+static GQuark obj_props_quarks[PROP_LAST] = { 0, };
+
+static gpointer object_dispatch_properties_changed = NULL;
+
+/* The number of nested deferred notification sections, and the actors
+ * whose notifications have been frozen inside them
+ */
+static int deferred_notify_level = 0;
+static GPtrArray *deferred_notify_actors = NULL;
+
+static inline gboolean
+clutter_actor_has_notify_handler (ClutterActor *self,
+                                  GParamSpec   *pspec)
+{
+  GObjectClass *klass = G_OBJECT_GET_CLASS (self);
+  GQuark detail;
+
+  /* a sub-class may be listening to its own notifications */
+  if (G_UNLIKELY (klass->notify != NULL ||
+                  (gpointer) klass->dispatch_properties_changed != object_dispatch_properties_changed))
+    return TRUE;
+
+  if (G_LIKELY (pspec->owner_type == CLUTTER_TYPE_ACTOR))
+    detail = obj_props_quarks[pspec->param_id];
+  else
+    detail = g_quark_from_string (pspec->name);
+
+  /* this checks both the handlers connected to ::notify and the ones
+   * connected to ::notify::<property>; blocked handlers are counted as
+   * well, as they may be unblocked before a frozen notification queue
+   * is thawed
+   */
+  return g_signal_has_handler_pending (self, notify_signal_id, detail, TRUE);
+}
+
+/*< private >
+ * clutter_actor_notify_by_pspec:
+ * @obj: a #ClutterActor, as a #GObject
+ * @pspec: the #GParamSpec of the property that changed
+ *
+ * Wraps g_object_notify_by_pspec(), skipping the emission entirely if
+ * nothing is listening to @pspec, and coalescing the notifications
+ * inside a deferred notification section.
+ */
+static inline void
+clutter_actor_notify_by_pspec (GObject    *obj,
+                               GParamSpec *pspec)
+{
+  ClutterActor *self = (ClutterActor *) obj;
+
+  if (!clutter_actor_has_notify_handler (self, pspec))
+    return;
+
+  if (deferred_notify_level > 0 && !self->priv->notify_deferred)
+    {
+      /* the notification queue coalesces repeated changes of the same
+       * property until we thaw it in _clutter_actor_pop_deferred_notify()
+       */
+      self->priv->notify_deferred = TRUE;
+      g_object_freeze_notify (obj);
+      g_ptr_array_add (deferred_notify_actors, g_object_ref (self));
+    }
+
+  g_object_notify_by_pspec (obj, pspec);
+}
+
+/*< private >
+ * _clutter_actor_push_deferred_notify:
+ *
+ * Starts a section in which the property notifications of all actors
+ * are deferred until the matching call to
+ * _clutter_actor_pop_deferred_notify(); multiple changes of the same
+ * property of an actor inside the section are emitted only once.
+ *
+ * Sections can be nested.
+ */
+void
+_clutter_actor_push_deferred_notify (void)
+{
+  if (deferred_notify_level++ > 0)
+    return;
+
+  if (deferred_notify_actors == NULL)
+    deferred_notify_actors = g_ptr_array_new ();
+}
+
+/*< private >
+ * _clutter_actor_pop_deferred_notify:
+ *
+ * Ends a section started by _clutter_actor_push_deferred_notify(), and
+ * emits the pending notifications if it was the outermost section.
+ */
+void
+_clutter_actor_pop_deferred_notify (void)
+{
+  GPtrArray *actors;
+  guint i;
+
+  g_assert (deferred_notify_level > 0);
+
+  if (--deferred_notify_level > 0)
+    return;
+
+  if (deferred_notify_actors->len == 0)
+    return;
+
+  /* the handlers may change other actors while we emit */
+  actors = deferred_notify_actors;
+  deferred_notify_actors = g_ptr_array_new ();
+
+  for (i = 0; i < actors->len; i++)
+    {
+      ClutterActor *actor = g_ptr_array_index (actors, i);
+
+      actor->priv->notify_deferred = FALSE;
+      g_object_thaw_notify (G_OBJECT (actor));
+      g_object_unref (actor);
+    }
+
+  g_ptr_array_unref (actors);
+}
+
 /*< private >
  * clutter_actor_get_debug_name:
  * @actor: a #ClutterActor
@@ -1514,7 +1812,11 @@ clutter_actor_real_map (ClutterActor *self)
   /* notify on parent mapped before potentially mapping
    * children, so apps see a top-down notification.
    */
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MAPPED]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MAPPED]);
+
+  /* make room for the pick ids of all the children at once */
+  if (priv->n_children > 1)
+    _clutter_stage_reserve_pick_ids (CLUTTER_STAGE (stage), priv->n_children);
 
   for (iter = self->priv->first_child;
        iter != NULL;
@@ -1599,12 +1901,13 @@ clutter_actor_real_unmap (ClutterActor *self)
    * showing will not result in the wrong area being repainted
    */
   _clutter_paint_volume_init_static (&priv->last_paint_volume, NULL);
+
   priv->last_paint_volume_valid = TRUE;
 
   /* notify on parent mapped after potentially unmapping
    * children, so apps see a bottom-up notification.
    */
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MAPPED]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MAPPED]);
 
   /* relinquish keyboard focus if we were unmapped while owning it */
   if (!CLUTTER_ACTOR_IS_TOPLEVEL (self))
@@ -1708,8 +2011,8 @@ set_show_on_set_parent (ClutterActor *self,
   if (priv->parent == NULL)
     {
       priv->show_on_set_parent = set_show;
-      g_object_notify_by_pspec (G_OBJECT (self),
-                                obj_props[PROP_SHOW_ON_SET_PARENT]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self),
+                                     obj_props[PROP_SHOW_ON_SET_PARENT]);
     }
 }
 
@@ -1765,7 +2068,7 @@ clutter_actor_show (ClutterActor *self)
     }
 
   g_signal_emit (self, actor_signals[SHOW], 0);
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_VISIBLE]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_VISIBLE]);
 
   if (priv->parent != NULL)
     clutter_actor_queue_redraw (priv->parent);
@@ -1891,7 +2194,7 @@ clutter_actor_hide (ClutterActor *self)
     }
 
   g_signal_emit (self, actor_signals[HIDE], 0);
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_VISIBLE]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_VISIBLE]);
 
   if (priv->parent != NULL)
     clutter_actor_queue_redraw (priv->parent);
@@ -2012,7 +2315,7 @@ clutter_actor_realize_internal (ClutterActor *self)
   CLUTTER_NOTE (ACTOR, "Realizing actor '%s'", _clutter_actor_get_debug_name (self));
 
   CLUTTER_ACTOR_SET_FLAGS (self, CLUTTER_ACTOR_REALIZED);
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_REALIZED]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_REALIZED]);
 
   g_signal_emit (self, actor_signals[REALIZE], 0);
 
@@ -2114,7 +2417,7 @@ unrealize_actor_after_children_cb (ClutterActor *self,
    * child actors are unrealized, to maintain invariants.
    */
   CLUTTER_ACTOR_UNSET_FLAGS (self, CLUTTER_ACTOR_REALIZED);
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_REALIZED]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_REALIZED]);
   return CLUTTER_ACTOR_TRAVERSE_VISIT_CONTINUE;
 }
 
@@ -2391,18 +2694,18 @@ clutter_actor_notify_if_geometry_changed (ClutterActor          *self,
    */
   if (priv->needs_allocation)
     {
-      g_object_notify_by_pspec (obj, obj_props[PROP_X]);
-      g_object_notify_by_pspec (obj, obj_props[PROP_Y]);
-      g_object_notify_by_pspec (obj, obj_props[PROP_POSITION]);
-      g_object_notify_by_pspec (obj, obj_props[PROP_WIDTH]);
-      g_object_notify_by_pspec (obj, obj_props[PROP_HEIGHT]);
-      g_object_notify_by_pspec (obj, obj_props[PROP_SIZE]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_X]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_Y]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_POSITION]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_WIDTH]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_HEIGHT]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_SIZE]);
     }
   else if (priv->needs_width_request || priv->needs_height_request)
     {
-      g_object_notify_by_pspec (obj, obj_props[PROP_WIDTH]);
-      g_object_notify_by_pspec (obj, obj_props[PROP_HEIGHT]);
-      g_object_notify_by_pspec (obj, obj_props[PROP_SIZE]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_WIDTH]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_HEIGHT]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_SIZE]);
     }
   else
     {
@@ -2416,26 +2719,26 @@ clutter_actor_notify_if_geometry_changed (ClutterActor          *self,
 
       if (x != old->x1)
         {
-          g_object_notify_by_pspec (obj, obj_props[PROP_X]);
-          g_object_notify_by_pspec (obj, obj_props[PROP_POSITION]);
+          clutter_actor_notify_by_pspec (obj, obj_props[PROP_X]);
+          clutter_actor_notify_by_pspec (obj, obj_props[PROP_POSITION]);
         }
 
       if (y != old->y1)
         {
-          g_object_notify_by_pspec (obj, obj_props[PROP_Y]);
-          g_object_notify_by_pspec (obj, obj_props[PROP_POSITION]);
+          clutter_actor_notify_by_pspec (obj, obj_props[PROP_Y]);
+          clutter_actor_notify_by_pspec (obj, obj_props[PROP_POSITION]);
         }
 
       if (width != (old->x2 - old->x1))
         {
-          g_object_notify_by_pspec (obj, obj_props[PROP_WIDTH]);
-          g_object_notify_by_pspec (obj, obj_props[PROP_SIZE]);
+          clutter_actor_notify_by_pspec (obj, obj_props[PROP_WIDTH]);
+          clutter_actor_notify_by_pspec (obj, obj_props[PROP_SIZE]);
         }
 
       if (height != (old->y2 - old->y1))
         {
-          g_object_notify_by_pspec (obj, obj_props[PROP_HEIGHT]);
-          g_object_notify_by_pspec (obj, obj_props[PROP_SIZE]);
+          clutter_actor_notify_by_pspec (obj, obj_props[PROP_HEIGHT]);
+          clutter_actor_notify_by_pspec (obj, obj_props[PROP_SIZE]);
         }
     }
 
@@ -2496,15 +2799,15 @@ clutter_actor_set_allocation_internal (ClutterActor           *self,
       CLUTTER_NOTE (LAYOUT, "Allocation for '%s' changed",
                     _clutter_actor_get_debug_name (self));
 
-      priv->transform_valid = FALSE;
+      clutter_actor_invalidate_transform (self);
 
-      g_object_notify_by_pspec (obj, obj_props[PROP_ALLOCATION]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ALLOCATION]);
 
       /* if the allocation changes, so does the content box */
       if (priv->content != NULL)
         {
           priv->content_box_valid = FALSE;
-          g_object_notify_by_pspec (obj, obj_props[PROP_CONTENT_BOX]);
+          clutter_actor_notify_by_pspec (obj, obj_props[PROP_CONTENT_BOX]);
         }
 
       retval = TRUE;
@@ -2882,8 +3185,6 @@ clutter_actor_apply_transform_to_point (ClutterActor        *self,
  * instead.
  *
  */
-/* XXX: We should consider caching the stage relative modelview along with
- * the actor itself */
 static void
 _clutter_actor_get_relative_transformation_matrix (ClutterActor *self,
                                                    ClutterActor *ancestor,
@@ -3253,6 +3554,14 @@ _clutter_actor_apply_relative_transformation_matrix (ClutterActor *self,
   if (self == ancestor)
     return;
 
+  /* the transformation to eye coordinates is cached */
+  if (ancestor == NULL)
+    {
+      cogl_matrix_multiply (matrix, matrix,
+                            _clutter_actor_get_geometry_transform (self));
+      return;
+    }
+
   parent = clutter_actor_get_parent (self);
 
   if (parent != NULL)
@@ -3645,10 +3954,13 @@ clutter_actor_paint_node (ClutterActor     *actor,
   ClutterActorPrivate *priv = actor->priv;
   ClutterActorBox box;
   ClutterColor bg_color;
+  gint64 profile_start;
 
   if (root == NULL)
     return FALSE;
 
+  profile_start = _clutter_profiler_begin ();
+
   box.x1 = 0.f;
   box.y1 = 0.f;
   box.x2 = clutter_actor_box_get_width (&priv->allocation);
@@ -3711,6 +4023,9 @@ clutter_actor_paint_node (ClutterActor     *actor,
   if (CLUTTER_ACTOR_GET_CLASS (actor)->paint_node != NULL)
     CLUTTER_ACTOR_GET_CLASS (actor)->paint_node (actor, root);
 
+  _clutter_profiler_accumulate (CLUTTER_PROFILER_PHASE_PAINT_NODES,
+                                profile_start);
+
   if (clutter_paint_node_get_n_children (root) == 0)
     return FALSE;
 
@@ -3753,6 +4068,7 @@ clutter_actor_paint (ClutterActor *self)
   gboolean clip_set = FALSE;
   gboolean shader_applied = FALSE;
   ClutterStage *stage;
+  gint64 profile_start = 0;
 
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
@@ -3784,6 +4100,9 @@ clutter_actor_paint (ClutterActor *self)
 
   stage = (ClutterStage *) _clutter_actor_get_stage_internal (self);
 
+  if (pick_mode == CLUTTER_PICK_NONE)
+    profile_start = _clutter_profiler_actor_begin ();
+
   /* mark that we are in the paint process */
   CLUTTER_SET_PRIVATE_FLAGS (self, CLUTTER_IN_PAINT);
 
@@ -3961,6 +4280,10 @@ done:
 
   /* paint sequence complete */
   CLUTTER_UNSET_PRIVATE_FLAGS (self, CLUTTER_IN_PAINT);
+
+  _clutter_profiler_actor_end (self, CLUTTER_PROFILER_COST_PAINT,
+                               FALSE,
+                               profile_start);
 }
 
 /**
@@ -3999,6 +4322,7 @@ clutter_actor_continue_paint (ClutterActor *self)
       if (_clutter_context_get_pick_mode () == CLUTTER_PICK_NONE)
         {
           ClutterPaintNode *dummy;
+          gint64 profile_start = _clutter_profiler_begin ();
 
           /* XXX - this will go away in 2.0, when we can get rid of this
            * stuff and switch to a pure retained render tree of PaintNodes
@@ -4016,6 +4340,8 @@ clutter_actor_continue_paint (ClutterActor *self)
 
           /* XXX:2.0 - Call the paint() virtual directly */
           g_signal_emit (self, actor_signals[PAINT], 0);
+
+          _clutter_profiler_end_actor (self, profile_start);
         }
       else
         {
@@ -4258,6 +4584,9 @@ clutter_actor_remove_child_internal (ClutterActor                 *self,
 
   remove_child (self, child);
 
+  /* the child is not transformed by its old parent any more */
+  clutter_actor_invalidate_transform (child);
+
   self->priv->n_children -= 1;
 
   self->priv->age += 1;
@@ -4292,10 +4621,10 @@ clutter_actor_remove_child_internal (ClutterActor                 *self,
   if (notify_first_last)
     {
       if (old_first != self->priv->first_child)
-        g_object_notify_by_pspec (obj, obj_props[PROP_FIRST_CHILD]);
+        clutter_actor_notify_by_pspec (obj, obj_props[PROP_FIRST_CHILD]);
 
       if (old_last != self->priv->last_child)
-        g_object_notify_by_pspec (obj, obj_props[PROP_LAST_CHILD]);
+        clutter_actor_notify_by_pspec (obj, obj_props[PROP_LAST_CHILD]);
     }
 
   g_object_thaw_notify (obj);
@@ -4404,9 +4733,9 @@ clutter_actor_set_pivot_point_internal (ClutterActor       *self,
   info = _clutter_actor_get_transform_info (self);
   info->pivot = *pivot;
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_PIVOT_POINT]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_PIVOT_POINT]);
 
   clutter_actor_queue_redraw (self);
 }
@@ -4420,9 +4749,9 @@ clutter_actor_set_pivot_point_z_internal (ClutterActor *self,
   info = _clutter_actor_get_transform_info (self);
   info->pivot_z = pivot_z;
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_PIVOT_POINT_Z]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_PIVOT_POINT_Z]);
 
   clutter_actor_queue_redraw (self);
 }
@@ -4454,9 +4783,9 @@ clutter_actor_set_translation_internal (ClutterActor *self,
   else
     g_assert_not_reached ();
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
   clutter_actor_queue_redraw (self);
-  g_object_notify_by_pspec (obj, pspec);
+  clutter_actor_notify_by_pspec (obj, pspec);
 }
 
 static inline void
@@ -4586,11 +4915,11 @@ clutter_actor_set_rotation_angle_internal (ClutterActor *self,
   else
     g_assert_not_reached ();
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   clutter_actor_queue_redraw (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), pspec);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), pspec);
 }
 
 /**
@@ -4721,12 +5050,12 @@ clutter_actor_set_rotation_center_internal (ClutterActor        *self,
     {
     case CLUTTER_X_AXIS:
       clutter_anchor_coord_set_units (&info->rx_center, v.x, v.y, v.z);
-      g_object_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_X]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_X]);
       break;
 
     case CLUTTER_Y_AXIS:
       clutter_anchor_coord_set_units (&info->ry_center, v.x, v.y, v.z);
-      g_object_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_Y]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_Y]);
       break;
 
     case CLUTTER_Z_AXIS:
@@ -4735,14 +5064,14 @@ clutter_actor_set_rotation_center_internal (ClutterActor        *self,
        * :rotation-center-z-gravity property as well
        */
       if (info->rz_center.is_fractional)
-        g_object_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_Z_GRAVITY]);
+        clutter_actor_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_Z_GRAVITY]);
 
       clutter_anchor_coord_set_units (&info->rz_center, v.x, v.y, v.z);
-      g_object_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_Z]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_Z]);
       break;
     }
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   g_object_thaw_notify (obj);
 
@@ -4768,9 +5097,9 @@ clutter_actor_set_scale_factor_internal (ClutterActor *self,
   else
     g_assert_not_reached ();
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
   clutter_actor_queue_redraw (self);
-  g_object_notify_by_pspec (obj, pspec);
+  clutter_actor_notify_by_pspec (obj, pspec);
 }
 
 static inline void
@@ -4831,25 +5160,25 @@ clutter_actor_set_scale_center (ClutterActor      *self,
    * change the gravity as a side effect
    */
   if (info->scale_center.is_fractional)
-    g_object_notify_by_pspec (obj, obj_props[PROP_SCALE_GRAVITY]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_SCALE_GRAVITY]);
 
   switch (axis)
     {
     case CLUTTER_X_AXIS:
       clutter_anchor_coord_set_units (&info->scale_center, coord, center_y, 0);
-      g_object_notify_by_pspec (obj, obj_props[PROP_SCALE_CENTER_X]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_SCALE_CENTER_X]);
       break;
 
     case CLUTTER_Y_AXIS:
       clutter_anchor_coord_set_units (&info->scale_center, center_x, coord, 0);
-      g_object_notify_by_pspec (obj, obj_props[PROP_SCALE_CENTER_Y]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_SCALE_CENTER_Y]);
       break;
 
     default:
       g_assert_not_reached ();
     }
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   clutter_actor_queue_redraw (self);
 
@@ -4871,11 +5200,11 @@ clutter_actor_set_scale_gravity (ClutterActor   *self,
   else
     clutter_anchor_coord_set_gravity (&info->scale_center, gravity);
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
-  g_object_notify_by_pspec (obj, obj_props[PROP_SCALE_CENTER_X]);
-  g_object_notify_by_pspec (obj, obj_props[PROP_SCALE_CENTER_Y]);
-  g_object_notify_by_pspec (obj, obj_props[PROP_SCALE_GRAVITY]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_SCALE_CENTER_X]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_SCALE_CENTER_Y]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_SCALE_GRAVITY]);
 
   clutter_actor_queue_redraw (self);
 }
@@ -4900,7 +5229,7 @@ clutter_actor_set_anchor_coord (ClutterActor      *self,
                                   NULL);
 
   if (info->anchor.is_fractional)
-    g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_GRAVITY]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_ANCHOR_GRAVITY]);
 
   switch (axis)
     {
@@ -4909,7 +5238,7 @@ clutter_actor_set_anchor_coord (ClutterActor      *self,
                                       coord,
                                       anchor_y,
                                       0.0);
-      g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_X]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ANCHOR_X]);
       break;
 
     case CLUTTER_Y_AXIS:
@@ -4917,14 +5246,14 @@ clutter_actor_set_anchor_coord (ClutterActor      *self,
                                       anchor_x,
                                       coord,
                                       0.0);
-      g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_Y]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ANCHOR_Y]);
       break;
 
     default:
       g_assert_not_reached ();
     }
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   clutter_actor_queue_redraw (self);
 
@@ -4948,9 +5277,9 @@ clutter_actor_set_clip_rect (ClutterActor      *self,
 
   clutter_actor_queue_redraw (self);
 
-  g_object_notify_by_pspec (obj, obj_props[PROP_CLIP]); /* XXX:2.0 - remove */
-  g_object_notify_by_pspec (obj, obj_props[PROP_CLIP_RECT]);
-  g_object_notify_by_pspec (obj, obj_props[PROP_HAS_CLIP]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_CLIP]); /* XXX:2.0 - remove */
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_CLIP_RECT]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_HAS_CLIP]);
 }
 
 static void
@@ -5298,12 +5627,12 @@ clutter_actor_set_property (GObject      *object,
     case PROP_MINIFICATION_FILTER:
       clutter_actor_set_content_scaling_filters (actor,
                                                  g_value_get_enum (value),
-                                                 actor->priv->mag_filter);
+                                                 clutter_actor_get_content_info_or_defaults (actor)->mag_filter);
       break;
 
     case PROP_MAGNIFICATION_FILTER:
       clutter_actor_set_content_scaling_filters (actor,
-                                                 actor->priv->min_filter,
+                                                 clutter_actor_get_content_info_or_defaults (actor)->min_filter,
                                                  g_value_get_enum (value));
       break;
 
@@ -5852,7 +6181,7 @@ clutter_actor_get_property (GObject    *object,
       break;
 
     case PROP_CONTENT_GRAVITY:
-      g_value_set_enum (value, priv->content_gravity);
+      g_value_set_enum (value, clutter_actor_get_content_info_or_defaults (actor)->content_gravity);
       break;
 
     case PROP_CONTENT_BOX:
@@ -5865,15 +6194,15 @@ clutter_actor_get_property (GObject    *object,
       break;
 
     case PROP_MINIFICATION_FILTER:
-      g_value_set_enum (value, priv->min_filter);
+      g_value_set_enum (value, clutter_actor_get_content_info_or_defaults (actor)->min_filter);
       break;
 
     case PROP_MAGNIFICATION_FILTER:
-      g_value_set_enum (value, priv->mag_filter);
+      g_value_set_enum (value, clutter_actor_get_content_info_or_defaults (actor)->mag_filter);
       break;
 
     case PROP_CONTENT_REPEAT:
-      g_value_set_flags (value, priv->content_repeat);
+      g_value_set_flags (value, clutter_actor_get_content_info_or_defaults (actor)->content_repeat);
       break;
 
     default:
@@ -5882,6 +6211,25 @@ clutter_actor_get_property (GObject    *object,
     }
 }
 
+/* removes @self from its parent, the same way destroying it would */
+static void
+clutter_actor_remove_from_parent (ClutterActor *self)
+{
+  ClutterActor *parent = self->priv->parent;
+
+  /* go through the Container implementation unless this
+   * is an internal child and has been marked as such.
+   *
+   * removing the actor from its parent will reset the
+   * realized and mapped states.
+   */
+  if (!CLUTTER_ACTOR_IS_INTERNAL_CHILD (self))
+    clutter_container_remove_actor (CLUTTER_CONTAINER (parent), self);
+  else
+    clutter_actor_remove_child_internal (parent, self,
+                                         REMOVE_CHILD_LEGACY_FLAGS);
+}
+
 static void
 clutter_actor_dispose (GObject *object)
 {
@@ -5895,23 +6243,14 @@ clutter_actor_dispose (GObject *object)
 
   g_signal_emit (self, actor_signals[DESTROY], 0);
 
+  /* the actor may be destroyed before clutter_actor_destroy_deferred()
+   * reaches it, e.g. by the destroy implementation of its parent
+   */
+  priv->destroy_deferred = FALSE;
+
   /* avoid recursing when called from clutter_actor_destroy() */
   if (priv->parent != NULL)
-    {
-      ClutterActor *parent = priv->parent;
-
-      /* go through the Container implementation unless this
-       * is an internal child and has been marked as such.
-       *
-       * removing the actor from its parent will reset the
-       * realized and mapped states.
-       */
-      if (!CLUTTER_ACTOR_IS_INTERNAL_CHILD (self))
-        clutter_container_remove_actor (CLUTTER_CONTAINER (parent), self);
-      else
-        clutter_actor_remove_child_internal (parent, self,
-                                             REMOVE_CHILD_LEGACY_FLAGS);
-    }
+    clutter_actor_remove_from_parent (self);
 
   /* parent must be gone at this point */
   g_assert (priv->parent == NULL);
@@ -5929,17 +6268,7 @@ clutter_actor_dispose (GObject *object)
   g_clear_object (&priv->effects);
   g_clear_object (&priv->flatten_effect);
 
-  if (priv->child_model != NULL)
-    {
-      if (priv->create_child_notify != NULL)
-        priv->create_child_notify (priv->create_child_data);
-
-      priv->create_child_func = NULL;
-      priv->create_child_data = NULL;
-      priv->create_child_notify = NULL;
-
-      g_clear_object (&priv->child_model);
-    }
+  clutter_actor_unbind_child_model (self);
 
   if (priv->layout_manager != NULL)
     {
@@ -5977,6 +6306,14 @@ clutter_actor_finalize (GObject *object)
   g_free (priv->debug_name);
 #endif
 
+  if (priv->content_info != NULL)
+    g_slice_free (ClutterContentInfo, priv->content_info);
+
+  if (priv->geometry != NULL)
+    g_slice_free (ClutterGeometrySnapshot, priv->geometry);
+
+  _clutter_profiler_forget_actor (CLUTTER_ACTOR (object));
+
   G_OBJECT_CLASS (clutter_actor_parent_class)->finalize (object);
 }
 
@@ -6223,9 +6560,20 @@ clutter_actor_real_destroy (ClutterActor *actor)
 
   g_object_freeze_notify (G_OBJECT (actor));
 
-  clutter_actor_iter_init (&iter, actor);
-  while (clutter_actor_iter_next (&iter, NULL))
-    clutter_actor_iter_destroy (&iter);
+  /* the children of an actor passed to clutter_actor_destroy_deferred()
+   * are destroyed in later batches, after their parent
+   */
+  if (actor->priv->destroy_deferred)
+    {
+      while (actor->priv->last_child != NULL)
+        clutter_actor_queue_destroy_deferred (actor->priv->last_child);
+    }
+  else
+    {
+      clutter_actor_iter_init (&iter, actor);
+      while (clutter_actor_iter_next (&iter, NULL))
+        clutter_actor_iter_destroy (&iter);
+    }
 
   g_object_thaw_notify (G_OBJECT (actor));
 }
@@ -6260,11 +6608,13 @@ static void
 clutter_actor_class_init (ClutterActorClass *klass)
 {
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  guint i;
 
   quark_shader_data = g_quark_from_static_string ("-clutter-actor-shader-data");
   quark_actor_layout_info = g_quark_from_static_string ("-clutter-actor-layout-info");
   quark_actor_transform_info = g_quark_from_static_string ("-clutter-actor-transform-info");
   quark_actor_animation_info = g_quark_from_static_string ("-clutter-actor-animation-info");
+  quark_bind_child = g_quark_from_static_string ("-clutter-actor-bind-child");
 
   object_class->constructor = clutter_actor_constructor;
   object_class->set_property = clutter_actor_set_property;
@@ -7848,6 +8198,16 @@ clutter_actor_class_init (ClutterActorClass *klass)
 
   g_object_class_install_properties (object_class, PROP_LAST, obj_props);
 
+  for (i = PROP_0 + 1; i < PROP_LAST; i++)
+    {
+      if (obj_props[i] != NULL)
+        obj_props_quarks[i] = g_quark_from_static_string (obj_props[i]->name);
+    }
+
+  notify_signal_id = g_signal_lookup ("notify", G_TYPE_OBJECT);
+  object_dispatch_properties_changed =
+    G_OBJECT_CLASS (clutter_actor_parent_class)->dispatch_properties_changed;
+
   /**
    * ClutterActor::destroy:
    * @actor: the #ClutterActor which emitted the signal
@@ -8512,9 +8872,6 @@ clutter_actor_init (ClutterActor *self)
    * current behaviour of basically all actors. also, it's
    * the easiest thing to compute.
    */
-  priv->content_gravity = CLUTTER_CONTENT_GRAVITY_RESIZE_FILL;
-  priv->min_filter = CLUTTER_SCALING_FILTER_LINEAR;
-  priv->mag_filter = CLUTTER_SCALING_FILTER_LINEAR;
 
   /* this flag will be set to TRUE if the actor gets a child
    * or if the [xy]-expand flags are explicitly set; until
@@ -8580,7 +8937,112 @@ clutter_actor_destroy (ClutterActor *self)
       CLUTTER_UNSET_PRIVATE_FLAGS (self, CLUTTER_IN_DESTRUCTION);
     }
 
-  g_object_unref (self);
+  g_object_unref (self);
+}
+
+/* The time, in microseconds, that can be spent destroying actors
+ * queued by clutter_actor_destroy_deferred() in a single idle
+ */
+#define DEFERRED_DESTROY_BUDGET         (2 * 1000)
+
+static GQueue deferred_destroy_queue = G_QUEUE_INIT;
+static guint deferred_destroy_id = 0;
+
+static gboolean
+clutter_actor_destroy_deferred_func (gpointer data G_GNUC_UNUSED)
+{
+  gint64 deadline = g_get_monotonic_time () + DEFERRED_DESTROY_BUDGET;
+
+  do
+    {
+      ClutterActor *actor = g_queue_pop_head (&deferred_destroy_queue);
+
+      /* the actor may have already been destroyed by somebody else;
+       * otherwise, it is destroyed with its children still attached,
+       * and the default handler of ::destroy queues them after it
+       */
+      if (actor->priv->destroy_deferred)
+        clutter_actor_destroy (actor);
+
+      g_object_unref (actor);
+    }
+  while (!g_queue_is_empty (&deferred_destroy_queue) &&
+         g_get_monotonic_time () < deadline);
+
+  if (g_queue_is_empty (&deferred_destroy_queue))
+    {
+      deferred_destroy_id = 0;
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+clutter_actor_queue_destroy_deferred (ClutterActor *self)
+{
+  self->priv->destroy_deferred = TRUE;
+
+  g_object_ref (self);
+
+  if (self->priv->parent != NULL)
+    clutter_actor_remove_from_parent (self);
+
+  g_queue_push_tail (&deferred_destroy_queue, self);
+
+  if (deferred_destroy_id == 0)
+    deferred_destroy_id = clutter_threads_add_idle_full (G_PRIORITY_DEFAULT_IDLE,
+                                                         clutter_actor_destroy_deferred_func,
+                                                         NULL,
+                                                         NULL);
+}
+
+/**
+ * clutter_actor_destroy_deferred:
+ * @self: a #ClutterActor
+ *
+ * Destroys an actor, and all its children, without blocking the
+ * main loop for the whole duration of the teardown.
+ *
+ * The actor is removed from its parent before this function returns,
+ * so it is immediately unmapped and unrealized, and it is not painted
+ * or picked any more; the actual destruction of the actor and of its
+ * children, including the emission of the #ClutterActor::destroy signal,
+ * is performed in batches while the main loop is idle.
+ *
+ * The #ClutterActor::destroy signal of each actor is emitted while its
+ * children are still attached to it, like in clutter_actor_destroy();
+ * unlike clutter_actor_destroy(), though, the default handler of the
+ * signal removes the children instead of destroying them, and they are
+ * destroyed in a later batch, so the #ClutterActor::destroy signal of
+ * a child is emitted after the one of its parent, and when the child
+ * does not have a parent any more.
+ *
+ * This function is useful when destroying large scene graphs, which
+ * would cause a noticeable delay if destroyed using
+ * clutter_actor_destroy().
+ *
+ * After calling this function the actor, and its children, should not
+ * be used any more, and in particular they must not be added to another
+ * parent.
+ *
+ * Since: 1.26
+ */
+void
+clutter_actor_destroy_deferred (ClutterActor *self)
+{
+  g_return_if_fail (CLUTTER_IS_ACTOR (self));
+
+  if (CLUTTER_ACTOR_IS_TOPLEVEL (self))
+    {
+      clutter_actor_destroy (self);
+      return;
+    }
+
+  if (self->priv->destroy_deferred || CLUTTER_ACTOR_IN_DESTRUCTION (self))
+    return;
+
+  clutter_actor_queue_destroy_deferred (self);
 }
 
 void
@@ -8697,6 +9159,9 @@ _clutter_actor_queue_redraw_full (ClutterActor       *self,
   gboolean should_free_pv;
   ClutterActor *stage;
 
+  /* anything queueing a redraw may have changed the paint volume */
+  geometry_serial += 1;
+
   /* Here's an outline of the actor queue redraw mechanism:
    *
    * The process starts in one of the following two functions which
@@ -8982,6 +9447,9 @@ _clutter_actor_queue_only_relayout (ClutterActor *self)
   if (CLUTTER_ACTOR_IN_DESTRUCTION (self))
     return;
 
+  /* the actor has no paint volume until it has been allocated again */
+  geometry_serial += 1;
+
   if (priv->needs_width_request &&
       priv->needs_height_request &&
       priv->needs_allocation)
@@ -9469,11 +9937,14 @@ clutter_actor_get_preferred_width (ClutterActor *self,
   const ClutterLayoutInfo *info;
   ClutterActorPrivate *priv;
   gboolean found_in_cache;
+  gint64 profile_start;
 
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
   priv = self->priv;
 
+  profile_start = _clutter_profiler_actor_begin ();
+
   info = _clutter_actor_get_layout_info_or_defaults (self);
 
   /* we shortcircuit the case of a fixed size set using set_width() */
@@ -9485,6 +9956,10 @@ clutter_actor_get_preferred_width (ClutterActor *self,
       if (natural_width_p != NULL)
         *natural_width_p = info->natural.width + (info->margin.left + info->margin.right);
 
+      _clutter_profiler_actor_end (self, CLUTTER_PROFILER_COST_PREFERRED_SIZE,
+                                   FALSE,
+                                   profile_start);
+
       return;
     }
 
@@ -9579,6 +10054,10 @@ clutter_actor_get_preferred_width (ClutterActor *self,
 
   if (natural_width_p)
     *natural_width_p = request_natural_width;
+
+  _clutter_profiler_actor_end (self, CLUTTER_PROFILER_COST_PREFERRED_SIZE,
+                               !found_in_cache,
+                               profile_start);
 }
 
 /**
@@ -9613,11 +10092,14 @@ clutter_actor_get_preferred_height (ClutterActor *self,
   const ClutterLayoutInfo *info;
   ClutterActorPrivate *priv;
   gboolean found_in_cache;
+  gint64 profile_start;
 
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
   priv = self->priv;
 
+  profile_start = _clutter_profiler_actor_begin ();
+
   info = _clutter_actor_get_layout_info_or_defaults (self);
 
   /* we shortcircuit the case of a fixed size set using set_height() */
@@ -9629,6 +10111,10 @@ clutter_actor_get_preferred_height (ClutterActor *self,
       if (natural_height_p != NULL)
         *natural_height_p = info->natural.height + (info->margin.top + info->margin.bottom);
 
+      _clutter_profiler_actor_end (self, CLUTTER_PROFILER_COST_PREFERRED_SIZE,
+                                   FALSE,
+                                   profile_start);
+
       return;
     }
 
@@ -9722,6 +10208,10 @@ clutter_actor_get_preferred_height (ClutterActor *self,
 
   if (natural_height_p)
     *natural_height_p = request_natural_height;
+
+  _clutter_profiler_actor_end (self, CLUTTER_PROFILER_COST_PREFERRED_SIZE,
+                               !found_in_cache,
+                               profile_start);
 }
 
 /**
@@ -9993,6 +10483,7 @@ clutter_actor_allocate (ClutterActor           *self,
   gboolean origin_changed, child_moved, size_changed;
   gboolean stage_allocation_changed;
   ClutterActorPrivate *priv;
+  gint64 profile_start;
 
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
   if (G_UNLIKELY (_clutter_actor_get_stage_internal (self) == NULL))
@@ -10005,6 +10496,8 @@ clutter_actor_allocate (ClutterActor           *self,
 
   priv = self->priv;
 
+  profile_start = _clutter_profiler_actor_begin ();
+
   old_allocation = priv->allocation;
   real_allocation = *box;
 
@@ -10058,6 +10551,9 @@ clutter_actor_allocate (ClutterActor           *self,
   if (!priv->needs_allocation && !stage_allocation_changed)
     {
       CLUTTER_NOTE (LAYOUT, "No allocation needed");
+      _clutter_profiler_actor_end (self, CLUTTER_PROFILER_COST_ALLOCATE,
+                                   FALSE,
+                                   profile_start);
       return;
     }
 
@@ -10066,6 +10562,9 @@ clutter_actor_allocate (ClutterActor           *self,
       /* If the actor didn't move but needs_allocation is set, we just
        * need to allocate the children */
       clutter_actor_allocate_internal (self, &real_allocation, flags);
+      _clutter_profiler_actor_end (self, CLUTTER_PROFILER_COST_ALLOCATE,
+                                   TRUE,
+                                   profile_start);
       return;
     }
 
@@ -10086,6 +10585,10 @@ clutter_actor_allocate (ClutterActor           *self,
   _clutter_actor_create_transition (self, obj_props[PROP_ALLOCATION],
                                     &priv->allocation,
                                     &real_allocation);
+
+  _clutter_profiler_actor_end (self, CLUTTER_PROFILER_COST_ALLOCATE,
+                               TRUE,
+                               profile_start);
 }
 
 /**
@@ -10298,7 +10801,7 @@ clutter_actor_set_fixed_position_set (ClutterActor *self,
     }
 
   self->priv->position_set = is_set != FALSE;
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_FIXED_POSITION_SET]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_FIXED_POSITION_SET]);
 
   clutter_actor_queue_relayout (self);
 }
@@ -10363,7 +10866,7 @@ clutter_actor_set_min_width (ClutterActor *self,
   clutter_actor_store_old_geometry (self, &old);
 
   info->minimum.width = min_width;
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MIN_WIDTH]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MIN_WIDTH]);
   clutter_actor_set_min_width_set (self, TRUE);
 
   clutter_actor_notify_if_geometry_changed (self, &old);
@@ -10401,7 +10904,7 @@ clutter_actor_set_min_height (ClutterActor *self,
   clutter_actor_store_old_geometry (self, &old);
 
   info->minimum.height = min_height;
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MIN_HEIGHT]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MIN_HEIGHT]);
   clutter_actor_set_min_height_set (self, TRUE);
 
   clutter_actor_notify_if_geometry_changed (self, &old);
@@ -10438,7 +10941,7 @@ clutter_actor_set_natural_width (ClutterActor *self,
   clutter_actor_store_old_geometry (self, &old);
 
   info->natural.width = natural_width;
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_NATURAL_WIDTH]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_NATURAL_WIDTH]);
   clutter_actor_set_natural_width_set (self, TRUE);
 
   clutter_actor_notify_if_geometry_changed (self, &old);
@@ -10475,7 +10978,7 @@ clutter_actor_set_natural_height (ClutterActor *self,
   clutter_actor_store_old_geometry (self, &old);
 
   info->natural.height = natural_height;
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_NATURAL_HEIGHT]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_NATURAL_HEIGHT]);
   clutter_actor_set_natural_height_set (self, TRUE);
 
   clutter_actor_notify_if_geometry_changed (self, &old);
@@ -10498,7 +11001,7 @@ clutter_actor_set_min_width_set (ClutterActor *self,
   clutter_actor_store_old_geometry (self, &old);
 
   priv->min_width_set = use_min_width != FALSE;
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MIN_WIDTH_SET]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MIN_WIDTH_SET]);
 
   clutter_actor_notify_if_geometry_changed (self, &old);
 
@@ -10518,7 +11021,7 @@ clutter_actor_set_min_height_set (ClutterActor *self,
   clutter_actor_store_old_geometry (self, &old);
 
   priv->min_height_set = use_min_height != FALSE;
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MIN_HEIGHT_SET]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_MIN_HEIGHT_SET]);
 
   clutter_actor_notify_if_geometry_changed (self, &old);
 
@@ -10538,7 +11041,7 @@ clutter_actor_set_natural_width_set (ClutterActor *self,
   clutter_actor_store_old_geometry (self, &old);
 
   priv->natural_width_set = use_natural_width != FALSE;
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_NATURAL_WIDTH_SET]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_NATURAL_WIDTH_SET]);
 
   clutter_actor_notify_if_geometry_changed (self, &old);
 
@@ -10558,7 +11061,7 @@ clutter_actor_set_natural_height_set (ClutterActor *self,
   clutter_actor_store_old_geometry (self, &old);
 
   priv->natural_height_set = use_natural_height != FALSE;
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_NATURAL_HEIGHT_SET]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_NATURAL_HEIGHT_SET]);
 
   clutter_actor_notify_if_geometry_changed (self, &old);
 
@@ -10596,7 +11099,7 @@ clutter_actor_set_request_mode (ClutterActor       *self,
   priv->needs_width_request = TRUE;
   priv->needs_height_request = TRUE;
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_REQUEST_MODE]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_REQUEST_MODE]);
 
   clutter_actor_queue_relayout (self);
 }
@@ -11631,7 +12134,7 @@ clutter_actor_set_opacity_internal (ClutterActor *self,
                                         NULL, /* clip */
                                         priv->flatten_effect);
 
-      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_OPACITY]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_OPACITY]);
     }
 }
 
@@ -11830,8 +12333,8 @@ clutter_actor_set_offscreen_redirect (ClutterActor *self,
                                         NULL, /* clip */
                                         priv->flatten_effect);
 
-      g_object_notify_by_pspec (G_OBJECT (self),
-                                obj_props[PROP_OFFSCREEN_REDIRECT]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self),
+                                     obj_props[PROP_OFFSCREEN_REDIRECT]);
     }
 }
 
@@ -11871,7 +12374,7 @@ clutter_actor_set_name (ClutterActor *self,
   g_free (self->priv->name);
   self->priv->name = g_strdup (name);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_NAME]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_NAME]);
 }
 
 /**
@@ -11925,7 +12428,7 @@ clutter_actor_set_depth_internal (ClutterActor *self,
       /* Sets Z value - XXX 2.0: should we invert? */
       info->z_position = depth;
 
-      self->priv->transform_valid = FALSE;
+      clutter_actor_invalidate_transform (self);
 
       /* FIXME - remove this crap; sadly, there are still containers
        * in Clutter that depend on this utter brain damage
@@ -11934,7 +12437,7 @@ clutter_actor_set_depth_internal (ClutterActor *self,
 
       clutter_actor_queue_redraw (self);
 
-      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_DEPTH]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_DEPTH]);
     }
 }
 
@@ -11950,11 +12453,11 @@ clutter_actor_set_z_position_internal (ClutterActor *self,
     {
       info->z_position = z_position;
 
-      self->priv->transform_valid = FALSE;
+      clutter_actor_invalidate_transform (self);
 
       clutter_actor_queue_redraw (self);
 
-      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_Z_POSITION]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_Z_POSITION]);
     }
 }
 
@@ -12239,8 +12742,8 @@ clutter_actor_set_z_rotation_from_gravity (ClutterActor   *self,
       clutter_actor_set_rotation_angle_internal (self, angle, pspec);
 
       clutter_anchor_coord_set_gravity (&info->rz_center, gravity);
-      g_object_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_Z_GRAVITY]);
-      g_object_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_Z]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_Z_GRAVITY]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ROTATION_CENTER_Z]);
 
       g_object_thaw_notify (obj);
     }
@@ -12380,9 +12883,9 @@ clutter_actor_set_clip (ClutterActor *self,
 
   clutter_actor_queue_redraw (self);
 
-  g_object_notify_by_pspec (obj, obj_props[PROP_CLIP]);
-  g_object_notify_by_pspec (obj, obj_props[PROP_CLIP_RECT]);
-  g_object_notify_by_pspec (obj, obj_props[PROP_HAS_CLIP]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_CLIP]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_CLIP_RECT]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_HAS_CLIP]);
 }
 
 /**
@@ -12403,7 +12906,7 @@ clutter_actor_remove_clip (ClutterActor *self)
 
   clutter_actor_queue_redraw (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_HAS_CLIP]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_HAS_CLIP]);
 }
 
 /**
@@ -12794,6 +13297,9 @@ clutter_actor_add_child_internal (ClutterActor              *self,
       return;
     }
 
+  /* the actor is waiting to be destroyed by clutter_actor_destroy_deferred() */
+  g_return_if_fail (!child->priv->destroy_deferred);
+
   /* the following check disallows calling methods that change the stacking
    * order within the destruction sequence, by triggering a critical
    * warning first, and leaving the actor in an undefined state, which
@@ -12868,6 +13374,9 @@ clutter_actor_add_child_internal (ClutterActor              *self,
 
   g_assert (child->priv->parent == self);
 
+  /* the transformation of the child now depends on its new parent */
+  clutter_actor_invalidate_transform (child);
+
   self->priv->n_children += 1;
 
   self->priv->age += 1;
@@ -12955,10 +13464,10 @@ clutter_actor_add_child_internal (ClutterActor              *self,
   if (notify_first_last)
     {
       if (old_first_child != self->priv->first_child)
-        g_object_notify_by_pspec (obj, obj_props[PROP_FIRST_CHILD]);
+        clutter_actor_notify_by_pspec (obj, obj_props[PROP_FIRST_CHILD]);
 
       if (old_last_child != self->priv->last_child)
-        g_object_notify_by_pspec (obj, obj_props[PROP_LAST_CHILD]);
+        clutter_actor_notify_by_pspec (obj, obj_props[PROP_LAST_CHILD]);
     }
 
   g_object_thaw_notify (obj);
@@ -13926,7 +14435,7 @@ clutter_actor_set_reactive (ClutterActor *actor,
   else
     CLUTTER_ACTOR_UNSET_FLAGS (actor, CLUTTER_ACTOR_REACTIVE);
 
-  g_object_notify_by_pspec (G_OBJECT (actor), obj_props[PROP_REACTIVE]);
+  clutter_actor_notify_by_pspec (G_OBJECT (actor), obj_props[PROP_REACTIVE]);
 }
 
 /**
@@ -14015,17 +14524,17 @@ clutter_actor_set_anchor_point (ClutterActor *self,
                                   NULL);
 
   if (info->anchor.is_fractional)
-    g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_GRAVITY]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_ANCHOR_GRAVITY]);
 
   if (old_anchor_x != anchor_x)
     {
-      g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_X]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ANCHOR_X]);
       changed = TRUE;
     }
 
   if (old_anchor_y != anchor_y)
     {
-      g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_Y]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ANCHOR_Y]);
       changed = TRUE;
     }
 
@@ -14033,7 +14542,7 @@ clutter_actor_set_anchor_point (ClutterActor *self,
 
   if (changed)
     {
-      priv->transform_valid = FALSE;
+      clutter_actor_invalidate_transform (self);
       clutter_actor_queue_redraw (self);
     }
 
@@ -14199,11 +14708,11 @@ clutter_actor_set_anchor_point_from_gravity (ClutterActor   *self,
       info = _clutter_actor_get_transform_info (self);
       clutter_anchor_coord_set_gravity (&info->anchor, gravity);
 
-      g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_GRAVITY]);
-      g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_X]);
-      g_object_notify_by_pspec (obj, obj_props[PROP_ANCHOR_Y]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ANCHOR_GRAVITY]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ANCHOR_X]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_ANCHOR_Y]);
 
-      self->priv->transform_valid = FALSE;
+      clutter_actor_invalidate_transform (self);
 
       clutter_actor_queue_redraw (self);
 
@@ -14217,7 +14726,7 @@ clutter_actor_store_content_box (ClutterActor *self,
 {
   if (box != NULL)
     {
-      self->priv->content_box = *box;
+      clutter_actor_get_content_info (self)->content_box = *box;
       self->priv->content_box_valid = TRUE;
     }
   else
@@ -14225,7 +14734,7 @@ clutter_actor_store_content_box (ClutterActor *self,
 
   clutter_actor_queue_redraw (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONTENT_BOX]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONTENT_BOX]);
 }
 
 static void
@@ -16173,16 +16682,16 @@ clutter_actor_set_flags (ClutterActor      *self,
   visible_set  = ((self->flags & CLUTTER_ACTOR_VISIBLE)  != 0);
 
   if (reactive_set != was_reactive_set)
-    g_object_notify_by_pspec (obj, obj_props[PROP_REACTIVE]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_REACTIVE]);
 
   if (realized_set != was_realized_set)
-    g_object_notify_by_pspec (obj, obj_props[PROP_REALIZED]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_REALIZED]);
 
   if (mapped_set != was_mapped_set)
-    g_object_notify_by_pspec (obj, obj_props[PROP_MAPPED]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_MAPPED]);
 
   if (visible_set != was_visible_set)
-    g_object_notify_by_pspec (obj, obj_props[PROP_VISIBLE]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_VISIBLE]);
 
   g_object_thaw_notify (obj);
   g_object_unref (obj);
@@ -16233,16 +16742,16 @@ clutter_actor_unset_flags (ClutterActor      *self,
   visible_set  = ((self->flags & CLUTTER_ACTOR_VISIBLE)  != 0);
 
   if (reactive_set != was_reactive_set)
-    g_object_notify_by_pspec (obj, obj_props[PROP_REACTIVE]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_REACTIVE]);
 
   if (realized_set != was_realized_set)
-    g_object_notify_by_pspec (obj, obj_props[PROP_REALIZED]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_REALIZED]);
 
   if (mapped_set != was_mapped_set)
-    g_object_notify_by_pspec (obj, obj_props[PROP_MAPPED]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_MAPPED]);
 
   if (visible_set != was_visible_set)
-    g_object_notify_by_pspec (obj, obj_props[PROP_VISIBLE]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_VISIBLE]);
 
   g_object_thaw_notify (obj);
 }
@@ -16283,14 +16792,14 @@ clutter_actor_set_transform_internal (ClutterActor        *self,
   info->transform = *transform;
   info->transform_set = !cogl_matrix_is_identity (&info->transform);
 
-  self->priv->transform_valid = FALSE;
+  clutter_actor_invalidate_transform (self);
 
   clutter_actor_queue_redraw (self);
 
-  g_object_notify_by_pspec (obj, obj_props[PROP_TRANSFORM]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_TRANSFORM]);
 
   if (was_set != info->transform_set)
-    g_object_notify_by_pspec (obj, obj_props[PROP_TRANSFORM_SET]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_TRANSFORM_SET]);
 }
 
 /**
@@ -16430,7 +16939,7 @@ clutter_actor_set_text_direction (ClutterActor         *self,
        * the text direction; see clutter_text_direction_changed_cb()
        * inside clutter-text.c
        */
-      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_TEXT_DIRECTION]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_TEXT_DIRECTION]);
 
       _clutter_actor_foreach_child (self, set_direction_recursive,
                                     GINT_TO_POINTER (text_dir));
@@ -16449,7 +16958,7 @@ _clutter_actor_set_has_pointer (ClutterActor *self,
     {
       priv->has_pointer = has_pointer;
 
-      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_HAS_POINTER]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_HAS_POINTER]);
     }
 }
 
@@ -16685,7 +17194,7 @@ clutter_actor_add_action (ClutterActor  *self,
 
   _clutter_meta_group_add_meta (priv->actions, CLUTTER_ACTOR_META (action));
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_ACTIONS]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_ACTIONS]);
 }
 
 /**
@@ -16749,7 +17258,7 @@ clutter_actor_remove_action (ClutterActor  *self,
   if (_clutter_meta_group_peek_metas (priv->actions) == NULL)
     g_clear_object (&priv->actions);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_ACTIONS]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_ACTIONS]);
 }
 
 /**
@@ -16783,7 +17292,7 @@ clutter_actor_remove_action_by_name (ClutterActor *self,
 
   _clutter_meta_group_remove_meta (priv->actions, meta);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_ACTIONS]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_ACTIONS]);
 }
 
 /**
@@ -16891,7 +17400,7 @@ clutter_actor_add_constraint (ClutterActor      *self,
                                 CLUTTER_ACTOR_META (constraint));
   clutter_actor_queue_relayout (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONSTRAINTS]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONSTRAINTS]);
 }
 
 /**
@@ -16958,7 +17467,7 @@ clutter_actor_remove_constraint (ClutterActor      *self,
 
   clutter_actor_queue_relayout (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONSTRAINTS]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONSTRAINTS]);
 }
 
 /**
@@ -17094,8 +17603,8 @@ clutter_actor_set_clip_to_allocation (ClutterActor *self,
 
       clutter_actor_queue_redraw (self);
 
-      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CLIP_TO_ALLOCATION]);
-      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_HAS_CLIP]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CLIP_TO_ALLOCATION]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_HAS_CLIP]);
     }
 }
 
@@ -17141,7 +17650,7 @@ clutter_actor_add_effect (ClutterActor  *self,
 
   clutter_actor_queue_redraw (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_EFFECT]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_EFFECT]);
 }
 
 /**
@@ -17197,7 +17706,7 @@ clutter_actor_remove_effect (ClutterActor  *self,
 
   clutter_actor_queue_redraw (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_EFFECT]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_EFFECT]);
 }
 
 /**
@@ -17596,6 +18105,7 @@ gboolean
 clutter_actor_get_paint_box (ClutterActor    *self,
                              ClutterActorBox *box)
 {
+  ClutterGeometrySnapshot *geometry;
   ClutterActor *stage;
   ClutterPaintVolume *pv;
 
@@ -17606,11 +18116,25 @@ clutter_actor_get_paint_box (ClutterActor    *self,
   if (G_UNLIKELY (!stage))
     return FALSE;
 
-  pv = _clutter_actor_get_paint_volume_mutable (self);
-  if (G_UNLIKELY (!pv))
+  /* the paint box is computed at most once per frame, unless the
+   * geometry of an actor changes in the meantime
+   */
+  geometry = clutter_actor_get_geometry_snapshot (self);
+  if (!geometry->paint_box_valid)
+    {
+      pv = _clutter_actor_get_paint_volume_mutable (self);
+      if (pv != NULL)
+        _clutter_paint_volume_get_stage_paint_box (pv, CLUTTER_STAGE (stage),
+                                                   &geometry->paint_box);
+
+      geometry->has_paint_box = pv != NULL;
+      geometry->paint_box_valid = TRUE;
+    }
+
+  if (G_UNLIKELY (!geometry->has_paint_box))
     return FALSE;
 
-  _clutter_paint_volume_get_stage_paint_box (pv, CLUTTER_STAGE (stage), box);
+  *box = geometry->paint_box;
 
   return TRUE;
 }
@@ -17997,7 +18521,7 @@ clutter_actor_set_layout_manager (ClutterActor         *self,
 
   clutter_actor_queue_relayout (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_LAYOUT_MANAGER]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_LAYOUT_MANAGER]);
 }
 
 /**
@@ -18141,7 +18665,7 @@ clutter_actor_set_x_align (ClutterActor      *self,
 
       clutter_actor_queue_relayout (self);
 
-      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_X_ALIGN]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_X_ALIGN]);
     }
 }
 
@@ -18192,7 +18716,7 @@ clutter_actor_set_y_align (ClutterActor      *self,
 
       clutter_actor_queue_relayout (self);
 
-      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_Y_ALIGN]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_Y_ALIGN]);
     }
 }
 
@@ -18234,7 +18758,7 @@ clutter_actor_set_margin_internal (ClutterActor *self,
     info->margin.left = margin;
 
   clutter_actor_queue_relayout (self);
-  g_object_notify_by_pspec (G_OBJECT (self), pspec);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), pspec);
 }
 
 /**
@@ -18486,8 +19010,8 @@ clutter_actor_set_background_color_internal (ClutterActor *self,
 
   clutter_actor_queue_redraw (self);
 
-  g_object_notify_by_pspec (obj, obj_props[PROP_BACKGROUND_COLOR_SET]);
-  g_object_notify_by_pspec (obj, obj_props[PROP_BACKGROUND_COLOR]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_BACKGROUND_COLOR_SET]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_BACKGROUND_COLOR]);
 }
 
 /**
@@ -18526,7 +19050,7 @@ clutter_actor_set_background_color (ClutterActor       *self,
 
       clutter_actor_queue_redraw (self);
 
-      g_object_notify_by_pspec (obj, obj_props[PROP_BACKGROUND_COLOR_SET]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_BACKGROUND_COLOR_SET]);
     }
   else
     _clutter_actor_create_transition (self,
@@ -19787,7 +20311,7 @@ clutter_actor_set_content (ClutterActor   *self,
 
   clutter_actor_queue_redraw (self);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONTENT]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONTENT]);
 
   /* if the content gravity is not resize-fill, and the new content has a
    * different preferred size than the previous one, then the content box
@@ -19795,7 +20319,7 @@ clutter_actor_set_content (ClutterActor   *self,
    * here, and let whomever watches :content-box do whatever they need to
    * do.
    */
-  if (priv->content_gravity != CLUTTER_CONTENT_GRAVITY_RESIZE_FILL)
+  if (clutter_actor_get_content_info_or_defaults (self)->content_gravity != CLUTTER_CONTENT_GRAVITY_RESIZE_FILL)
     {
       if (priv->content_box_valid)
         {
@@ -19813,7 +20337,7 @@ clutter_actor_set_content (ClutterActor   *self,
                                               &to_box);
         }
 
-      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONTENT_BOX]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONTENT_BOX]);
    }
 }
 
@@ -19861,14 +20385,14 @@ clutter_actor_set_content_gravity (ClutterActor *self,
 
   priv = self->priv;
 
-  if (priv->content_gravity == gravity)
+  if (clutter_actor_get_content_info_or_defaults (self)->content_gravity == gravity)
     return;
 
   priv->content_box_valid = FALSE;
 
   clutter_actor_get_content_box (self, &from_box);
 
-  priv->content_gravity = gravity;
+  clutter_actor_get_content_info (self)->content_gravity = gravity;
 
   clutter_actor_get_content_box (self, &to_box);
 
@@ -19876,7 +20400,7 @@ clutter_actor_set_content_gravity (ClutterActor *self,
                                     &from_box,
                                     &to_box);
 
-  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONTENT_GRAVITY]);
+  clutter_actor_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CONTENT_GRAVITY]);
 }
 
 /**
@@ -19896,7 +20420,7 @@ clutter_actor_get_content_gravity (ClutterActor *self)
   g_return_val_if_fail (CLUTTER_IS_ACTOR (self),
                         CLUTTER_CONTENT_GRAVITY_RESIZE_FILL);
 
-  return self->priv->content_gravity;
+  return clutter_actor_get_content_info_or_defaults (self)->content_gravity;
 }
 
 /**
@@ -19926,6 +20450,7 @@ clutter_actor_get_content_box (ClutterActor    *self,
                                ClutterActorBox *box)
 {
   ClutterActorPrivate *priv;
+  const ClutterContentInfo *info;
   gfloat content_w, content_h;
   gfloat alloc_w, alloc_h;
 
@@ -19933,6 +20458,7 @@ clutter_actor_get_content_box (ClutterActor    *self,
   g_return_if_fail (box != NULL);
 
   priv = self->priv;
+  info = clutter_actor_get_content_info_or_defaults (self);
 
   box->x1 = 0.f;
   box->y1 = 0.f;
@@ -19941,12 +20467,12 @@ clutter_actor_get_content_box (ClutterActor    *self,
 
   if (priv->content_box_valid)
     {
-      *box = priv->content_box;
+      *box = info->content_box;
       return;
     }
 
   /* no need to do any more work */
-  if (priv->content_gravity == CLUTTER_CONTENT_GRAVITY_RESIZE_FILL)
+  if (info->content_gravity == CLUTTER_CONTENT_GRAVITY_RESIZE_FILL)
     return;
 
   if (priv->content == NULL)
@@ -19963,7 +20489,7 @@ clutter_actor_get_content_box (ClutterActor    *self,
   alloc_w = box->x2;
   alloc_h = box->y2;
 
-  switch (priv->content_gravity)
+  switch (info->content_gravity)
     {
     case CLUTTER_CONTENT_GRAVITY_TOP_LEFT:
       box->x2 = box->x1 + MIN (content_w, alloc_w);
@@ -20116,37 +20642,37 @@ clutter_actor_set_content_scaling_filters (ClutterActor         *self,
                                            ClutterScalingFilter  min_filter,
                                            ClutterScalingFilter  mag_filter)
 {
-  ClutterActorPrivate *priv;
-  gboolean changed;
+  const ClutterContentInfo *old_info;
+  ClutterContentInfo *info;
   GObject *obj;
 
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
-  priv = self->priv;
+  old_info = clutter_actor_get_content_info_or_defaults (self);
+  if (old_info->min_filter == min_filter &&
+      old_info->mag_filter == mag_filter)
+    return;
+
+  info = clutter_actor_get_content_info (self);
   obj = G_OBJECT (self);
 
   g_object_freeze_notify (obj);
 
-  changed = FALSE;
-
-  if (priv->min_filter != min_filter)
+  if (info->min_filter != min_filter)
     {
-      priv->min_filter = min_filter;
-      changed = TRUE;
+      info->min_filter = min_filter;
 
-      g_object_notify_by_pspec (obj, obj_props[PROP_MINIFICATION_FILTER]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_MINIFICATION_FILTER]);
     }
 
-  if (priv->mag_filter != mag_filter)
+  if (info->mag_filter != mag_filter)
     {
-      priv->mag_filter = mag_filter;
-      changed = TRUE;
+      info->mag_filter = mag_filter;
 
-      g_object_notify_by_pspec (obj, obj_props[PROP_MAGNIFICATION_FILTER]);
+      clutter_actor_notify_by_pspec (obj, obj_props[PROP_MAGNIFICATION_FILTER]);
     }
 
-  if (changed)
-    clutter_actor_queue_redraw (self);
+  clutter_actor_queue_redraw (self);
 
   g_object_thaw_notify (obj);
 }
@@ -20168,13 +20694,17 @@ clutter_actor_get_content_scaling_filters (ClutterActor         *self,
                                            ClutterScalingFilter *min_filter,
                                            ClutterScalingFilter *mag_filter)
 {
+  const ClutterContentInfo *info;
+
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
+  info = clutter_actor_get_content_info_or_defaults (self);
+
   if (min_filter != NULL)
-    *min_filter = self->priv->min_filter;
+    *min_filter = info->min_filter;
 
   if (mag_filter != NULL)
-    *mag_filter = self->priv->mag_filter;
+    *mag_filter = info->mag_filter;
 }
 
 /*
@@ -20246,8 +20776,8 @@ clutter_actor_set_x_expand (ClutterActor *self,
 
       clutter_actor_queue_compute_expand (self);
 
-      g_object_notify_by_pspec (G_OBJECT (self),
-                                obj_props[PROP_X_EXPAND]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self),
+                                     obj_props[PROP_X_EXPAND]);
     }
 }
 
@@ -20305,8 +20835,8 @@ clutter_actor_set_y_expand (ClutterActor *self,
 
       clutter_actor_queue_compute_expand (self);
 
-      g_object_notify_by_pspec (G_OBJECT (self),
-                                obj_props[PROP_Y_EXPAND]);
+      clutter_actor_notify_by_pspec (G_OBJECT (self),
+                                     obj_props[PROP_Y_EXPAND]);
     }
 }
 
@@ -20465,10 +20995,10 @@ clutter_actor_set_content_repeat (ClutterActor         *self,
 {
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
-  if (self->priv->content_repeat == repeat)
+  if (clutter_actor_get_content_info_or_defaults (self)->content_repeat == repeat)
     return;
 
-  self->priv->content_repeat = repeat;
+  clutter_actor_get_content_info (self)->content_repeat = repeat;
 
   clutter_actor_queue_redraw (self);
 }
@@ -20489,7 +21019,7 @@ clutter_actor_get_content_repeat (ClutterActor *self)
 {
   g_return_val_if_fail (CLUTTER_IS_ACTOR (self), CLUTTER_REPEAT_NONE);
 
-  return self->priv->content_repeat;
+  return clutter_actor_get_content_info_or_defaults (self)->content_repeat;
 }
 
 void
@@ -20562,15 +21092,15 @@ clutter_actor_set_child_transform_internal (ClutterActor        *self,
   /* we need to reset the transform_valid flag on each child */
   clutter_actor_iter_init (&iter, self);
   while (clutter_actor_iter_next (&iter, &child))
-    child->priv->transform_valid = FALSE;
+    clutter_actor_invalidate_transform (child);
 
   clutter_actor_queue_redraw (self);
 
   obj = G_OBJECT (self);
-  g_object_notify_by_pspec (obj, obj_props[PROP_CHILD_TRANSFORM]);
+  clutter_actor_notify_by_pspec (obj, obj_props[PROP_CHILD_TRANSFORM]);
 
   if (was_set != info->child_transform_set)
-    g_object_notify_by_pspec (obj, obj_props[PROP_CHILD_TRANSFORM_SET]);
+    clutter_actor_notify_by_pspec (obj, obj_props[PROP_CHILD_TRANSFORM_SET]);
 }
 
 /**
@@ -20792,6 +21322,178 @@ _clutter_actor_get_active_framebuffer (ClutterActor *self)
   return _clutter_stage_get_active_framebuffer (stage);
 }
 
+/* The time, in microseconds, that can be spent creating the children
+ * of an actor bound to a model in a single frame
+ */
+#define CHILD_MODEL_FRAME_BUDGET        (4 * 1000)
+
+static ClutterActor *
+clutter_actor_child_model_create_child (ClutterActor *self,
+                                        guint         position)
+{
+  ClutterChildModelInfo *info = self->priv->model_info;
+  ClutterActor *child;
+  GObject *item;
+
+  item = g_list_model_get_item (info->child_model, position);
+  child = info->create_child_func (item, info->create_child_data);
+
+  /* The actor returned by the function can have a floating reference,
+   * if the implementation is in pure C, or have a full reference, usually
+   * the case for language bindings. To avoid leaking references, we
+   * try to assume ownership of the instance, and release the reference
+   * at the end unconditionally, leaving the only reference to the actor
+   * itself.
+   */
+  if (g_object_is_floating (child))
+    g_object_ref_sink (child);
+
+  g_object_unref (item);
+
+  return child;
+}
+
+/*< private >
+ * clutter_actor_child_model_add_children:
+ * @self: a #ClutterActor bound to a model
+ * @position: the position of the first item to add
+ * @n_items: the number of items to add
+ * @deadline: the monotonic time after which no more children are
+ *   created, or 0 to add all the items
+ *
+ * Creates the children for @n_items items of the model, starting at
+ * @position, and adds them to @self as a single batch: the sibling
+ * at @position is found only once, and the notifications on @self
+ * are frozen until all the children have been added.
+ *
+ * Return value: the number of children that have been added
+ */
+static guint
+clutter_actor_child_model_add_children (ClutterActor *self,
+                                        guint         position,
+                                        guint         n_items,
+                                        gint64        deadline)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActor *sibling;
+  guint i;
+
+  if (n_items == 0)
+    return 0;
+
+  if (position == 0)
+    sibling = NULL;
+  else if (position == priv->n_children)
+    sibling = priv->last_child;
+  else
+    sibling = clutter_actor_get_child_at_index (self, position - 1);
+
+  g_object_freeze_notify (G_OBJECT (self));
+
+  for (i = 0; i < n_items; i++)
+    {
+      ClutterActor *child;
+
+      child = clutter_actor_child_model_create_child (self, position + i);
+
+      if (sibling == NULL)
+        clutter_actor_add_child_internal (self, child,
+                                          ADD_CHILD_DEFAULT_FLAGS,
+                                          insert_child_below,
+                                          NULL);
+      else
+        clutter_actor_add_child_internal (self, child,
+                                          ADD_CHILD_DEFAULT_FLAGS,
+                                          insert_child_above,
+                                          sibling);
+
+      sibling = child;
+
+      g_object_unref (child);
+
+      /* always make progress, even if we are already over budget */
+      if (deadline > 0 && g_get_monotonic_time () >= deadline)
+        {
+          i += 1;
+          break;
+        }
+    }
+
+  g_object_thaw_notify (G_OBJECT (self));
+
+  return i;
+}
+
+/*< private >
+ * clutter_actor_child_model_create_pending:
+ * @self: a #ClutterActor bound to a model
+ *
+ * Creates the children for the items of the model that do not have
+ * one yet, until the per-frame budget is exhausted.
+ *
+ * Return value: %TRUE if there are still items without a child
+ */
+static gboolean
+clutter_actor_child_model_create_pending (ClutterActor *self)
+{
+  ClutterChildModelInfo *info = self->priv->model_info;
+  guint n_items;
+
+  n_items = g_list_model_get_n_items (info->child_model);
+  if (info->n_created < n_items)
+    {
+      gint64 deadline = g_get_monotonic_time () + CHILD_MODEL_FRAME_BUDGET;
+
+      info->n_created +=
+        clutter_actor_child_model_add_children (self,
+                                                info->n_created,
+                                                n_items - info->n_created,
+                                                deadline);
+    }
+
+  return info->n_created < n_items;
+}
+
+static gboolean
+clutter_actor_child_model_create_func (gpointer data)
+{
+  ClutterActor *self = data;
+  ClutterChildModelInfo *info = self->priv->model_info;
+
+  /* the binding was removed while we were being invoked */
+  if (info == NULL)
+    return FALSE;
+
+  if (clutter_actor_child_model_create_pending (self))
+    {
+      _clutter_master_clock_ensure_next_iteration (_clutter_master_clock_get_default ());
+      return TRUE;
+    }
+
+  info->create_id = 0;
+
+  return FALSE;
+}
+
+static void
+clutter_actor_child_model_schedule_create (ClutterActor *self)
+{
+  ClutterChildModelInfo *info = self->priv->model_info;
+
+  if (info->create_id != 0)
+    return;
+
+  if (info->n_created == g_list_model_get_n_items (info->child_model))
+    return;
+
+  info->create_id =
+    clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_PRE_PAINT |
+                                           CLUTTER_REPAINT_FLAGS_QUEUE_REDRAW_ON_ADD,
+                                           clutter_actor_child_model_create_func,
+                                           g_object_ref (self),
+                                           g_object_unref);
+}
+
 static void
 clutter_actor_child_model__items_changed (GListModel *model,
                                           guint       position,
@@ -20800,35 +21502,63 @@ clutter_actor_child_model__items_changed (GListModel *model,
                                           gpointer    user_data)
 {
   ClutterActor *parent = user_data;
-  ClutterActorPrivate *priv = parent->priv;
-  guint i;
-
-  while (removed--)
+  ClutterChildModelInfo *info = parent->priv->model_info;
+
+  /* the items past the last child we created will be picked up by
+   * the time-sliced creation; if the change affects the children we
+   * already created, we replace only the children of the removed
+   * items, and add the children of the new items as a single batch,
+   * so that the view never loses the children that did not change;
+   * the relayout queued by each child is coalesced with the others
+   */
+  if (position < info->n_created)
     {
-      ClutterActor *child = clutter_actor_get_child_at_index (parent, position);
-      clutter_actor_destroy (child);
-    }
+      ClutterActor *child;
+      guint n_removed, i;
 
-  for (i = 0; i < added; i++)
-    {
-      GObject *item = g_list_model_get_item (model, position + i);
-      ClutterActor *child = priv->create_child_func (item, priv->create_child_data);
+      n_removed = MIN (removed, info->n_created - position);
 
-      /* The actor returned by the function can have a floating reference,
-       * if the implementation is in pure C, or have a full reference, usually
-       * the case for language bindings. To avoid leaking references, we
-       * try to assume ownership of the instance, and release the reference
-       * at the end unconditionally, leaving the only reference to the actor
-       * itself.
-       */
-      if (g_object_is_floating (child))
-        g_object_ref_sink (child);
+      child = clutter_actor_get_child_at_index (parent, position);
+      for (i = 0; i < n_removed && child != NULL; i++)
+        {
+          ClutterActor *next = child->priv->next_sibling;
 
-      clutter_actor_insert_child_at_index (parent, child, position + i);
+          clutter_actor_destroy (child);
 
-      g_object_unref (child);
-      g_object_unref (item);
+          child = next;
+        }
+
+      info->n_created -= n_removed;
+      info->n_created +=
+        clutter_actor_child_model_add_children (parent, position, added, 0);
     }
+
+  clutter_actor_child_model_schedule_create (parent);
+}
+
+static void
+clutter_actor_unbind_child_model (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterChildModelInfo *info = priv->model_info;
+
+  if (info == NULL)
+    return;
+
+  priv->model_info = NULL;
+
+  if (info->create_id != 0)
+    clutter_threads_remove_repaint_func (info->create_id);
+
+  if (info->create_child_notify != NULL)
+    info->create_child_notify (info->create_child_data);
+
+  g_signal_handlers_disconnect_by_func (info->child_model,
+                                        clutter_actor_child_model__items_changed,
+                                        self);
+  g_object_unref (info->child_model);
+
+  g_slice_free (ClutterChildModelInfo, info);
 }
 
 /**
@@ -20850,6 +21580,19 @@ clutter_actor_child_model__items_changed (GListModel *model,
  * of the @model. The #ClutterActor is updated whenever the @model changes.
  * If @model is %NULL, the #ClutterActor is left empty.
  *
+ * In order to keep the main loop responsive with large models, the
+ * children are created in batches, spread over multiple frames: when
+ * this function returns, only the children for the first items of the
+ * @model have been created, as many as fit in the time budget of a
+ * frame; the remaining ones are appended at the beginning of the
+ * following frames, until each item of the @model has a corresponding
+ * child. Use clutter_actor_get_n_children() to know how many children
+ * have been created so far.
+ *
+ * Changes to items of the @model that already have a child are applied
+ * immediately: only the children of the removed items are destroyed,
+ * and the children of the added items are created in the same call.
+ *
  * When a #ClutterActor is bound to a model, adding and removing children
  * directly is undefined behaviour.
  *
@@ -20862,87 +21605,263 @@ clutter_actor_bind_model (ClutterActor                *self,
                           gpointer                     user_data,
                           GDestroyNotify               notify)
 {
-  ClutterActorPrivate *priv = clutter_actor_get_instance_private (self);
+  ClutterChildModelInfo *info;
 
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
   g_return_if_fail (model == NULL || G_IS_LIST_MODEL (model));
   g_return_if_fail (model == NULL || create_child_func != NULL);
 
-  if (priv->child_model != NULL)
-    {
-      if (priv->create_child_notify != NULL)
-        priv->create_child_notify (priv->create_child_data);
-
-      g_signal_handlers_disconnect_by_func (priv->child_model,
-                                            clutter_actor_child_model__items_changed,
-                                            self);
-      g_clear_object (&priv->child_model);
-      priv->create_child_func = NULL;
-      priv->create_child_data = NULL;
-      priv->create_child_notify = NULL;
-    }
+  clutter_actor_unbind_child_model (self);
 
   clutter_actor_destroy_all_children (self);
 
   if (model == NULL)
     return;
 
-  priv->child_model = g_object_ref (model);
-  priv->create_child_func = create_child_func;
-  priv->create_child_data = user_data;
-  priv->create_child_notify = notify;
+  info = g_slice_new0 (ClutterChildModelInfo);
+  info->child_model = g_object_ref (model);
+  info->create_child_func = create_child_func;
+  info->create_child_data = user_data;
+  info->create_child_notify = notify;
 
-  g_signal_connect (priv->child_model, "items-changed",
+  self->priv->model_info = info;
+
+  g_signal_connect (info->child_model, "items-changed",
                     G_CALLBACK (clutter_actor_child_model__items_changed),
                     self);
 
-  clutter_actor_child_model__items_changed (priv->child_model,
-                                            0,
-                                            0,
-                                            g_list_model_get_n_items (priv->child_model),
-                                            self);
+  if (clutter_actor_child_model_create_pending (self))
+    clutter_actor_child_model_schedule_create (self);
 }
 
 typedef struct {
+  volatile int ref_count;
+
   GType child_type;
+  GObjectClass *child_class;
   GArray *props;
 } BindClosure;
 
 typedef struct {
+  /* canonical, interned name, so it can be compared with the
+   * name of the GParamSpec passed to the ::notify signal
+   */
   const char *model_property;
-  const char *child_property;
+  GParamSpec *child_pspec;
   GBindingFlags flags;
+
+  /* the detailed ::notify signals for the two properties */
+  char *model_notify;
+  char *child_notify;
 } BindProperty;
 
+typedef struct {
+  BindClosure *clos;
+
+  GObject *item;
+
+  /* unowned; the BindChild is owned by the child itself */
+  GObject *child;
+
+  /* guards against the two sides of a bidirectional binding
+   * updating each other forever
+   */
+  gboolean in_sync;
+} BindChild;
+
+static BindClosure *
+bind_closure_ref (BindClosure *data)
+{
+  g_atomic_int_inc (&data->ref_count);
+
+  return data;
+}
+
 static void
-bind_closure_free (gpointer data_)
+bind_closure_unref (gpointer data_)
 {
   BindClosure *data = data_;
+  guint i;
 
   if (data == NULL)
     return;
 
+  if (!g_atomic_int_dec_and_test (&data->ref_count))
+    return;
+
+  for (i = 0; i < data->props->len; i++)
+    {
+      BindProperty *prop = &g_array_index (data->props, BindProperty, i);
+
+      g_free (prop->model_notify);
+      g_free (prop->child_notify);
+    }
+
   g_array_unref (data->props);
+  g_type_class_unref (data->child_class);
   g_slice_free (BindClosure, data);
 }
 
+static void
+bind_property_sync (GObject    *source,
+                    GParamSpec *source_pspec,
+                    GObject    *target,
+                    GParamSpec *target_pspec,
+                    gboolean    invert_boolean)
+{
+  GValue source_value = G_VALUE_INIT;
+  GValue target_value = G_VALUE_INIT;
+
+  g_value_init (&source_value, G_PARAM_SPEC_VALUE_TYPE (source_pspec));
+  g_object_get_property (source, source_pspec->name, &source_value);
+
+  if (invert_boolean && G_VALUE_HOLDS_BOOLEAN (&source_value))
+    g_value_set_boolean (&source_value, !g_value_get_boolean (&source_value));
+
+  g_value_init (&target_value, G_PARAM_SPEC_VALUE_TYPE (target_pspec));
+  if (g_value_transform (&source_value, &target_value))
+    g_object_set_property (target, target_pspec->name, &target_value);
+
+  g_value_unset (&source_value);
+  g_value_unset (&target_value);
+}
+
+static void
+bind_child_item_notify (GObject    *item,
+                        GParamSpec *pspec,
+                        gpointer    user_data)
+{
+  BindChild *data = user_data;
+  guint i;
+
+  if (data->in_sync)
+    return;
+
+  for (i = 0; i < data->clos->props->len; i++)
+    {
+      const BindProperty *prop = &g_array_index (data->clos->props, BindProperty, i);
+
+      if (prop->model_property != pspec->name)
+        continue;
+
+      data->in_sync = TRUE;
+      bind_property_sync (item, pspec, data->child, prop->child_pspec,
+                          (prop->flags & G_BINDING_INVERT_BOOLEAN) != 0);
+      data->in_sync = FALSE;
+    }
+}
+
+static void
+bind_child_child_notify (GObject    *child,
+                         GParamSpec *pspec,
+                         gpointer    user_data)
+{
+  BindChild *data = user_data;
+  guint i;
+
+  if (data->in_sync)
+    return;
+
+  for (i = 0; i < data->clos->props->len; i++)
+    {
+      const BindProperty *prop = &g_array_index (data->clos->props, BindProperty, i);
+      GParamSpec *model_pspec;
+
+      if ((prop->flags & G_BINDING_BIDIRECTIONAL) == 0)
+        continue;
+
+      if (prop->child_pspec != pspec)
+        continue;
+
+      model_pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (data->item),
+                                                  prop->model_property);
+      if (model_pspec == NULL)
+        continue;
+
+      data->in_sync = TRUE;
+      bind_property_sync (child, pspec, data->item, model_pspec,
+                          (prop->flags & G_BINDING_INVERT_BOOLEAN) != 0);
+      data->in_sync = FALSE;
+    }
+}
+
+static void
+bind_child_free (gpointer data_)
+{
+  BindChild *data = data_;
+
+  g_signal_handlers_disconnect_by_func (data->item,
+                                        bind_child_item_notify,
+                                        data);
+  g_object_unref (data->item);
+
+  bind_closure_unref (data->clos);
+
+  g_slice_free (BindChild, data);
+}
+
 static ClutterActor *
 bind_child_with_properties (gpointer item,
                             gpointer data_)
 {
-  BindClosure *data = data_;
+  BindClosure *clos = data_;
+  GObjectClass *item_class = G_OBJECT_GET_CLASS (item);
   ClutterActor *res;
+  BindChild *data;
   guint i;
 
-  res = g_object_new (data->child_type, NULL);
+  res = g_object_new (clos->child_type, NULL);
 
-  for (i = 0; i < data->props->len; i++)
+  /* instead of using a GBinding for each property of each child, we use
+   * a ::notify handler for each bound property of the item, and one for
+   * each bidirectional property of the child, which are dropped with the
+   * child
+   */
+  data = g_slice_new0 (BindChild);
+  data->clos = bind_closure_ref (clos);
+  data->item = g_object_ref (item);
+  data->child = G_OBJECT (res);
+
+  g_object_set_qdata_full (G_OBJECT (res), quark_bind_child, data, bind_child_free);
+
+  for (i = 0; i < clos->props->len; i++)
+    {
+      const BindProperty *prop = &g_array_index (clos->props, BindProperty, i);
+      GParamSpec *model_pspec;
+
+      if ((prop->flags & G_BINDING_SYNC_CREATE) == 0)
+        continue;
+
+      model_pspec = g_object_class_find_property (item_class, prop->model_property);
+      if (model_pspec == NULL)
+        {
+          g_critical ("%s: The source object of type %s has no property "
+                      "called '%s'",
+                      G_STRLOC,
+                      G_OBJECT_TYPE_NAME (item),
+                      prop->model_property);
+          continue;
+        }
+
+      bind_property_sync (item, model_pspec,
+                          G_OBJECT (res), prop->child_pspec,
+                          (prop->flags & G_BINDING_INVERT_BOOLEAN) != 0);
+    }
+
+  for (i = 0; i < clos->props->len; i++)
     {
-      const BindProperty *prop = &g_array_index (data->props, BindProperty, i);
+      const BindProperty *prop = &g_array_index (clos->props, BindProperty, i);
 
-      g_object_bind_property (item, prop->model_property,
-                              res, prop->child_property,
-                              prop->flags);
+      /* the handlers go through all the bindings of a property */
+      if (prop->model_notify != NULL)
+        g_signal_connect (item, prop->model_notify,
+                          G_CALLBACK (bind_child_item_notify),
+                          data);
+
+      if (prop->child_notify != NULL)
+        g_signal_connect (res, prop->child_notify,
+                          G_CALLBACK (bind_child_child_notify),
+                          data);
     }
 
   return res;
@@ -20975,7 +21894,7 @@ bind_child_with_properties (gpointer item,
  *                                             NULL);
  * ]|
  *
- * is the equivalent of calling clutter_actor_bind_model() with a
+ * is functionally equivalent to calling clutter_actor_bind_model() with a
  * #ClutterActorCreateChildFunc of:
  *
  * |[<!-- language="C" -->
@@ -20989,6 +21908,10 @@ bind_child_with_properties (gpointer item,
  *   return res;
  * ]|
  *
+ * though no #GBinding instance is created for each property of each
+ * child; the properties are kept in sync using a handler for the
+ * #GObject::notify signal of each bound property.
+ *
  * If the #ClutterActor was already bound to a #GListModel, the previous
  * binding is destroyed.
  *
@@ -21015,7 +21938,9 @@ clutter_actor_bind_model_with_properties (ClutterActor *self,
   g_return_if_fail (g_type_is_a (child_type, CLUTTER_TYPE_ACTOR));
 
   clos = g_slice_new0 (BindClosure);
+  clos->ref_count = 1;
   clos->child_type = child_type;
+  clos->child_class = g_type_class_ref (child_type);
   clos->props = g_array_new (FALSE, FALSE, sizeof (BindProperty));
 
   va_start (args, first_model_property);
@@ -21025,17 +21950,53 @@ clutter_actor_bind_model_with_properties (ClutterActor *self,
       const char *child_property = va_arg (args, char *);
       GBindingFlags binding_flags = va_arg (args, guint);
       BindProperty bind;
+      char *canonical;
+      guint i;
+
+      bind.child_pspec = g_object_class_find_property (clos->child_class,
+                                                       child_property);
+      if (bind.child_pspec == NULL)
+        {
+          g_critical ("%s: The child type %s has no property called '%s'",
+                      G_STRLOC,
+                      g_type_name (child_type),
+                      child_property);
+          model_property = va_arg (args, char *);
+          continue;
+        }
 
-      bind.model_property = g_intern_string (model_property);
-      bind.child_property = g_intern_string (child_property);
+      canonical = g_strdelimit (g_strdup (model_property), "_", '-');
+      bind.model_property = g_intern_string (canonical);
       bind.flags = binding_flags;
+      bind.model_notify = g_strconcat ("notify::", canonical, NULL);
+      bind.child_notify = NULL;
+      g_free (canonical);
+
+      if ((binding_flags & G_BINDING_BIDIRECTIONAL) != 0)
+        bind.child_notify = g_strconcat ("notify::", bind.child_pspec->name, NULL);
+
+      /* connect only once to each property, as the handlers update
+       * all the bindings of the property that notified
+       */
+      for (i = 0; i < clos->props->len; i++)
+        {
+          BindProperty *other = &g_array_index (clos->props, BindProperty, i);
+
+          if (other->model_property == bind.model_property)
+            g_clear_pointer (&bind.model_notify, g_free);
+
+          if (other->child_pspec == bind.child_pspec &&
+              other->child_notify != NULL)
+            g_clear_pointer (&bind.child_notify, g_free);
+        }
 
       g_array_append_val (clos->props, bind);
 
       model_property = va_arg (args, char *);
     }
+  va_end (args);
 
-  clutter_actor_bind_model (self, model, bind_child_with_properties, clos, bind_closure_free);
+  clutter_actor_bind_model (self, model, bind_child_with_properties, clos, bind_closure_unref);
 }
 
 /*< private >
@@ -21060,7 +22021,7 @@ ClutterPaintNode *
 clutter_actor_create_texture_paint_node (ClutterActor *self,
                                          CoglTexture  *texture)
 {
-  ClutterActorPrivate *priv = clutter_actor_get_instance_private (self);
+  const ClutterContentInfo *info;
   ClutterPaintNode *node;
   ClutterActorBox box;
   ClutterColor color;
@@ -21068,6 +22029,8 @@ clutter_actor_create_texture_paint_node (ClutterActor *self,
   g_return_val_if_fail (CLUTTER_IS_ACTOR (self), NULL);
   g_return_val_if_fail (texture != NULL, NULL);
 
+  info = clutter_actor_get_content_info_or_defaults (self);
+
   clutter_actor_get_content_box (self, &box);
 
   /* ClutterTextureNode will premultiply the blend color, so we
@@ -21078,19 +22041,19 @@ clutter_actor_create_texture_paint_node (ClutterActor *self,
   color.blue = 255;
   color.alpha = clutter_actor_get_paint_opacity_internal (self);
 
-  node = clutter_texture_node_new (texture, &color, priv->min_filter, priv->mag_filter);
+  node = clutter_texture_node_new (texture, &color, info->min_filter, info->mag_filter);
   clutter_paint_node_set_name (node, "Texture");
 
-  if (priv->content_repeat == CLUTTER_REPEAT_NONE)
+  if (info->content_repeat == CLUTTER_REPEAT_NONE)
     clutter_paint_node_add_rectangle (node, &box);
   else
     {
       float t_w = 1.f, t_h = 1.f;
 
-      if ((priv->content_repeat & CLUTTER_REPEAT_X_AXIS) != FALSE)
+      if ((info->content_repeat & CLUTTER_REPEAT_X_AXIS) != FALSE)
         t_w = (box.x2 - box.x1) / cogl_texture_get_width (texture);
 
-      if ((priv->content_repeat & CLUTTER_REPEAT_Y_AXIS) != FALSE)
+      if ((info->content_repeat & CLUTTER_REPEAT_Y_AXIS) != FALSE)
         t_h = (box.y2 - box.y1) / cogl_texture_get_height (texture);
 
       clutter_paint_node_add_texture_rectangle (node, &box,
@@ -21100,3 +22063,19 @@ clutter_actor_create_texture_paint_node (ClutterActor *self,
 
   return node;
 }
+
+/*< private >
+ * _clutter_actor_get_children_age:
+ * @self: a #ClutterActor
+ *
+ * Retrieves a serial that changes every time a child is added to, or
+ * removed from @self, including when changing the paint order of the
+ * children.
+ *
+ * Return value: the age of the list of children
+ */
+gint
+_clutter_actor_get_children_age (ClutterActor *self)
+{
+  return self->priv->age;
+}
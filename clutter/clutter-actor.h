@@ -361,6 +361,8 @@ CLUTTER_AVAILABLE_IN_ALL
 void                            clutter_actor_queue_relayout                    (ClutterActor                *self);
 CLUTTER_AVAILABLE_IN_ALL
 void                            clutter_actor_destroy                           (ClutterActor                *self);
+CLUTTER_AVAILABLE_IN_1_26
+void                            clutter_actor_destroy_deferred                  (ClutterActor                *self);
 CLUTTER_AVAILABLE_IN_ALL
 void                            clutter_actor_set_name                          (ClutterActor                *self,
                                                                                  const gchar                 *name);
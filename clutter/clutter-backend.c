@@ -95,6 +95,9 @@
 #ifdef CLUTTER_INPUT_MIR
 #include "mir/clutter-device-manager-mir.h"
 #endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+#include "headless/clutter-backend-headless.h"
+#endif
 
 #ifdef CLUTTER_HAS_WAYLAND_COMPOSITOR_SUPPORT
 #include <cogl/cogl-wayland-server.h>
@@ -556,6 +559,12 @@ static const struct {
 #endif
 #ifdef CLUTTER_WINDOWING_MIR
   { CLUTTER_WINDOWING_MIR, clutter_backend_mir_new },
+#endif
+  /* keep the headless backend last, so that it is never picked
+   * over a real windowing system unless explicitly requested
+   */
+#ifdef CLUTTER_WINDOWING_HEADLESS
+  { CLUTTER_WINDOWING_HEADLESS, clutter_backend_headless_new },
 #endif
   { NULL, NULL },
 };
@@ -116,6 +116,7 @@
                                   CLUTTER_META_MASK)   | CLUTTER_RELEASE_MASK)
 
 typedef struct _ClutterBindingEntry     ClutterBindingEntry;
+typedef struct _ClutterBindingKey       ClutterBindingKey;
 
 static GSList *clutter_binding_pools = NULL;
 static GQuark  key_class_bindings = 0;
@@ -127,7 +128,9 @@ struct _ClutterBindingPool
   gchar *name; /* interned string, do not free */
 
   GSList *entries;
-  GHashTable *entries_hash;
+
+  /* ClutterBindingKey, sorted by key symbol and modifiers */
+  GArray *table;
 };
 
 struct _ClutterBindingPoolClass
@@ -144,9 +147,26 @@ struct _ClutterBindingEntry
 
   GClosure *closure;
 
+  /* set if the closure wraps a ClutterBindingActionFunc, which we
+   * can call directly without marshalling the arguments
+   */
+  ClutterBindingActionFunc callback;
+  gpointer user_data;
+
   guint is_blocked  : 1;
 };
 
+/* The keys are stored inline in the lookup table of the pool, so that
+ * looking up a key press only touches the entry that matches
+ */
+struct _ClutterBindingKey
+{
+  guint key_val;
+  ClutterModifierType modifiers;
+
+  ClutterBindingEntry *entry;
+};
+
 enum
 {
   PROP_0,
@@ -160,28 +180,6 @@ static GParamSpec *obj_props[PROP_LAST];
 
 G_DEFINE_TYPE (ClutterBindingPool, clutter_binding_pool, G_TYPE_OBJECT);
 
-static guint
-binding_entry_hash (gconstpointer v)
-{
-  const ClutterBindingEntry *e = v;
-  guint h;
-
-  h = e->key_val;
-  h ^= e->modifiers;
-
-  return h;
-}
-
-static gint
-binding_entry_compare (gconstpointer v1,
-                       gconstpointer v2)
-{
-  const ClutterBindingEntry *e1 = v1;
-  const ClutterBindingEntry *e2 = v2;
-
-  return (e1->key_val == e2->key_val && e1->modifiers == e2->modifiers);
-}
-
 static ClutterBindingEntry *
 binding_entry_new (const gchar         *name,
                    guint                key_val,
@@ -196,22 +194,74 @@ binding_entry_new (const gchar         *name,
   entry->modifiers = modifiers;
   entry->name = (gchar *) g_intern_string (name);
   entry->closure = NULL;
+  entry->callback = NULL;
+  entry->user_data = NULL;
   entry->is_blocked = FALSE;
 
   return entry;
 }
 
+/* Returns whether the table of @pool contains the given key, and the
+ * position of the key in the table, or the position at which it should
+ * be inserted
+ */
+static gboolean
+binding_pool_find_key (ClutterBindingPool  *pool,
+                       guint                key_val,
+                       ClutterModifierType  modifiers,
+                       guint               *index_)
+{
+  const ClutterBindingKey *keys = (const ClutterBindingKey *) pool->table->data;
+  guint lo = 0, hi = pool->table->len;
+
+  while (lo < hi)
+    {
+      guint mid = lo + (hi - lo) / 2;
+
+      if (keys[mid].key_val < key_val ||
+          (keys[mid].key_val == key_val && keys[mid].modifiers < modifiers))
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+  *index_ = lo;
+
+  return lo < pool->table->len &&
+         keys[lo].key_val == key_val &&
+         keys[lo].modifiers == modifiers;
+}
+
 static ClutterBindingEntry *
 binding_pool_lookup_entry (ClutterBindingPool  *pool,
                            guint                key_val,
                            ClutterModifierType  modifiers)
 {
-  ClutterBindingEntry lookup_entry = { 0, };
+  guint index_;
+
+  modifiers = modifiers & BINDING_MOD_MASK;
+
+  if (!binding_pool_find_key (pool, key_val, modifiers, &index_))
+    return NULL;
+
+  return g_array_index (pool->table, ClutterBindingKey, index_).entry;
+}
+
+static void
+binding_pool_add_entry (ClutterBindingPool  *pool,
+                        ClutterBindingEntry *entry)
+{
+  ClutterBindingKey key;
+  guint index_;
 
-  lookup_entry.key_val = key_val;
-  lookup_entry.modifiers = modifiers;
+  binding_pool_find_key (pool, entry->key_val, entry->modifiers, &index_);
 
-  return g_hash_table_lookup (pool->entries_hash, &lookup_entry);
+  key.key_val = entry->key_val;
+  key.modifiers = entry->modifiers;
+  key.entry = entry;
+  g_array_insert_val (pool->table, index_, key);
+
+  pool->entries = g_slist_prepend (pool->entries, entry);
 }
 
 static void
@@ -235,7 +285,7 @@ clutter_binding_pool_finalize (GObject *gobject)
   /* remove from the pools */
   clutter_binding_pools = g_slist_remove (clutter_binding_pools, pool);
 
-  g_hash_table_destroy (pool->entries_hash);
+  g_array_unref (pool->table);
 
   g_slist_foreach (pool->entries, (GFunc) binding_entry_free, NULL);
   g_slist_free (pool->entries);
@@ -331,8 +381,7 @@ clutter_binding_pool_init (ClutterBindingPool *pool)
 {
   pool->name = NULL;
   pool->entries = NULL;
-  pool->entries_hash = g_hash_table_new (binding_entry_hash,
-                                         binding_entry_compare);
+  pool->table = g_array_new (FALSE, FALSE, sizeof (ClutterBindingKey));
 
   clutter_binding_pools = g_slist_prepend (clutter_binding_pools, pool);
 }
@@ -513,8 +562,11 @@ clutter_binding_pool_install_action (ClutterBindingPool  *pool,
       g_closure_set_marshal (closure, marshal);
     }
 
-  pool->entries = g_slist_prepend (pool->entries, entry);
-  g_hash_table_insert (pool->entries_hash, entry, entry);
+  /* the closure is kept to notify @data when the entry goes away */
+  entry->callback = (ClutterBindingActionFunc) callback;
+  entry->user_data = data;
+
+  binding_pool_add_entry (pool, entry);
 }
 
 /**
@@ -579,8 +631,7 @@ clutter_binding_pool_install_closure (ClutterBindingPool  *pool,
       g_closure_set_marshal (closure, marshal);
     }
 
-  pool->entries = g_slist_prepend (pool->entries, entry);
-  g_hash_table_insert (pool->entries_hash, entry, entry);
+  binding_pool_add_entry (pool, entry);
 }
 
 /**
@@ -646,6 +697,9 @@ clutter_binding_pool_override_action (ClutterBindingPool  *pool,
       marshal = _clutter_marshal_BOOLEAN__STRING_UINT_FLAGS;
       g_closure_set_marshal (closure, marshal);
     }
+
+  entry->callback = (ClutterBindingActionFunc) callback;
+  entry->user_data = data;
 }
 
 /**
@@ -706,6 +760,9 @@ clutter_binding_pool_override_closure (ClutterBindingPool  *pool,
       marshal = _clutter_marshal_BOOLEAN__STRING_UINT_FLAGS;
       g_closure_set_marshal (closure, marshal);
     }
+
+  entry->callback = NULL;
+  entry->user_data = NULL;
 }
 
 /**
@@ -756,30 +813,23 @@ clutter_binding_pool_remove_action (ClutterBindingPool  *pool,
                                     guint                key_val,
                                     ClutterModifierType  modifiers)
 {
-  ClutterBindingEntry remove_entry = { 0, };
-  GSList *l;
+  ClutterBindingEntry *entry;
+  guint index_;
 
   g_return_if_fail (pool != NULL);
   g_return_if_fail (key_val != 0);
 
   modifiers = modifiers & BINDING_MOD_MASK;
 
-  remove_entry.key_val = key_val;
-  remove_entry.modifiers = modifiers;
+  if (!binding_pool_find_key (pool, key_val, modifiers, &index_))
+    return;
 
-  for (l = pool->entries; l != NULL; l = l->data)
-    {
-      ClutterBindingEntry *e = l->data;
-
-      if (e->key_val == remove_entry.key_val &&
-          e->modifiers == remove_entry.modifiers)
-        {
-          pool->entries = g_slist_remove_link (pool->entries, l);
-          break;
-        }
-    }
+  entry = g_array_index (pool->table, ClutterBindingKey, index_).entry;
+
+  g_array_remove_index (pool->table, index_);
+  pool->entries = g_slist_remove (pool->entries, entry);
 
-  g_hash_table_remove (pool->entries_hash, &remove_entry);
+  binding_entry_free (entry);
 }
 
 static gboolean
@@ -795,6 +845,13 @@ clutter_binding_entry_invoke (ClutterBindingEntry *entry,
   GValue result = G_VALUE_INIT;
   gboolean retval = TRUE;
 
+  if (entry->callback != NULL)
+    return entry->callback (gobject,
+                            entry->name,
+                            entry->key_val,
+                            entry->modifiers,
+                            entry->user_data);
+
   g_value_init (&params[0], G_TYPE_OBJECT);
   g_value_set_object (&params[0], gobject);
 
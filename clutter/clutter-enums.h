@@ -724,6 +724,12 @@ typedef enum { /*< prefix=CLUTTER_DRAG >*/
  * ClutterEventFlags:
  * @CLUTTER_EVENT_NONE: No flag set
  * @CLUTTER_EVENT_FLAG_SYNTHETIC: Synthetic event
+ * @CLUTTER_EVENT_FLAG_RAW: Motion event generated from the raw data of
+ *   the device, without acceleration; the coordinates of the event are
+ *   the last known coordinates of the pointer, and the axes are the
+ *   ones of the source device. Raw motion events are delivered to the
+ *   actor under the pointer without picking, and they are not
+ *   compressed with the regular motion events. Since: 1.26
  *
  * Flags for the #ClutterEvent
  *
@@ -731,7 +737,8 @@ typedef enum { /*< prefix=CLUTTER_DRAG >*/
  */
 typedef enum { /*< flags prefix=CLUTTER_EVENT >*/
   CLUTTER_EVENT_NONE           = 0,
-  CLUTTER_EVENT_FLAG_SYNTHETIC = 1 << 0
+  CLUTTER_EVENT_FLAG_SYNTHETIC = 1 << 0,
+  CLUTTER_EVENT_FLAG_RAW       = 1 << 1
 } ClutterEventFlags;
 
 /**
@@ -1473,6 +1480,41 @@ typedef enum {
   CLUTTER_INPUT_DEVICE_TOOL_LENS
 } ClutterInputDeviceToolType;
 
+/**
+ * ClutterProfilerCost:
+ * @CLUTTER_PROFILER_COST_PAINT: The cost of painting an actor
+ * @CLUTTER_PROFILER_COST_ALLOCATE: The cost of allocating an actor
+ * @CLUTTER_PROFILER_COST_PREFERRED_SIZE: The cost of querying the
+ *   preferred width and height of an actor
+ *
+ * The operations on a #ClutterActor whose cost is recorded by the
+ * profiler.
+ *
+ * Since: 1.26
+ */
+typedef enum {
+  CLUTTER_PROFILER_COST_PAINT,
+  CLUTTER_PROFILER_COST_ALLOCATE,
+  CLUTTER_PROFILER_COST_PREFERRED_SIZE
+} ClutterProfilerCost;
+
+/**
+ * ClutterLineJoin:
+ * @CLUTTER_LINE_JOIN_MITER: Sharp corners; corners sharper than the
+ *   miter limit are beveled instead
+ * @CLUTTER_LINE_JOIN_ROUND: Rounded corners
+ * @CLUTTER_LINE_JOIN_BEVEL: Corners cut off at half the line width
+ *
+ * The shape of the corners of a stroked #ClutterPath.
+ *
+ * Since: 1.26
+ */
+typedef enum {
+  CLUTTER_LINE_JOIN_MITER,
+  CLUTTER_LINE_JOIN_ROUND,
+  CLUTTER_LINE_JOIN_BEVEL
+} ClutterLineJoin;
+
 G_END_DECLS
 
 #endif /* __CLUTTER_ENUMS_H__ */
@@ -21,6 +21,10 @@ void            _clutter_event_set_platform_data        (ClutterEvent       *eve
                                                          gpointer            data);
 gpointer        _clutter_event_get_platform_data        (const ClutterEvent *event);
 
+gdouble *       _clutter_event_get_axes_storage         (ClutterEvent       *event,
+                                                         guint               n_axes);
+void            _clutter_event_reset                    (ClutterEvent       *event);
+
 void            _clutter_event_set_state_full           (ClutterEvent        *event,
 							 ClutterModifierType  button_state,
 							 ClutterModifierType  base_state,
@@ -45,6 +45,11 @@
  * be synthesized by Clutter itself or by the application code.
  */
 
+/* The number of axes values that are stored inside the event itself;
+ * events coming from devices with more axes use an allocated array
+ */
+#define N_INLINE_AXES   12
+
 typedef struct _ClutterEventPrivate {
   ClutterEvent base;
 
@@ -63,6 +68,8 @@ typedef struct _ClutterEventPrivate {
   ClutterModifierType latched_state;
   ClutterModifierType locked_state;
 
+  gdouble inline_axes[N_INLINE_AXES];
+
   guint is_pointer_emulated : 1;
 } ClutterEventPrivate;
 
@@ -1295,6 +1302,124 @@ clutter_event_new (ClutterEventType type)
   return new_event;
 }
 
+/*< private >
+ * _clutter_event_get_axes_storage:
+ * @event: a #ClutterEvent allocated with clutter_event_new()
+ * @n_axes: the number of axes of the device of the event
+ *
+ * Retrieves a zero-filled array large enough to store @n_axes values,
+ * to be used as the axes of @event. The array is owned by @event, and
+ * for most devices it is stored inside the event itself, so that the
+ * backends don't need to allocate an array for each event.
+ *
+ * Return value: the storage for the axes, or %NULL if @n_axes is 0
+ */
+gdouble *
+_clutter_event_get_axes_storage (ClutterEvent *event,
+                                 guint         n_axes)
+{
+  ClutterEventPrivate *real_event = (ClutterEventPrivate *) event;
+
+  if (n_axes == 0)
+    return NULL;
+
+  if (n_axes > N_INLINE_AXES || !is_event_allocated (event))
+    return g_new0 (gdouble, n_axes);
+
+  memset (real_event->inline_axes, 0, sizeof (gdouble) * n_axes);
+
+  return real_event->inline_axes;
+}
+
+/* the device that determines the number of axes of @event; the axes
+ * of raw events are the ones of the source device
+ */
+static ClutterInputDevice *
+get_axes_device (const ClutterEvent *event)
+{
+  if (event->any.flags & CLUTTER_EVENT_FLAG_RAW)
+    return clutter_event_get_source_device (event);
+
+  return clutter_event_get_device (event);
+}
+
+static gdouble *
+copy_axes (ClutterEvent  *new_event,
+           const gdouble *axes,
+           guint          n_axes)
+{
+  gdouble *retval;
+
+  if (axes == NULL)
+    return NULL;
+
+  retval = _clutter_event_get_axes_storage (new_event, n_axes);
+  if (retval != NULL)
+    memcpy (retval, axes, sizeof (gdouble) * n_axes);
+
+  return retval;
+}
+
+static void
+free_axes (ClutterEvent *event,
+           gdouble      *axes)
+{
+  ClutterEventPrivate *real_event = (ClutterEventPrivate *) event;
+
+  if (axes != real_event->inline_axes)
+    g_free (axes);
+}
+
+static void
+clear_event_data (ClutterEvent *event)
+{
+  _clutter_backend_free_event_data (clutter_get_default_backend (), event);
+
+  switch (event->type)
+    {
+    case CLUTTER_BUTTON_PRESS:
+    case CLUTTER_BUTTON_RELEASE:
+      free_axes (event, event->button.axes);
+      break;
+
+    case CLUTTER_MOTION:
+      free_axes (event, event->motion.axes);
+      break;
+
+    case CLUTTER_SCROLL:
+      free_axes (event, event->scroll.axes);
+      break;
+
+    case CLUTTER_TOUCH_BEGIN:
+    case CLUTTER_TOUCH_UPDATE:
+    case CLUTTER_TOUCH_END:
+    case CLUTTER_TOUCH_CANCEL:
+      free_axes (event, event->touch.axes);
+      break;
+
+    default:
+      break;
+    }
+}
+
+/*< private >
+ * _clutter_event_reset:
+ * @event: a #ClutterEvent allocated with clutter_event_new()
+ *
+ * Releases the resources of @event and clears all of its fields, both
+ * public and private, so that it can be filled again as if it had just
+ * been returned by clutter_event_new (%CLUTTER_NOTHING).
+ */
+void
+_clutter_event_reset (ClutterEvent *event)
+{
+  g_return_if_fail (is_event_allocated (event));
+
+  clear_event_data (event);
+
+  memset (event, 0, sizeof (ClutterEventPrivate));
+}
+
 /**
  * clutter_event_copy:
  * @event: A #ClutterEvent.
@@ -1333,7 +1458,7 @@ clutter_event_copy (const ClutterEvent *event)
       new_real_event->locked_state = real_event->locked_state;
     }
 
-  device = clutter_event_get_device (event);
+  device = get_axes_device (event);
   if (device != NULL)
     n_axes = clutter_input_device_get_n_axes (device);
 
@@ -1341,30 +1466,22 @@ clutter_event_copy (const ClutterEvent *event)
     {
     case CLUTTER_BUTTON_PRESS:
     case CLUTTER_BUTTON_RELEASE:
-      if (event->button.axes != NULL)
-        new_event->button.axes = g_memdup (event->button.axes,
-                                           sizeof (gdouble) * n_axes);
+      new_event->button.axes = copy_axes (new_event, event->button.axes, n_axes);
       break;
 
     case CLUTTER_SCROLL:
-      if (event->scroll.axes != NULL)
-        new_event->scroll.axes = g_memdup (event->scroll.axes,
-                                           sizeof (gdouble) * n_axes);
+      new_event->scroll.axes = copy_axes (new_event, event->scroll.axes, n_axes);
       break;
 
     case CLUTTER_MOTION:
-      if (event->motion.axes != NULL)
-        new_event->motion.axes = g_memdup (event->motion.axes,
-                                           sizeof (gdouble) * n_axes);
+      new_event->motion.axes = copy_axes (new_event, event->motion.axes, n_axes);
       break;
 
     case CLUTTER_TOUCH_BEGIN:
     case CLUTTER_TOUCH_UPDATE:
     case CLUTTER_TOUCH_END:
     case CLUTTER_TOUCH_CANCEL:
-      if (event->touch.axes != NULL)
-        new_event->touch.axes = g_memdup (event->touch.axes,
-                                          sizeof (gdouble) * n_axes);
+      new_event->touch.axes = copy_axes (new_event, event->touch.axes, n_axes);
       break;
 
     default:
@@ -1390,33 +1507,7 @@ clutter_event_free (ClutterEvent *event)
 {
   if (G_LIKELY (event != NULL))
     {
-      _clutter_backend_free_event_data (clutter_get_default_backend (), event);
-
-      switch (event->type)
-        {
-        case CLUTTER_BUTTON_PRESS:
-        case CLUTTER_BUTTON_RELEASE:
-          g_free (event->button.axes);
-          break;
-
-        case CLUTTER_MOTION:
-          g_free (event->motion.axes);
-          break;
-
-        case CLUTTER_SCROLL:
-          g_free (event->scroll.axes);
-          break;
-
-        case CLUTTER_TOUCH_BEGIN:
-        case CLUTTER_TOUCH_UPDATE:
-        case CLUTTER_TOUCH_END:
-        case CLUTTER_TOUCH_CANCEL:
-          g_free (event->touch.axes);
-          break;
-
-        default:
-          break;
-        }
+      clear_event_data (event);
 
       g_hash_table_remove (all_events, event);
       g_slice_free (ClutterEventPrivate, (ClutterEventPrivate *) event);
@@ -1710,9 +1801,8 @@ clutter_event_get_axes (const ClutterEvent *event,
 
   if (retval != NULL)
     {
-      ClutterInputDevice *device;
+      ClutterInputDevice *device = get_axes_device (event);
 
-      device = clutter_event_get_device (event);
       if (device != NULL)
         len = clutter_input_device_get_n_axes (device);
       else
@@ -35,12 +35,38 @@
 #include "clutter-debug.h"
 #include "clutter-id-pool.h"
 
+/* Each slot of the pool holds either the pointer associated to its
+ * id or, if the id is free, the next id in the list of free ids; the
+ * two are told apart by the lowest bit, which is never set in the
+ * pointers we store, so the free list needs no allocation of its own
+ */
+#define SLOT_IS_FREE(slot)      ((GPOINTER_TO_SIZE (slot) & 1) != 0)
+#define SLOT_NEXT_FREE(slot)    ((guint32) (GPOINTER_TO_SIZE (slot) >> 1))
+#define SLOT_FREE(next)         (GSIZE_TO_POINTER (((gsize) (next) << 1) | 1))
+
+#define NO_FREE_ID              (G_MAXUINT32 >> 1)
+
 struct _ClutterIDPool
 {
-  GArray *array;     /* Array of pointers    */
-  GSList *free_ids;  /* A stack of freed ids */
+  gpointer *slots;
+
+  guint32 n_slots;      /* The number of ids handed out so far */
+  guint32 size;         /* The number of allocated slots */
+
+  guint32 free_id;      /* The most recently freed id */
 };
 
+static void
+clutter_id_pool_ensure_size (ClutterIDPool *id_pool,
+                             guint32        size)
+{
+  if (size <= id_pool->size)
+    return;
+
+  id_pool->size = MAX (size, id_pool->size * 2);
+  id_pool->slots = g_renew (gpointer, id_pool->slots, id_pool->size);
+}
+
 ClutterIDPool *
 _clutter_id_pool_new  (guint initial_size)
 {
@@ -48,9 +74,11 @@ _clutter_id_pool_new  (guint initial_size)
 
   self = g_slice_new (ClutterIDPool);
 
-  self->array = g_array_sized_new (FALSE, FALSE, 
-                                   sizeof (gpointer), initial_size);
-  self->free_ids = NULL;
+  self->slots = g_new (gpointer, initial_size);
+  self->n_slots = 0;
+  self->size = initial_size;
+  self->free_id = NO_FREE_ID;
+
   return self;
 }
 
@@ -59,34 +87,52 @@ _clutter_id_pool_free (ClutterIDPool *id_pool)
 {
   g_return_if_fail (id_pool != NULL);
 
-  g_array_free (id_pool->array, TRUE);
-  g_slist_free (id_pool->free_ids);
+  g_free (id_pool->slots);
   g_slice_free (ClutterIDPool, id_pool);
 }
 
+/*
+ * _clutter_id_pool_reserve:
+ * @id_pool: a #ClutterIDPool
+ * @n_ids: the number of ids to reserve
+ *
+ * Makes sure that @n_ids ids can be added to the pool without
+ * growing it, e.g. before associating ids to a large number of
+ * new pointers.
+ */
+void
+_clutter_id_pool_reserve (ClutterIDPool *id_pool,
+                          guint          n_ids)
+{
+  g_return_if_fail (id_pool != NULL);
+
+  clutter_id_pool_ensure_size (id_pool, id_pool->n_slots + n_ids);
+}
+
 guint32
 _clutter_id_pool_add (ClutterIDPool *id_pool,
                       gpointer       ptr)
 {
-  gpointer *array;
   guint32 retval;
 
   g_return_val_if_fail (id_pool != NULL, 0);
+  g_return_val_if_fail (!SLOT_IS_FREE (ptr), 0);
 
-  if (id_pool->free_ids) /* There are items on our freelist, reuse one */
+  if (id_pool->free_id != NO_FREE_ID) /* Reuse the most recently freed id */
     {
-      array = (void*) id_pool->array->data;
-      retval = GPOINTER_TO_UINT (id_pool->free_ids->data);
+      retval = id_pool->free_id;
+
+      id_pool->free_id = SLOT_NEXT_FREE (id_pool->slots[retval]);
+      id_pool->slots[retval] = ptr;
 
-      id_pool->free_ids = g_slist_remove (id_pool->free_ids,
-                                          id_pool->free_ids->data);
-      array[retval] = ptr;
       return retval;
     }
 
   /* Allocate new id */
-  retval = id_pool->array->len;
-  g_array_append_val (id_pool->array, ptr);
+  clutter_id_pool_ensure_size (id_pool, id_pool->n_slots + 1);
+
+  retval = id_pool->n_slots++;
+  id_pool->slots[retval] = ptr;
 
   return retval;
 }
@@ -95,30 +141,25 @@ void
 _clutter_id_pool_remove (ClutterIDPool *id_pool,
                          guint32        id_)
 {
-  gpointer *array;
-
   g_return_if_fail (id_pool != NULL);
+  g_return_if_fail (id_ < id_pool->n_slots);
+  g_return_if_fail (!SLOT_IS_FREE (id_pool->slots[id_]));
 
-  array = (void*) id_pool->array->data;
-
-  array[id_] = NULL;
-
-  id_pool->free_ids = g_slist_prepend (id_pool->free_ids,
-                                       GUINT_TO_POINTER (id_));
+  id_pool->slots[id_] = SLOT_FREE (id_pool->free_id);
+  id_pool->free_id = id_;
 }
 
 gpointer
 _clutter_id_pool_lookup (ClutterIDPool *id_pool,
                          guint32        id_)
 {
-  gpointer *array;
+  gpointer slot;
 
   g_return_val_if_fail (id_pool != NULL, NULL);
-  g_return_val_if_fail (id_pool->array != NULL, NULL);
 
-  array = (void*) id_pool->array->data;
+  slot = id_ < id_pool->n_slots ? id_pool->slots[id_] : NULL;
 
-  if (id_ >= id_pool->array->len || array[id_] == NULL)
+  if (slot == NULL || SLOT_IS_FREE (slot))
     {
       g_warning ("The required ID of %u does not refer to an existing actor; "
                  "this usually implies that the pick() of an actor is not "
@@ -127,5 +168,5 @@ _clutter_id_pool_lookup (ClutterIDPool *id_pool,
       return NULL;
     }
 
-  return array[id_];
+  return slot;
 }
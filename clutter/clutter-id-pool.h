@@ -37,6 +37,9 @@ typedef struct _ClutterIDPool   ClutterIDPool;
 ClutterIDPool * _clutter_id_pool_new    (guint          initial_size);
 void            _clutter_id_pool_free   (ClutterIDPool *id_pool);
 
+void            _clutter_id_pool_reserve (ClutterIDPool *id_pool,
+                                          guint          n_ids);
+
 guint32         _clutter_id_pool_add    (ClutterIDPool *id_pool,
                                          gpointer       ptr);
 void            _clutter_id_pool_remove (ClutterIDPool *id_pool,
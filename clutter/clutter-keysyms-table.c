@@ -830,6 +830,44 @@ static const struct {
 static const int clutter_keysym_to_unicode_tab_size =
   G_N_ELEMENTS (clutter_keysym_to_unicode_tab);
 
+/* Most of the key symbols in the table above are the legacy 8 bit
+ * character sets, from 0x0100 to 0x0eff, and the numeric keypad, from
+ * KP_Space to KP_Equal; key symbols in those ranges are looked up
+ * directly in these arrays, which are built from the table when first
+ * needed
+ */
+#define KEYSYM_LEGACY_FIRST     0x0100
+#define KEYSYM_LEGACY_LAST      0x0eff
+#define KEYSYM_KEYPAD_FIRST     0xff80
+#define KEYSYM_KEYPAD_LAST      0xffbd
+
+static guint16 keysym_legacy_to_unicode[KEYSYM_LEGACY_LAST - KEYSYM_LEGACY_FIRST + 1];
+static guint16 keysym_keypad_to_unicode[KEYSYM_KEYPAD_LAST - KEYSYM_KEYPAD_FIRST + 1];
+
+static void
+ensure_keysym_to_unicode_index (void)
+{
+  static gsize initialized = 0;
+
+  if (g_once_init_enter (&initialized))
+    {
+      int i;
+
+      for (i = 0; i < clutter_keysym_to_unicode_tab_size; i++)
+        {
+          guint keysym = clutter_keysym_to_unicode_tab[i].keysym;
+          guint16 ucs = clutter_keysym_to_unicode_tab[i].ucs;
+
+          if (keysym >= KEYSYM_LEGACY_FIRST && keysym <= KEYSYM_LEGACY_LAST)
+            keysym_legacy_to_unicode[keysym - KEYSYM_LEGACY_FIRST] = ucs;
+          else if (keysym >= KEYSYM_KEYPAD_FIRST && keysym <= KEYSYM_KEYPAD_LAST)
+            keysym_keypad_to_unicode[keysym - KEYSYM_KEYPAD_FIRST] = ucs;
+        }
+
+      g_once_init_leave (&initialized, 1);
+    }
+}
+
 /**
  * clutter_keysym_to_unicode:
  * @keyval: a key symbol
@@ -856,6 +894,14 @@ clutter_keysym_to_unicode (guint keyval)
   if ((keyval & 0xff000000) == 0x01000000)
     return keyval & 0x00ffffff;
 
+  ensure_keysym_to_unicode_index ();
+
+  if (keyval >= KEYSYM_LEGACY_FIRST && keyval <= KEYSYM_LEGACY_LAST)
+    return keysym_legacy_to_unicode[keyval - KEYSYM_LEGACY_FIRST];
+
+  if (keyval >= KEYSYM_KEYPAD_FIRST && keyval <= KEYSYM_KEYPAD_LAST)
+    return keysym_keypad_to_unicode[keyval - KEYSYM_KEYPAD_FIRST];
+
   /* binary search in table */
   while (max >= min)
     {
@@ -1635,6 +1681,35 @@ static const struct {
 static const int clutter_unicode_to_keysym_tab_size =
   G_N_ELEMENTS (clutter_unicode_to_keysym_tab);
 
+/* The alphabetic scripts below U+0800 (Latin, Greek, Cyrillic, Hebrew
+ * and Arabic) are looked up directly in this array, which is built
+ * from the table above when first needed
+ */
+#define UNICODE_INDEX_LAST      0x07ff
+
+static guint16 unicode_to_keysym_index[UNICODE_INDEX_LAST + 1];
+
+static void
+ensure_unicode_to_keysym_index (void)
+{
+  static gsize initialized = 0;
+
+  if (g_once_init_enter (&initialized))
+    {
+      int i;
+
+      for (i = 0; i < clutter_unicode_to_keysym_tab_size; i++)
+        {
+          guint32 ucs = clutter_unicode_to_keysym_tab[i].ucs;
+
+          if (ucs <= UNICODE_INDEX_LAST)
+            unicode_to_keysym_index[ucs] = clutter_unicode_to_keysym_tab[i].keysym;
+        }
+
+      g_once_init_leave (&initialized, 1);
+    }
+}
+
 /**
  * clutter_unicode_to_keysym:
  * @wc: a ISO10646 encoded character
@@ -1658,6 +1733,16 @@ clutter_unicode_to_keysym (guint32 wc)
       (wc >= 0x00a0 && wc <= 0x00ff))
     return wc;
 
+  if (wc <= UNICODE_INDEX_LAST)
+    {
+      ensure_unicode_to_keysym_index ();
+
+      if (unicode_to_keysym_index[wc] != 0)
+        return unicode_to_keysym_index[wc];
+
+      return wc | 0x01000000;
+    }
+
   /* Binary search in table */
   while (max >= min)
     {
@@ -65,6 +65,7 @@
 #include "clutter-main.h"
 #include "clutter-master-clock.h"
 #include "clutter-private.h"
+#include "clutter-profiler-private.h"
 #include "clutter-settings-private.h"
 #include "clutter-stage-manager.h"
 #include "clutter-stage-private.h"
@@ -91,6 +92,9 @@
 #ifdef CLUTTER_WINDOWING_MIR
 #include "mir/clutter-backend-mir.h"
 #endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+#include "headless/clutter-backend-headless.h"
+#endif
 
 #include <cogl/cogl.h>
 #include <cogl-pango/cogl-pango.h>
@@ -1510,6 +1514,14 @@ pre_parse_hook (GOptionContext  *context,
   if (env_string)
     clutter_show_fps = TRUE;
 
+  env_string = g_getenv ("CLUTTER_PROFILE");
+  if (env_string != NULL && *env_string != '\0')
+    _clutter_profiler_init (env_string);
+
+  env_string = g_getenv ("CLUTTER_PROFILE_ACTORS");
+  if (env_string != NULL && *env_string != '\0')
+    _clutter_profiler_init_actors (env_string);
+
   env_string = g_getenv ("CLUTTER_DEFAULT_FPS");
   if (env_string)
     {
@@ -2359,11 +2371,25 @@ _clutter_process_event_details (ClutterActor        *stage,
                   break;
                 }
 
+              /* raw motion events have the coordinates of the last
+               * regular motion event, so the actor underneath them is
+               * already known, and they must not cause crossing events
+               */
+              if (event->type == CLUTTER_MOTION &&
+                  (event->motion.flags & CLUTTER_EVENT_FLAG_RAW) != 0)
+                {
+                  actor = device != NULL
+                        ? clutter_input_device_get_pointer_actor (device)
+                        : NULL;
+
+                  if (actor == NULL)
+                    actor = stage;
+                }
               /* if the backend provides a device then we should
                * already have everything we need to update it and
                * get the actor underneath
                */
-              if (device != NULL)
+              else if (device != NULL)
                 actor = _clutter_input_device_update (device, NULL, TRUE);
               else
                 {
@@ -3711,6 +3737,12 @@ clutter_check_windowing_backend (const char *backend_type)
       CLUTTER_IS_BACKEND_X11 (context->backend))
     return TRUE;
   else
+#endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+  if (backend_type == I_(CLUTTER_WINDOWING_HEADLESS) &&
+      CLUTTER_IS_BACKEND_HEADLESS (context->backend))
+    return TRUE;
+  else
 #endif
   return FALSE;
 }
@@ -35,8 +35,10 @@
 
 #include "clutter-master-clock.h"
 #include "clutter-master-clock-default.h"
+#include "clutter-actor-private.h"
 #include "clutter-debug.h"
 #include "clutter-private.h"
+#include "clutter-profiler-private.h"
 #include "clutter-stage-manager-private.h"
 #include "clutter-stage-private.h"
 
@@ -88,6 +90,11 @@ struct _ClutterMasterClockDefault
   guint ensure_next_iteration : 1;
 
   guint paused : 1;
+
+  /* If the master clock uses virtual time, frames are dispatched
+   * back to back and each one advances the time by a fixed interval
+   */
+  guint virtual_time : 1;
 };
 
 struct _ClutterClockSource
@@ -238,7 +245,8 @@ master_clock_list_ready_stages (ClutterMasterClockDefault *master_clock)
        * vblank and really match the vsync frequency.
        */
       if (clutter_actor_is_mapped (l->data) &&
-          update_time != -1 && update_time <= master_clock->cur_tick)
+          update_time != -1 &&
+          update_time <= g_source_get_time (master_clock->source))
         result = g_slist_prepend (result, g_object_ref (l->data));
     }
 
@@ -288,6 +296,15 @@ master_clock_next_frame_delay (ClutterMasterClockDefault *master_clock)
   if (swap_delay != 0)
     return swap_delay;
 
+  /* In virtual time there is no point in waiting, as the time between
+   * two frames is fixed anyway
+   */
+  if (master_clock->virtual_time)
+    {
+      CLUTTER_NOTE (SCHEDULER, "virtual time: draw the next frame immediately");
+      return 0;
+    }
+
   /* When we have sync-to-vblank, we count on swap-buffer requests (or
    * swap-buffer-complete events if supported in the backend) to throttle our
    * frame rate so no additional delay is needed to start the next frame.
@@ -355,6 +372,7 @@ master_clock_process_events (ClutterMasterClockDefault *master_clock,
                              GSList                    *stages)
 {
   GSList *l;
+  gint64 profile_start = _clutter_profiler_begin ();
 #ifdef CLUTTER_ENABLE_DEBUG
   gint64 start = g_get_monotonic_time ();
 #endif
@@ -363,6 +381,8 @@ master_clock_process_events (ClutterMasterClockDefault *master_clock,
   for (l = stages; l != NULL; l = l->next)
     _clutter_stage_process_queued_events (l->data);
 
+  _clutter_profiler_end (CLUTTER_PROFILER_PHASE_EVENTS, NULL, profile_start);
+
 #ifdef CLUTTER_ENABLE_DEBUG
   if (_clutter_diagnostic_enabled ())
     clutter_warn_if_over_budget (master_clock, start, "Event processing");
@@ -383,6 +403,7 @@ static void
 master_clock_advance_timelines (ClutterMasterClockDefault *master_clock)
 {
   GSList *timelines, *l;
+  gint64 profile_start = _clutter_profiler_begin ();
 #ifdef CLUTTER_ENABLE_DEBUG
   gint64 start = g_get_monotonic_time ();
 #endif
@@ -410,12 +431,19 @@ master_clock_advance_timelines (ClutterMasterClockDefault *master_clock)
   timelines = g_slist_copy (master_clock->timelines);
   g_slist_foreach (timelines, (GFunc) g_object_ref, NULL);
 
+  /* coalesce the property notifications of the actors being animated */
+  _clutter_actor_push_deferred_notify ();
+
   for (l = timelines; l != NULL; l = l->next)
     _clutter_timeline_do_tick (l->data, master_clock->cur_tick / 1000);
 
+  _clutter_actor_pop_deferred_notify ();
+
   g_slist_foreach (timelines, (GFunc) g_object_unref, NULL);
   g_slist_free (timelines);
 
+  _clutter_profiler_end (CLUTTER_PROFILER_PHASE_TIMELINES, NULL, profile_start);
+
 #ifdef CLUTTER_ENABLE_DEBUG
   if (_clutter_diagnostic_enabled ())
     clutter_warn_if_over_budget (master_clock, start, "Animations");
@@ -537,8 +565,14 @@ clutter_clock_dispatch (GSource     *source,
 
   _clutter_threads_acquire_lock ();
 
+  _clutter_profiler_frame_begin ();
+
   /* Get the time to use for this frame */
-  master_clock->cur_tick = g_source_get_time (source);
+  if (master_clock->virtual_time && master_clock->prev_tick != 0)
+    master_clock->cur_tick = master_clock->prev_tick
+                           + (G_USEC_PER_SEC / clutter_get_default_frame_rate ());
+  else
+    master_clock->cur_tick = g_source_get_time (source);
 
 #ifdef CLUTTER_ENABLE_DEBUG
   master_clock->remaining_budget = master_clock->frame_budget;
@@ -578,6 +612,8 @@ clutter_clock_dispatch (GSource     *source,
 
   master_clock->prev_tick = master_clock->cur_tick;
 
+  _clutter_profiler_frame_end ();
+
   _clutter_threads_release_lock ();
 
   return TRUE;
@@ -612,6 +648,7 @@ clutter_master_clock_default_init (ClutterMasterClockDefault *self)
   self->idle = FALSE;
   self->ensure_next_iteration = FALSE;
   self->paused = FALSE;
+  self->virtual_time = FALSE;
 
 #ifdef CLUTTER_ENABLE_DEBUG
   self->frame_budget = G_USEC_PER_SEC / 60;
@@ -680,6 +717,21 @@ clutter_master_clock_default_set_paused (ClutterMasterClock *clock,
   master_clock->paused = !!paused;
 }
 
+static void
+clutter_master_clock_default_set_virtual_time (ClutterMasterClock *clock,
+                                               gboolean            virtual_time)
+{
+  ClutterMasterClockDefault *master_clock = (ClutterMasterClockDefault *) clock;
+
+  if (master_clock->virtual_time == !!virtual_time)
+    return;
+
+  master_clock->virtual_time = !!virtual_time;
+
+  /* restart from the current time when switching in or out */
+  master_clock->prev_tick = 0;
+}
+
 static void
 clutter_master_clock_iface_init (ClutterMasterClockIface *iface)
 {
@@ -688,4 +740,5 @@ clutter_master_clock_iface_init (ClutterMasterClockIface *iface)
   iface->start_running = clutter_master_clock_default_start_running;
   iface->ensure_next_iteration = clutter_master_clock_default_ensure_next_iteration;
   iface->set_paused = clutter_master_clock_default_set_paused;
+  iface->set_virtual_time = clutter_master_clock_default_set_virtual_time;
 }
@@ -147,3 +147,29 @@ _clutter_master_clock_set_paused (ClutterMasterClock *master_clock,
   CLUTTER_MASTER_CLOCK_GET_IFACE (master_clock)->set_paused (master_clock,
                                                              !!paused);
 }
+
+/*
+ * _clutter_master_clock_set_virtual_time:
+ * @master_clock: a #ClutterMasterClock
+ * @virtual_time: whether the master clock should use virtual time
+ *
+ * Switches @master_clock to a virtual time mode, in which each frame is
+ * dispatched as soon as possible, and the time is advanced by exactly
+ * one frame interval, as defined by clutter_get_default_frame_rate(),
+ * regardless of how much time has actually passed.
+ *
+ * Implementations of #ClutterMasterClock that are driven by an
+ * external clock may ignore this setting.
+ */
+void
+_clutter_master_clock_set_virtual_time (ClutterMasterClock *master_clock,
+                                        gboolean            virtual_time)
+{
+  ClutterMasterClockIface *iface;
+
+  g_return_if_fail (CLUTTER_IS_MASTER_CLOCK (master_clock));
+
+  iface = CLUTTER_MASTER_CLOCK_GET_IFACE (master_clock);
+  if (iface->set_virtual_time != NULL)
+    iface->set_virtual_time (master_clock, !!virtual_time);
+}
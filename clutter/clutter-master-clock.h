@@ -49,6 +49,8 @@ struct _ClutterMasterClockIface
   void (* ensure_next_iteration)  (ClutterMasterClock *master_clock);
   void (* set_paused)             (ClutterMasterClock *master_clock,
                                    gboolean            paused);
+  void (* set_virtual_time)       (ClutterMasterClock *master_clock,
+                                   gboolean            virtual_time);
 };
 
 GType _clutter_master_clock_get_type (void) G_GNUC_CONST;
@@ -62,6 +64,8 @@ void                    _clutter_master_clock_start_running             (Clutter
 void                    _clutter_master_clock_ensure_next_iteration     (ClutterMasterClock *master_clock);
 void                    _clutter_master_clock_set_paused                (ClutterMasterClock *master_clock,
                                                                          gboolean            paused);
+void                    _clutter_master_clock_set_virtual_time          (ClutterMasterClock *master_clock,
+                                                                         gboolean            virtual_time);
 
 void                    _clutter_timeline_advance                       (ClutterTimeline    *timeline,
                                                                          gint64              tick_time);
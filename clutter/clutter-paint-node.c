@@ -71,6 +71,7 @@
 #include "clutter-paint-node-private.h"
 
 #include "clutter-debug.h"
+#include "clutter-path.h"
 #include "clutter-private.h"
 
 #include <gobject/gvaluecollector.h>
@@ -938,6 +939,77 @@ clutter_paint_node_add_primitive (ClutterPaintNode *node,
   g_array_append_val (node->operations, operation);
 }
 
+/**
+ * clutter_paint_node_add_path_fill:
+ * @node: a #ClutterPaintNode
+ * @path: a #ClutterPath
+ *
+ * Adds the area inside @path to the @node.
+ *
+ * The area is drawn using the triangle mesh cached by @path, which
+ * is only rebuilt when the nodes of @path change; see
+ * clutter_path_get_fill_primitive().
+ *
+ * Since: 1.26
+ */
+void
+clutter_paint_node_add_path_fill (ClutterPaintNode *node,
+                                  ClutterPath      *path)
+{
+  ClutterPaintOperation operation = PAINT_OP_INIT;
+  CoglPrimitive *primitive;
+
+  g_return_if_fail (CLUTTER_IS_PAINT_NODE (node));
+  g_return_if_fail (CLUTTER_IS_PATH (path));
+
+  primitive = clutter_path_get_fill_primitive (path);
+  if (primitive == NULL)
+    return;
+
+  clutter_paint_node_maybe_init_operations (node);
+
+  clutter_paint_op_init_primitive (&operation, primitive);
+  g_array_append_val (node->operations, operation);
+}
+
+/**
+ * clutter_paint_node_add_path_stroke:
+ * @node: a #ClutterPaintNode
+ * @path: a #ClutterPath
+ * @line_width: the width of the line
+ * @line_join: the shape of the corners of the line
+ *
+ * Adds the outline of @path, stroked with a line of the given width,
+ * to the @node.
+ *
+ * The outline is drawn using the triangle mesh cached by @path; see
+ * clutter_path_get_stroke_primitive().
+ *
+ * Since: 1.26
+ */
+void
+clutter_paint_node_add_path_stroke (ClutterPaintNode *node,
+                                    ClutterPath      *path,
+                                    gfloat            line_width,
+                                    ClutterLineJoin   line_join)
+{
+  ClutterPaintOperation operation = PAINT_OP_INIT;
+  CoglPrimitive *primitive;
+
+  g_return_if_fail (CLUTTER_IS_PAINT_NODE (node));
+  g_return_if_fail (CLUTTER_IS_PATH (path));
+  g_return_if_fail (line_width > 0.f);
+
+  primitive = clutter_path_get_stroke_primitive (path, line_width, line_join);
+  if (primitive == NULL)
+    return;
+
+  clutter_paint_node_maybe_init_operations (node);
+
+  clutter_paint_op_init_primitive (&operation, primitive);
+  g_array_append_val (node->operations, operation);
+}
+
 /*< private >
  * _clutter_paint_node_paint:
  * @node: a #ClutterPaintNode
@@ -75,6 +75,15 @@ void                    clutter_paint_node_add_primitive                (Clutter
                                                                          CoglPrimitive         *primitive);
 #endif /* COGL_ENABLE_EXPERIMENTAL_API && CLUTTER_ENABLE_EXPERIMENTAL_API */
 
+CLUTTER_AVAILABLE_IN_1_26
+void                    clutter_paint_node_add_path_fill                (ClutterPaintNode      *node,
+                                                                         ClutterPath           *path);
+CLUTTER_AVAILABLE_IN_1_26
+void                    clutter_paint_node_add_path_stroke              (ClutterPaintNode      *node,
+                                                                         ClutterPath           *path,
+                                                                         gfloat                 line_width,
+                                                                         ClutterLineJoin        line_join);
+
 /**
  * CLUTTER_VALUE_HOLDS_PAINT_NODE:
  * @value: a #GValue
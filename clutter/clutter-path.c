@@ -72,7 +72,6 @@
 
 #include "clutter-path.h"
 #include "clutter-types.h"
-#include "clutter-bezier.h"
 #include "clutter-private.h"
 
 #define CLUTTER_PATH_NODE_TYPE_IS_VALID(t) \
@@ -92,15 +91,75 @@ enum
 
 static GParamSpec *obj_props[PROP_LAST];
 
-typedef struct _ClutterPathNodeFull ClutterPathNodeFull;
+/* Curves are subdivided until each piece is within CURVE_TOLERANCE
+ * pixels of a straight line, with at least 2^CURVE_MIN_DEPTH and at
+ * most 2^CURVE_MAX_DEPTH pieces
+ */
+#define CURVE_TOLERANCE         0.1f
+#define CURVE_MIN_DEPTH         2
+#define CURVE_MAX_DEPTH         10
+
+/* Corners of stroked paths sharper than about 29 degrees are beveled
+ * instead of mitered
+ */
+#define MITER_LIMIT             4.0f
+
+#define TESSELLATION_EPSILON    1e-4f
+
+typedef struct _ClutterPathNodeFull     ClutterPathNodeFull;
+typedef struct _ClutterPathSegment      ClutterPathSegment;
+typedef struct _ClutterPathSample       ClutterPathSample;
+typedef struct _ClutterPathContour      ClutterPathContour;
+typedef struct _ClutterPathEdge         ClutterPathEdge;
 
 struct _ClutterPathNodeFull
 {
   ClutterPathNode k;
+};
 
-  ClutterBezier *bezier;
+/* A node resolved to absolute coordinates */
+struct _ClutterPathSegment
+{
+  guint type;
 
-  guint length;
+  /* start point, control points and end point */
+  ClutterPoint points[4];
+
+  gfloat length;
+
+  /* the length of the path up to the end of the segment */
+  gfloat end_distance;
+
+  /* the arc length table of curves, in ClutterPathPrivate.samples */
+  guint first_sample;
+  guint n_samples;
+};
+
+struct _ClutterPathSample
+{
+  gfloat t;
+  gfloat distance;
+};
+
+/* A flattened sub-path, in the array of points built by
+ * clutter_path_flatten()
+ */
+struct _ClutterPathContour
+{
+  guint first_point;
+  guint n_points;
+
+  guint closed : 1;
+};
+
+/* An edge of the filled path, going downwards */
+struct _ClutterPathEdge
+{
+  gfloat x0, y0;
+  gfloat x1, y1;
+
+  /* sorting key */
+  gfloat key;
 };
 
 struct _ClutterPathPrivate
@@ -108,7 +167,21 @@ struct _ClutterPathPrivate
   GSList *nodes, *nodes_tail;
   gboolean nodes_dirty;
 
-  guint total_length;
+  ClutterPathSegment *segments;
+  guint n_segments;
+
+  GArray *samples;
+
+  gfloat total_length;
+
+  /* cached triangle meshes */
+  CoglPrimitive *fill_primitive;
+  CoglPrimitive *stroke_primitive;
+  gfloat stroke_width;
+  ClutterLineJoin stroke_join;
+
+  guint fill_valid : 1;
+  guint stroke_valid : 1;
 };
 
 /* Character tests that don't pay attention to the locale */
@@ -231,6 +304,16 @@ clutter_value_transform_string_path (const GValue *src,
   g_value_take_object (dest, new_path);
 }
 
+static void
+clutter_path_clear_primitives (ClutterPathPrivate *priv)
+{
+  g_clear_pointer (&priv->fill_primitive, cogl_object_unref);
+  g_clear_pointer (&priv->stroke_primitive, cogl_object_unref);
+
+  priv->fill_valid = FALSE;
+  priv->stroke_valid = FALSE;
+}
+
 static void
 clutter_path_finalize (GObject *object)
 {
@@ -238,6 +321,13 @@ clutter_path_finalize (GObject *object)
 
   clutter_path_clear (self);
 
+  clutter_path_clear_primitives (self->priv);
+
+  g_free (self->priv->segments);
+
+  if (self->priv->samples != NULL)
+    g_array_unref (self->priv->samples);
+
   G_OBJECT_CLASS (clutter_path_parent_class)->finalize (object);
 }
 
@@ -1210,25 +1300,87 @@ clutter_path_get_description (ClutterPath *path)
   return g_string_free (str, FALSE);
 }
 
-static guint
-clutter_path_node_distance (const ClutterKnot *start,
-                            const ClutterKnot *end)
+static void
+clutter_path_curve_get_point (const ClutterPoint *p,
+                              gfloat              t,
+                              ClutterPoint       *point)
 {
-  gint64 x_d, y_d;
-  float t;
+  gfloat mt = 1.0f - t;
+  gfloat a = mt * mt * mt;
+  gfloat b = 3.0f * mt * mt * t;
+  gfloat c = 3.0f * mt * t * t;
+  gfloat d = t * t * t;
+
+  point->x = a * p[0].x + b * p[1].x + c * p[2].x + d * p[3].x;
+  point->y = a * p[0].y + b * p[1].y + c * p[2].y + d * p[3].y;
+}
 
-  g_return_val_if_fail (start != NULL, 0);
-  g_return_val_if_fail (end != NULL, 0);
+static void
+clutter_path_curve_flatten (GArray             *samples,
+                            const ClutterPoint *p,
+                            gfloat              t0,
+                            gfloat              t1,
+                            guint               depth,
+                            gfloat             *length)
+{
+  ClutterPoint left[4], right[4], mid;
+  gfloat ux, uy, vx, vy;
+
+  /* Maximum distance of the control points from the chord, squared
+   * and multiplied by 16; see "Piecewise Linear Approximation of
+   * Bézier Curves", Roger Willcocks */
+  ux = 3.0f * p[1].x - 2.0f * p[0].x - p[3].x;
+  uy = 3.0f * p[1].y - 2.0f * p[0].y - p[3].y;
+  vx = 3.0f * p[2].x - 2.0f * p[3].x - p[0].x;
+  vy = 3.0f * p[2].y - 2.0f * p[3].y - p[0].y;
+
+  ux *= ux;
+  uy *= uy;
+  vx *= vx;
+  vy *= vy;
+
+  if (depth >= CURVE_MAX_DEPTH
+      || (depth >= CURVE_MIN_DEPTH
+          && MAX (ux, vx) + MAX (uy, vy) <= 16.0f * CURVE_TOLERANCE * CURVE_TOLERANCE))
+    {
+      ClutterPathSample sample;
 
-  if (clutter_knot_equal (start, end))
-    return 0;
+      *length += clutter_point_distance (&p[0], &p[3], NULL, NULL);
 
-  x_d = end->x - start->x;
-  y_d = end->y - start->y;
+      sample.t = t1;
+      sample.distance = *length;
+      g_array_append_val (samples, sample);
 
-  t = floorf (sqrtf ((x_d * x_d) + (y_d * y_d)));
+      return;
+    }
 
-  return (guint) t;
+  /* Split the curve in half using de Casteljau's algorithm */
+  mid.x = (p[1].x + p[2].x) * 0.5f;
+  mid.y = (p[1].y + p[2].y) * 0.5f;
+
+  left[0] = p[0];
+  left[1].x = (p[0].x + p[1].x) * 0.5f;
+  left[1].y = (p[0].y + p[1].y) * 0.5f;
+  left[2].x = (left[1].x + mid.x) * 0.5f;
+  left[2].y = (left[1].y + mid.y) * 0.5f;
+
+  right[3] = p[3];
+  right[2].x = (p[2].x + p[3].x) * 0.5f;
+  right[2].y = (p[2].y + p[3].y) * 0.5f;
+  right[1].x = (mid.x + right[2].x) * 0.5f;
+  right[1].y = (mid.y + right[2].y) * 0.5f;
+
+  left[3].x = right[0].x = (left[2].x + right[1].x) * 0.5f;
+  left[3].y = right[0].y = (left[2].y + right[1].y) * 0.5f;
+
+  clutter_path_curve_flatten (samples, left,
+                              t0, (t0 + t1) * 0.5f,
+                              depth + 1,
+                              length);
+  clutter_path_curve_flatten (samples, right,
+                              (t0 + t1) * 0.5f, t1,
+                              depth + 1,
+                              length);
 }
 
 static void
@@ -1236,106 +1388,247 @@ clutter_path_ensure_node_data (ClutterPath *path)
 {
   ClutterPathPrivate *priv = path->priv;
 
-  /* Recalculate the nodes data if has changed */
+  /* Resolve the nodes into a flat array of absolute, floating point
+   * segments; each segment stores the cumulative length of the path
+   * up to its end, so that a position can be found with a binary
+   * search instead of walking the list of nodes
+   */
   if (priv->nodes_dirty)
     {
       GSList *l;
-      ClutterKnot last_position = { 0, 0 };
-      ClutterKnot loop_start = { 0, 0 };
-      ClutterKnot points[3];
+      ClutterPoint last_position = { 0, 0 };
+      ClutterPoint loop_start = { 0, 0 };
+      guint i;
+
+      clutter_path_clear_primitives (priv);
+
+      priv->n_segments = g_slist_length (priv->nodes);
+      priv->segments = g_renew (ClutterPathSegment,
+                                priv->segments,
+                                priv->n_segments);
 
-      priv->total_length = 0;
+      if (priv->samples == NULL)
+        priv->samples = g_array_new (FALSE, FALSE, sizeof (ClutterPathSample));
+      else
+        g_array_set_size (priv->samples, 0);
+
+      priv->total_length = 0.f;
 
-      for (l = priv->nodes; l; l = l->next)
+      for (l = priv->nodes, i = 0; l; l = l->next, i++)
         {
           ClutterPathNodeFull *node = l->data;
+          ClutterPathSegment *segment = priv->segments + i;
           gboolean relative = (node->k.type & CLUTTER_PATH_RELATIVE) != 0;
+          ClutterPoint origin = { 0, 0 };
+          gint j;
+
+          if (relative)
+            origin = last_position;
 
-          switch (node->k.type & ~CLUTTER_PATH_RELATIVE)
+          segment->type = node->k.type & ~CLUTTER_PATH_RELATIVE;
+          segment->first_sample = 0;
+          segment->n_samples = 0;
+          segment->length = 0.f;
+
+          /* Lines and moves only use the start point in points[0]
+           * and the end point in points[3]
+           */
+          segment->points[0] = last_position;
+
+          switch (segment->type)
             {
             case CLUTTER_PATH_MOVE_TO:
-              node->length = 0;
-
-              /* Store the actual position in point[1] */
-              if (relative)
-                {
-                  node->k.points[1].x = last_position.x + node->k.points[0].x;
-                  node->k.points[1].y = last_position.y + node->k.points[0].y;
-                }
-              else
-                node->k.points[1] = node->k.points[0];
+              segment->points[3].x = origin.x + node->k.points[0].x;
+              segment->points[3].y = origin.y + node->k.points[0].y;
+              segment->points[0] = segment->points[3];
 
-              last_position = node->k.points[1];
-              loop_start = node->k.points[1];
+              loop_start = segment->points[3];
               break;
 
             case CLUTTER_PATH_LINE_TO:
-              /* Use point[1] as the start point and point[2] as the end
-                 point */
-              node->k.points[1] = last_position;
+              segment->points[3].x = origin.x + node->k.points[0].x;
+              segment->points[3].y = origin.y + node->k.points[0].y;
 
-              if (relative)
+              segment->length = clutter_point_distance (&segment->points[0],
+                                                        &segment->points[3],
+                                                        NULL, NULL);
+              break;
+
+            case CLUTTER_PATH_CURVE_TO:
+              for (j = 0; j < 3; j++)
                 {
-                  node->k.points[2].x = (node->k.points[1].x
-                                         + node->k.points[0].x);
-                  node->k.points[2].y = (node->k.points[1].y
-                                         + node->k.points[0].y);
+                  segment->points[j + 1].x = origin.x + node->k.points[j].x;
+                  segment->points[j + 1].y = origin.y + node->k.points[j].y;
                 }
-              else
-                node->k.points[2] = node->k.points[0];
 
-              last_position = node->k.points[2];
+              /* Build the arc length table of the curve by subdividing
+               * it until each piece is flat enough to be measured as a
+               * line; the table maps the distance along the curve back
+               * to the curve parameter
+               */
+              segment->first_sample = priv->samples->len;
+              clutter_path_curve_flatten (priv->samples,
+                                          segment->points,
+                                          0.f, 1.f,
+                                          0,
+                                          &segment->length);
+              segment->n_samples = priv->samples->len - segment->first_sample;
+              break;
+
+            case CLUTTER_PATH_CLOSE:
+              /* Convert to a line from last_position to loop_start */
+              segment->points[3] = loop_start;
 
-              node->length = clutter_path_node_distance (node->k.points + 1,
-                                                         node->k.points + 2);
+              segment->length = clutter_point_distance (&segment->points[0],
+                                                        &segment->points[3],
+                                                        NULL, NULL);
               break;
+            }
 
-            case CLUTTER_PATH_CURVE_TO:
-              /* Convert to a bezier curve */
-              if (node->bezier == NULL)
-                node->bezier = _clutter_bezier_new ();
+          last_position = segment->points[3];
 
-              if (relative)
-                {
-                  int i;
+          priv->total_length += segment->length;
+          segment->end_distance = priv->total_length;
+        }
 
-                  for (i = 0; i < 3; i++)
-                    {
-                      points[i].x = last_position.x + node->k.points[i].x;
-                      points[i].y = last_position.y + node->k.points[i].y;
-                    }
-                }
-              else
-                memcpy (points, node->k.points, sizeof (ClutterKnot) * 3);
+      priv->nodes_dirty = FALSE;
+    }
+}
 
-              _clutter_bezier_init (node->bezier,
-                                    last_position.x, last_position.y,
-                                    points[0].x, points[0].y,
-                                    points[1].x, points[1].y,
-                                    points[2].x, points[2].y);
+/* Returns the index of the segment covering @distance, searching from
+ * the @first segment onwards; the segments before @first must end at,
+ * or before, @distance
+ */
+static guint
+clutter_path_find_segment (ClutterPathPrivate *priv,
+                           guint               first,
+                           gfloat              distance)
+{
+  guint lo = first, hi = priv->n_segments - 1;
 
-              last_position = points[2];
+  /* Find the first segment ending after the distance, or the last
+   * segment if the distance is past the end of the path
+   */
+  while (lo < hi)
+    {
+      guint mid = lo + (hi - lo) / 2;
 
-              node->length = _clutter_bezier_get_length (node->bezier);
+      if (priv->segments[mid].end_distance > distance)
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
 
-              break;
+  return lo;
+}
 
-            case CLUTTER_PATH_CLOSE:
-              /* Convert to a line to from last_point to loop_start */
-              node->k.points[1] = last_position;
-              node->k.points[2] = loop_start;
-              last_position = node->k.points[2];
+static void
+clutter_path_segment_get_point (ClutterPathPrivate       *priv,
+                                const ClutterPathSegment *segment,
+                                gfloat                    distance,
+                                ClutterPoint             *point)
+{
+  /* Convert the distance to a distance along the segment */
+  distance -= segment->end_distance - segment->length;
+  distance = CLAMP (distance, 0.f, segment->length);
 
-              node->length = clutter_path_node_distance (node->k.points + 1,
-                                                         node->k.points + 2);
-              break;
+  switch (segment->type)
+    {
+    case CLUTTER_PATH_MOVE_TO:
+      *point = segment->points[3];
+      break;
+
+    case CLUTTER_PATH_LINE_TO:
+    case CLUTTER_PATH_CLOSE:
+      if (segment->length == 0.f)
+        *point = segment->points[0];
+      else
+        {
+          gfloat t = distance / segment->length;
+
+          point->x = segment->points[0].x
+                   + (segment->points[3].x - segment->points[0].x) * t;
+          point->y = segment->points[0].y
+                   + (segment->points[3].y - segment->points[0].y) * t;
+        }
+      break;
+
+    case CLUTTER_PATH_CURVE_TO:
+      if (segment->length == 0.f)
+        *point = segment->points[3];
+      else
+        {
+          const ClutterPathSample *samples;
+          gfloat t0, d0, t;
+          guint lo, hi;
+
+          samples = &g_array_index (priv->samples, ClutterPathSample,
+                                    segment->first_sample);
+
+          /* Find the first sample at, or after, the distance */
+          lo = 0;
+          hi = segment->n_samples - 1;
+          while (lo < hi)
+            {
+              guint mid = lo + (hi - lo) / 2;
+
+              if (samples[mid].distance >= distance)
+                hi = mid;
+              else
+                lo = mid + 1;
+            }
+
+          if (lo == 0)
+            {
+              t0 = 0.f;
+              d0 = 0.f;
+            }
+          else
+            {
+              t0 = samples[lo - 1].t;
+              d0 = samples[lo - 1].distance;
             }
 
-          priv->total_length += node->length;
+          if (samples[lo].distance > d0)
+            t = t0 + (samples[lo].t - t0)
+              * (distance - d0) / (samples[lo].distance - d0);
+          else
+            t = samples[lo].t;
+
+          clutter_path_curve_get_point (segment->points, t, point);
         }
+      break;
+    }
+}
 
-      priv->nodes_dirty = FALSE;
+static guint
+clutter_path_get_point_internal (ClutterPath  *path,
+                                 gdouble       progress,
+                                 ClutterPoint *point)
+{
+  ClutterPathPrivate *priv = path->priv;
+  gfloat distance;
+  guint segment;
+
+  clutter_path_ensure_node_data (path);
+
+  /* Special case if the path is empty, just return 0,0 for want of
+     something better */
+  if (priv->n_segments == 0)
+    {
+      point->x = point->y = 0.f;
+      return 0;
     }
+
+  /* Convert the progress to a length along the path */
+  distance = progress * priv->total_length;
+
+  segment = clutter_path_find_segment (priv, 0, distance);
+  clutter_path_segment_get_point (priv, priv->segments + segment,
+                                  distance,
+                                  point);
+
+  return segment;
 }
 
 /**
@@ -1348,6 +1641,8 @@ clutter_path_ensure_node_data (ClutterPath *path)
  * 0.0 is the beginning and 1.0 is the end of the path. An
  * interpolated position is then stored in @position.
  *
+ * See also clutter_path_get_point().
+ *
  * Return value: index of the node used to calculate the position.
  *
  * Since: 1.0
@@ -1357,101 +1652,738 @@ clutter_path_get_position (ClutterPath *path,
                            gdouble progress,
                            ClutterKnot *position)
 {
-  ClutterPathPrivate *priv;
-  GSList *l;
-  guint point_distance, length = 0, node_num = 0;
-  ClutterPathNodeFull *node;
+  ClutterPoint point;
+  guint retval;
 
   g_return_val_if_fail (CLUTTER_IS_PATH (path), 0);
   g_return_val_if_fail (progress >= 0.0 && progress <= 1.0, 0);
 
+  retval = clutter_path_get_point_internal (path, progress, &point);
+
+  position->x = CLUTTER_NEARBYINT (point.x);
+  position->y = CLUTTER_NEARBYINT (point.y);
+
+  return retval;
+}
+
+/**
+ * clutter_path_get_point:
+ * @path: a #ClutterPath
+ * @progress: a position along the path as a fraction of its length
+ * @point: (out caller-allocates): location to store the position
+ *
+ * Floating point variant of clutter_path_get_position().
+ *
+ * The value in @progress represents a position along the path where
+ * 0.0 is the beginning and 1.0 is the end of the path. An
+ * interpolated position is then stored in @point, without rounding
+ * it to integer coordinates.
+ *
+ * Return value: index of the node used to calculate the position.
+ *
+ * Since: 1.26
+ */
+guint
+clutter_path_get_point (ClutterPath  *path,
+                        gdouble       progress,
+                        ClutterPoint *point)
+{
+  g_return_val_if_fail (CLUTTER_IS_PATH (path), 0);
+  g_return_val_if_fail (progress >= 0.0 && progress <= 1.0, 0);
+  g_return_val_if_fail (point != NULL, 0);
+
+  return clutter_path_get_point_internal (path, progress, point);
+}
+
+/**
+ * clutter_path_get_points:
+ * @path: a #ClutterPath
+ * @progress: (array length=n_points): positions along the path as
+ *   fractions of its length
+ * @n_points: the number of elements in @progress and @points
+ * @points: (array length=n_points) (out caller-allocates): return
+ *   location for the positions
+ *
+ * Evaluates the position of @n_points points along @path at the
+ * same time. The values in @progress are clamped between 0.0 and
+ * 1.0, and the interpolated position of each of them is stored in
+ * the corresponding element of @points.
+ *
+ * This function is more efficient than calling clutter_path_get_point()
+ * for each element of @progress, especially if @progress is sorted in
+ * increasing order.
+ *
+ * Since: 1.26
+ */
+void
+clutter_path_get_points (ClutterPath   *path,
+                         const gdouble *progress,
+                         guint          n_points,
+                         ClutterPoint  *points)
+{
+  ClutterPathPrivate *priv;
+  guint i, segment = 0;
+
+  g_return_if_fail (CLUTTER_IS_PATH (path));
+  g_return_if_fail (n_points == 0 || (progress != NULL && points != NULL));
+
   priv = path->priv;
 
   clutter_path_ensure_node_data (path);
 
-  /* Special case if the path is empty, just return 0,0 for want of
-     something better */
-  if (priv->nodes == NULL)
+  if (priv->n_segments == 0)
     {
-      memset (position, 0, sizeof (ClutterKnot));
-      return 0;
+      memset (points, 0, sizeof (ClutterPoint) * n_points);
+      return;
     }
 
-  /* Convert the progress to a length along the path */
-  point_distance = progress * priv->total_length;
+  for (i = 0; i < n_points; i++)
+    {
+      gfloat distance;
+
+      distance = CLAMP (progress[i], 0.0, 1.0) * priv->total_length;
+
+      /* Keep searching from the last segment as long as the progress
+       * keeps increasing, and start over otherwise
+       */
+      if (segment > 0 && priv->segments[segment - 1].end_distance > distance)
+        segment = 0;
+
+      segment = clutter_path_find_segment (priv, segment, distance);
+      clutter_path_segment_get_point (priv, priv->segments + segment,
+                                      distance,
+                                      points + i);
+    }
+}
+
+/**
+ * clutter_path_get_length:
+ * @path: a #ClutterPath
+ *
+ * Retrieves an approximation of the total length of the path.
+ *
+ * Return value: the length of the path.
+ *
+ * Since: 1.0
+ */
+guint
+clutter_path_get_length (ClutterPath *path)
+{
+  g_return_val_if_fail (CLUTTER_IS_PATH (path), 0);
+
+  clutter_path_ensure_node_data (path);
+
+  return (guint) path->priv->total_length;
+}
+
+static void
+clutter_path_add_contour_point (GArray             *points,
+                                GArray             *contours,
+                                const ClutterPoint *point)
+{
+  ClutterPathContour *contour;
+
+  contour = &g_array_index (contours, ClutterPathContour, contours->len - 1);
+
+  /* Skip degenerate segments */
+  if (contour->n_points > 0)
+    {
+      const ClutterPoint *last;
 
-  /* Find the node that covers this point */
-  for (l = priv->nodes;
-       l->next && point_distance >= (((ClutterPathNodeFull *) l->data)->length
-                                     + length);
-       l = l->next)
+      last = &g_array_index (points, ClutterPoint, points->len - 1);
+      if (fabsf (last->x - point->x) < TESSELLATION_EPSILON
+          && fabsf (last->y - point->y) < TESSELLATION_EPSILON)
+        return;
+    }
+
+  g_array_append_val (points, *point);
+  contour->n_points += 1;
+}
+
+static void
+clutter_path_begin_contour (GArray             *points,
+                            GArray             *contours,
+                            const ClutterPoint *start)
+{
+  ClutterPathContour contour;
+
+  contour.first_point = points->len;
+  contour.n_points = 0;
+  contour.closed = FALSE;
+  g_array_append_val (contours, contour);
+
+  clutter_path_add_contour_point (points, contours, start);
+}
+
+/* Flattens the path into a list of polygonal contours, one for each
+ * sub-path; curves are sampled at the points of their arc length table
+ */
+static void
+clutter_path_flatten (ClutterPath *path,
+                      GArray      *points,
+                      GArray      *contours)
+{
+  ClutterPathPrivate *priv = path->priv;
+  gboolean in_contour = FALSE;
+  guint i, j;
+
+  for (i = 0; i < priv->n_segments; i++)
     {
-      length += ((ClutterPathNodeFull *) l->data)->length;
-      node_num++;
+      const ClutterPathSegment *segment = priv->segments + i;
+      const ClutterPathSample *samples;
+      ClutterPathContour *contour;
+      ClutterPoint point;
+
+      if (segment->type == CLUTTER_PATH_MOVE_TO)
+        {
+          in_contour = FALSE;
+          continue;
+        }
+
+      if (!in_contour)
+        {
+          clutter_path_begin_contour (points, contours, &segment->points[0]);
+          in_contour = TRUE;
+        }
+
+      switch (segment->type)
+        {
+        case CLUTTER_PATH_LINE_TO:
+          clutter_path_add_contour_point (points, contours,
+                                          &segment->points[3]);
+          break;
+
+        case CLUTTER_PATH_CURVE_TO:
+          samples = &g_array_index (priv->samples, ClutterPathSample,
+                                    segment->first_sample);
+
+          for (j = 0; j < segment->n_samples; j++)
+            {
+              clutter_path_curve_get_point (segment->points,
+                                            samples[j].t,
+                                            &point);
+              clutter_path_add_contour_point (points, contours, &point);
+            }
+          break;
+
+        case CLUTTER_PATH_CLOSE:
+          contour = &g_array_index (contours, ClutterPathContour,
+                                    contours->len - 1);
+          contour->closed = TRUE;
+
+          /* Drop the last point if it is the same as the first, since
+           * closing the contour already connects them
+           */
+          if (contour->n_points > 1)
+            {
+              const ClutterPoint *first, *last;
+
+              first = &g_array_index (points, ClutterPoint,
+                                      contour->first_point);
+              last = &g_array_index (points, ClutterPoint, points->len - 1);
+
+              if (fabsf (last->x - first->x) < TESSELLATION_EPSILON
+                  && fabsf (last->y - first->y) < TESSELLATION_EPSILON)
+                {
+                  g_array_set_size (points, points->len - 1);
+                  contour->n_points -= 1;
+                }
+            }
+
+          in_contour = FALSE;
+          break;
+        }
     }
+}
+
+static void
+clutter_path_add_triangle (GArray             *vertices,
+                           const ClutterPoint *a,
+                           const ClutterPoint *b,
+                           const ClutterPoint *c)
+{
+  CoglVertexP2 triangle[3] = {
+    { a->x, a->y },
+    { b->x, b->y },
+    { c->x, c->y },
+  };
+
+  g_array_append_vals (vertices, triangle, 3);
+}
+
+static inline gfloat
+clutter_path_edge_get_x (const ClutterPathEdge *edge,
+                         gfloat                 y)
+{
+  return edge->x0 + (edge->x1 - edge->x0) * (y - edge->y0) / (edge->y1 - edge->y0);
+}
+
+static gboolean
+clutter_path_edge_intersect (const ClutterPathEdge *a,
+                             const ClutterPathEdge *b,
+                             gfloat                *y)
+{
+  gfloat dxa = a->x1 - a->x0, dya = a->y1 - a->y0;
+  gfloat dxb = b->x1 - b->x0, dyb = b->y1 - b->y0;
+  gfloat wx = b->x0 - a->x0, wy = b->y0 - a->y0;
+  gfloat denom, s, u;
+
+  denom = dxa * dyb - dya * dxb;
+  if (fabsf (denom) < TESSELLATION_EPSILON)
+    return FALSE;
 
-  node = l->data;
+  s = (wx * dyb - wy * dxb) / denom;
+  u = (wx * dya - wy * dxa) / denom;
+
+  if (s <= 0.f || s >= 1.f || u <= 0.f || u >= 1.f)
+    return FALSE;
+
+  *y = a->y0 + s * dya;
+
+  return TRUE;
+}
+
+static gint
+clutter_path_compare_floats (gconstpointer a,
+                             gconstpointer b)
+{
+  gfloat fa = *(const gfloat *) a, fb = *(const gfloat *) b;
+
+  return fa < fb ? -1 : (fa > fb ? 1 : 0);
+}
+
+static gint
+clutter_path_compare_edges (gconstpointer a,
+                            gconstpointer b)
+{
+  const ClutterPathEdge *ea = a, *eb = b;
+
+  return clutter_path_compare_floats (&ea->key, &eb->key);
+}
+
+/* Triangulates the path using the even-odd fill rule.
+ *
+ * The plane is cut in horizontal bands at the y coordinate of every
+ * vertex and of every intersection between two edges, so that the
+ * edges crossing a band never cross each other inside it; the inside
+ * of the path in each band is then a list of trapezoids between pairs
+ * of edges, sorted from left to right.
+ */
+static GArray *
+clutter_path_tessellate_fill (ClutterPath *path)
+{
+  GArray *points, *contours, *edges, *ys, *active, *vertices;
+  guint i, j;
 
-  /* Convert the point distance to a distance along the node */
-  point_distance -= length;
-  if (point_distance > node->length)
-    point_distance = node->length;
+  points = g_array_new (FALSE, FALSE, sizeof (ClutterPoint));
+  contours = g_array_new (FALSE, FALSE, sizeof (ClutterPathContour));
+  edges = g_array_new (FALSE, FALSE, sizeof (ClutterPathEdge));
+  ys = g_array_new (FALSE, FALSE, sizeof (gfloat));
+  active = g_array_new (FALSE, FALSE, sizeof (ClutterPathEdge));
+  vertices = g_array_new (FALSE, FALSE, sizeof (CoglVertexP2));
 
-  switch (node->k.type & ~CLUTTER_PATH_RELATIVE)
+  clutter_path_flatten (path, points, contours);
+
+  /* Every contour is implicitly closed when filling */
+  for (i = 0; i < contours->len; i++)
     {
-    case CLUTTER_PATH_MOVE_TO:
-      *position = node->k.points[1];
-      break;
+      const ClutterPathContour *contour;
+      const ClutterPoint *p;
 
-    case CLUTTER_PATH_LINE_TO:
-    case CLUTTER_PATH_CLOSE:
-      if (node->length == 0)
-        *position = node->k.points[1];
-      else
+      contour = &g_array_index (contours, ClutterPathContour, i);
+      if (contour->n_points < 3)
+        continue;
+
+      p = &g_array_index (points, ClutterPoint, contour->first_point);
+
+      for (j = 0; j < contour->n_points; j++)
         {
-          position->x = (node->k.points[1].x
-                         + ((node->k.points[2].x - node->k.points[1].x)
-                            * (gint) point_distance / (gint) node->length));
-          position->y = (node->k.points[1].y
-                         + ((node->k.points[2].y - node->k.points[1].y)
-                            * (gint) point_distance / (gint) node->length));
+          const ClutterPoint *a = p + j;
+          const ClutterPoint *b = p + (j + 1) % contour->n_points;
+          ClutterPathEdge edge;
+
+          g_array_append_val (ys, a->y);
+
+          if (a->y == b->y)
+            continue;
+
+          if (a->y < b->y)
+            {
+              edge.x0 = a->x;
+              edge.y0 = a->y;
+              edge.x1 = b->x;
+              edge.y1 = b->y;
+            }
+          else
+            {
+              edge.x0 = b->x;
+              edge.y0 = b->y;
+              edge.x1 = a->x;
+              edge.y1 = a->y;
+            }
+
+          edge.key = edge.y0;
+          g_array_append_val (edges, edge);
         }
-      break;
+    }
 
-    case CLUTTER_PATH_CURVE_TO:
-      if (node->length == 0)
-        *position = node->k.points[2];
-      else
+  /* Sorting the edges by their top lets us stop looking for
+   * intersections as soon as an edge starts below the current one
+   */
+  g_array_sort (edges, clutter_path_compare_edges);
+
+  for (i = 0; i < edges->len; i++)
+    {
+      const ClutterPathEdge *a = &g_array_index (edges, ClutterPathEdge, i);
+
+      for (j = i + 1; j < edges->len; j++)
         {
-          _clutter_bezier_advance (node->bezier,
-                                   point_distance * CLUTTER_BEZIER_MAX_LENGTH
-                                   / node->length,
-                                   position);
+          const ClutterPathEdge *b = &g_array_index (edges, ClutterPathEdge, j);
+          gfloat y;
+
+          if (b->y0 >= a->y1)
+            break;
+
+          if (clutter_path_edge_intersect (a, b, &y))
+            g_array_append_val (ys, y);
+        }
+    }
+
+  g_array_sort (ys, clutter_path_compare_floats);
+
+  for (i = 0; i + 1 < ys->len; i++)
+    {
+      gfloat y0 = g_array_index (ys, gfloat, i);
+      gfloat y1 = g_array_index (ys, gfloat, i + 1);
+      gfloat y_mid = (y0 + y1) * 0.5f;
+
+      if (y1 - y0 < TESSELLATION_EPSILON)
+        continue;
+
+      g_array_set_size (active, 0);
+
+      for (j = 0; j < edges->len; j++)
+        {
+          ClutterPathEdge edge = g_array_index (edges, ClutterPathEdge, j);
+
+          if (edge.y0 >= y1)
+            break;
+
+          if (edge.y1 <= y0)
+            continue;
+
+          edge.key = clutter_path_edge_get_x (&edge, y_mid);
+          g_array_append_val (active, edge);
         }
+
+      g_array_sort (active, clutter_path_compare_edges);
+
+      for (j = 0; j + 1 < active->len; j += 2)
+        {
+          const ClutterPathEdge *left, *right;
+          ClutterPoint tl, tr, br, bl;
+
+          left = &g_array_index (active, ClutterPathEdge, j);
+          right = &g_array_index (active, ClutterPathEdge, j + 1);
+
+          tl.x = clutter_path_edge_get_x (left, y0);
+          tl.y = y0;
+          tr.x = clutter_path_edge_get_x (right, y0);
+          tr.y = y0;
+          br.x = clutter_path_edge_get_x (right, y1);
+          br.y = y1;
+          bl.x = clutter_path_edge_get_x (left, y1);
+          bl.y = y1;
+
+          clutter_path_add_triangle (vertices, &tl, &tr, &br);
+          clutter_path_add_triangle (vertices, &tl, &br, &bl);
+        }
+    }
+
+  g_array_unref (points);
+  g_array_unref (contours);
+  g_array_unref (edges);
+  g_array_unref (ys);
+  g_array_unref (active);
+
+  return vertices;
+}
+
+static void
+clutter_path_stroke_join (GArray             *vertices,
+                          const ClutterPoint *p,
+                          const ClutterPoint *d0,
+                          const ClutterPoint *d1,
+                          gfloat              half_width,
+                          ClutterLineJoin     line_join)
+{
+  gfloat cross = d0->x * d1->y - d0->y * d1->x;
+  gfloat dot = d0->x * d1->x + d0->y * d1->y;
+  ClutterPoint a, b, m;
+  gfloat s;
+
+  /* Nothing to fill between collinear segments */
+  if (fabsf (cross) < TESSELLATION_EPSILON && dot > 0.f)
+    return;
+
+  /* The offset points of the two segments on the outer side of the
+   * corner; the inner side is covered by the segments themselves
+   */
+  s = cross > 0.f ? -half_width : half_width;
+  a.x = p->x - d0->y * s;
+  a.y = p->y + d0->x * s;
+  b.x = p->x - d1->y * s;
+  b.y = p->y + d1->x * s;
+
+  switch (line_join)
+    {
+    case CLUTTER_LINE_JOIN_MITER:
+      /* The miter is 1 / cos (angle / 2) times the half width */
+      if (1.f + dot >= 2.f / (MITER_LIMIT * MITER_LIMIT))
+        {
+          m.x = p->x + (a.x - p->x + b.x - p->x) / (1.f + dot);
+          m.y = p->y + (a.y - p->y + b.y - p->y) / (1.f + dot);
+
+          clutter_path_add_triangle (vertices, p, &a, &m);
+          clutter_path_add_triangle (vertices, p, &m, &b);
+        }
+      else
+        clutter_path_add_triangle (vertices, p, &a, &b);
+      break;
+
+    case CLUTTER_LINE_JOIN_ROUND:
+      {
+        gfloat start, sweep, step;
+        ClutterPoint prev, cur;
+        guint n_steps, k;
+
+        start = atan2f (a.y - p->y, a.x - p->x);
+        sweep = acosf (CLAMP (dot, -1.f, 1.f));
+        if (cross <= 0.f)
+          sweep = -sweep;
+
+        /* Keep each chord of the arc within the tolerance */
+        if (half_width > CURVE_TOLERANCE)
+          step = 2.f * acosf (1.f - CURVE_TOLERANCE / half_width);
+        else
+          step = G_PI_2;
+
+        n_steps = MAX (1, (guint) ceilf (fabsf (sweep) / step));
+
+        prev = a;
+        for (k = 1; k <= n_steps; k++)
+          {
+            gfloat angle = start + sweep * k / n_steps;
+
+            cur.x = p->x + half_width * cosf (angle);
+            cur.y = p->y + half_width * sinf (angle);
+
+            clutter_path_add_triangle (vertices, p, &prev, &cur);
+            prev = cur;
+          }
+      }
       break;
+
+    case CLUTTER_LINE_JOIN_BEVEL:
+      clutter_path_add_triangle (vertices, p, &a, &b);
+      break;
+    }
+}
+
+/* Builds a triangle mesh covering the outline of the path, with butt
+ * caps at the ends of open contours
+ */
+static GArray *
+clutter_path_tessellate_stroke (ClutterPath     *path,
+                                gfloat           line_width,
+                                ClutterLineJoin  line_join)
+{
+  GArray *points, *contours, *vertices;
+  gfloat half_width = line_width * 0.5f;
+  guint i, j;
+
+  points = g_array_new (FALSE, FALSE, sizeof (ClutterPoint));
+  contours = g_array_new (FALSE, FALSE, sizeof (ClutterPathContour));
+  vertices = g_array_new (FALSE, FALSE, sizeof (CoglVertexP2));
+
+  clutter_path_flatten (path, points, contours);
+
+  for (i = 0; i < contours->len; i++)
+    {
+      const ClutterPathContour *contour;
+      const ClutterPoint *p;
+      ClutterPoint first_d = { 0, }, prev_d = { 0, };
+      gboolean closed;
+      guint n_lines;
+
+      contour = &g_array_index (contours, ClutterPathContour, i);
+      if (contour->n_points < 2)
+        continue;
+
+      p = &g_array_index (points, ClutterPoint, contour->first_point);
+      closed = contour->closed && contour->n_points > 2;
+      n_lines = closed ? contour->n_points : contour->n_points - 1;
+
+      for (j = 0; j < n_lines; j++)
+        {
+          const ClutterPoint *a = p + j;
+          const ClutterPoint *b = p + (j + 1) % contour->n_points;
+          ClutterPoint d, a0, a1, b0, b1;
+          gfloat len;
+
+          len = clutter_point_distance (a, b, NULL, NULL);
+          if (len < TESSELLATION_EPSILON)
+            continue;
+
+          d.x = (b->x - a->x) / len;
+          d.y = (b->y - a->y) / len;
+
+          a0.x = a->x - d.y * half_width;
+          a0.y = a->y + d.x * half_width;
+          a1.x = a->x + d.y * half_width;
+          a1.y = a->y - d.x * half_width;
+          b0.x = b->x - d.y * half_width;
+          b0.y = b->y + d.x * half_width;
+          b1.x = b->x + d.y * half_width;
+          b1.y = b->y - d.x * half_width;
+
+          clutter_path_add_triangle (vertices, &a0, &a1, &b1);
+          clutter_path_add_triangle (vertices, &a0, &b1, &b0);
+
+          if (j == 0)
+            first_d = d;
+          else
+            clutter_path_stroke_join (vertices, a, &prev_d, &d,
+                                      half_width,
+                                      line_join);
+
+          prev_d = d;
+        }
+
+      if (closed)
+        clutter_path_stroke_join (vertices, p, &prev_d, &first_d,
+                                  half_width,
+                                  line_join);
     }
 
-  return node_num;
+  g_array_unref (points);
+  g_array_unref (contours);
+
+  return vertices;
+}
+
+static CoglPrimitive *
+clutter_path_create_primitive (GArray *vertices)
+{
+  CoglContext *ctx;
+  CoglPrimitive *primitive;
+
+  if (vertices->len == 0)
+    {
+      g_array_unref (vertices);
+      return NULL;
+    }
+
+  ctx = clutter_backend_get_cogl_context (clutter_get_default_backend ());
+  primitive = cogl_primitive_new_p2 (ctx, COGL_VERTICES_MODE_TRIANGLES,
+                                     vertices->len,
+                                     (CoglVertexP2 *) vertices->data);
+
+  g_array_unref (vertices);
+
+  return primitive;
 }
 
 /**
- * clutter_path_get_length:
+ * clutter_path_get_fill_primitive:
  * @path: a #ClutterPath
  *
- * Retrieves an approximation of the total length of the path.
+ * Retrieves a triangle mesh covering the inside of @path, using the
+ * even-odd fill rule; every sub-path is implicitly closed.
  *
- * Return value: the length of the path.
+ * The mesh is cached, and it is only rebuilt when the nodes of the
+ * path change, so drawing it is cheaper than filling an equivalent
+ * #CoglPath on every frame.
  *
- * Since: 1.0
+ * Return value: (transfer none): a #CoglPrimitive, owned by @path,
+ *   or %NULL if the path does not cover any area
+ *
+ * Since: 1.26
  */
-guint
-clutter_path_get_length (ClutterPath *path)
+CoglPrimitive *
+clutter_path_get_fill_primitive (ClutterPath *path)
 {
-  g_return_val_if_fail (CLUTTER_IS_PATH (path), 0);
+  ClutterPathPrivate *priv;
+
+  g_return_val_if_fail (CLUTTER_IS_PATH (path), NULL);
+
+  priv = path->priv;
+
+  clutter_path_ensure_node_data (path);
+
+  if (!priv->fill_valid)
+    {
+      priv->fill_primitive =
+        clutter_path_create_primitive (clutter_path_tessellate_fill (path));
+      priv->fill_valid = TRUE;
+    }
+
+  return priv->fill_primitive;
+}
+
+/**
+ * clutter_path_get_stroke_primitive:
+ * @path: a #ClutterPath
+ * @line_width: the width of the line
+ * @line_join: the shape of the corners of the line
+ *
+ * Retrieves a triangle mesh covering the outline of @path, stroked
+ * with a line of the given width; the ends of the sub-paths that are
+ * not closed are cut square at the end points.
+ *
+ * The mesh is cached, and it is only rebuilt when the nodes of the
+ * path, @line_width or @line_join change.
+ *
+ * The triangles of the mesh overlap at the corners of the path, so
+ * a translucent stroke should be painted with an opaque color in an
+ * offscreen layer, like #ClutterLayerNode, and blended from there.
+ *
+ * Return value: (transfer none): a #CoglPrimitive, owned by @path,
+ *   or %NULL if the path is empty
+ *
+ * Since: 1.26
+ */
+CoglPrimitive *
+clutter_path_get_stroke_primitive (ClutterPath     *path,
+                                   gfloat           line_width,
+                                   ClutterLineJoin  line_join)
+{
+  ClutterPathPrivate *priv;
+
+  g_return_val_if_fail (CLUTTER_IS_PATH (path), NULL);
+  g_return_val_if_fail (line_width > 0.f, NULL);
+
+  priv = path->priv;
 
   clutter_path_ensure_node_data (path);
 
-  return path->priv->total_length;
+  if (!priv->stroke_valid
+      || priv->stroke_width != line_width
+      || priv->stroke_join != line_join)
+    {
+      if (priv->stroke_primitive != NULL)
+        cogl_object_unref (priv->stroke_primitive);
+
+      priv->stroke_primitive =
+        clutter_path_create_primitive (clutter_path_tessellate_stroke (path,
+                                                                       line_width,
+                                                                       line_join));
+      priv->stroke_width = line_width;
+      priv->stroke_join = line_join;
+      priv->stroke_valid = TRUE;
+    }
+
+  return priv->stroke_primitive;
 }
 
 static ClutterPathNodeFull *
@@ -1463,9 +2395,6 @@ clutter_path_node_full_new (void)
 static void
 clutter_path_node_full_free (ClutterPathNodeFull *node)
 {
-  if (node->bezier)
-    _clutter_bezier_free (node->bezier);
-
   g_slice_free (ClutterPathNodeFull, node);
 }
 
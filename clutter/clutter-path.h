@@ -173,9 +173,27 @@ CLUTTER_AVAILABLE_IN_1_0
 guint        clutter_path_get_position         (ClutterPath           *path,
                                                 gdouble                progress,
                                                 ClutterKnot           *position);
+CLUTTER_AVAILABLE_IN_1_26
+guint        clutter_path_get_point            (ClutterPath           *path,
+                                                gdouble                progress,
+                                                ClutterPoint          *point);
+CLUTTER_AVAILABLE_IN_1_26
+void         clutter_path_get_points           (ClutterPath           *path,
+                                                const gdouble         *progress,
+                                                guint                  n_points,
+                                                ClutterPoint          *points);
 CLUTTER_AVAILABLE_IN_1_0
 guint        clutter_path_get_length           (ClutterPath           *path);
 
+#if defined(COGL_ENABLE_EXPERIMENTAL_API) && defined(CLUTTER_ENABLE_EXPERIMENTAL_API)
+CLUTTER_AVAILABLE_IN_1_26
+CoglPrimitive *clutter_path_get_fill_primitive   (ClutterPath     *path);
+CLUTTER_AVAILABLE_IN_1_26
+CoglPrimitive *clutter_path_get_stroke_primitive (ClutterPath     *path,
+                                                  gfloat           line_width,
+                                                  ClutterLineJoin  line_join);
+#endif /* COGL_ENABLE_EXPERIMENTAL_API && CLUTTER_ENABLE_EXPERIMENTAL_API */
+
 G_END_DECLS
 
 #endif /* __CLUTTER_PATH_H__ */
@@ -0,0 +1,81 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CLUTTER_PROFILER_PRIVATE_H__
+#define __CLUTTER_PROFILER_PRIVATE_H__
+
+#include <clutter/clutter-profiler.h>
+#include <clutter/clutter-stage.h>
+
+G_BEGIN_DECLS
+
+typedef enum {
+  CLUTTER_PROFILER_PHASE_EVENTS,
+  CLUTTER_PROFILER_PHASE_TIMELINES,
+  CLUTTER_PROFILER_PHASE_RELAYOUT,
+  CLUTTER_PROFILER_PHASE_PAINT_NODES,
+  CLUTTER_PROFILER_PHASE_PAINT,
+  CLUTTER_PROFILER_PHASE_PICK,
+  CLUTTER_PROFILER_PHASE_SWAP,
+
+  CLUTTER_PROFILER_N_PHASES
+} ClutterProfilerPhase;
+
+extern gboolean _clutter_profiler_running;
+extern gboolean _clutter_profiler_record_actors;
+
+/* Returns the start time of a measured section, or 0 if the profiler
+ * is not running; the value is meant to be passed to one of the
+ * functions below, which ignore it when it is 0
+ */
+#define _clutter_profiler_begin() \
+  (G_UNLIKELY (_clutter_profiler_running) ? g_get_monotonic_time () : 0)
+
+/* Returns the start time of an operation on an actor, or 0 if the
+ * profiler is not recording the costs of actors; the value must be
+ * passed to _clutter_profiler_actor_end()
+ */
+#define _clutter_profiler_actor_begin() \
+  (G_UNLIKELY (_clutter_profiler_record_actors) ? _clutter_profiler_actor_push () : 0)
+
+void    _clutter_profiler_init          (const gchar          *output);
+void    _clutter_profiler_init_actors   (const gchar          *output);
+
+void    _clutter_profiler_frame_begin   (void);
+void    _clutter_profiler_frame_end     (void);
+
+void    _clutter_profiler_end           (ClutterProfilerPhase  phase,
+                                         ClutterStage         *stage,
+                                         gint64                start);
+void    _clutter_profiler_accumulate    (ClutterProfilerPhase  phase,
+                                         gint64                start);
+void    _clutter_profiler_end_actor     (ClutterActor         *actor,
+                                         gint64                start);
+
+gint64  _clutter_profiler_actor_push    (void);
+void    _clutter_profiler_actor_end     (ClutterActor         *actor,
+                                         ClutterProfilerCost   cost,
+                                         gboolean              cache_miss,
+                                         gint64                start);
+void    _clutter_profiler_forget_actor  (ClutterActor         *actor);
+void    _clutter_profiler_forget_stage  (ClutterStage         *stage);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_PROFILER_PRIVATE_H__ */
@@ -0,0 +1,775 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:clutter-profiler
+ * @Title: Profiler
+ * @Short_Description: Frame timing and trace export
+ *
+ * Clutter can record how long each frame spends in its phases: event
+ * processing, advancing the timelines, relayout, building paint nodes,
+ * painting, picking, and waiting for the buffer swap, broken down by
+ * stage and by the class of the painted actors.
+ *
+ * The profiler is always compiled in, and it does not cost more than
+ * a branch per measured section when it is not running. Measurements
+ * are kept in a ring buffer holding the most recent events, which can
+ * be written to a file in the Trace Event format understood by the
+ * chrome://tracing viewer and by Perfetto, using
+ * clutter_profiler_write_trace().
+ *
+ * Setting the `CLUTTER_PROFILE` environment variable to the path of a
+ * file starts the profiler when Clutter is initialized, and writes the
+ * trace to that file when the application terminates.
+ *
+ * The profiler can also attribute the cost of painting, allocating and
+ * querying the preferred size to each actor, using
+ * clutter_profiler_set_record_actor_costs(); the costs are accumulated
+ * across frames, and can be queried using clutter_profiler_get_actor_cost()
+ * or written in the "folded stacks" format used to generate flame graphs,
+ * using clutter_profiler_write_actor_costs(). Setting the
+ * `CLUTTER_PROFILE_ACTORS` environment variable to the path of a file
+ * records the costs of the actors from initialization time, and writes
+ * them to that file when the application terminates.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "clutter-profiler-private.h"
+
+#include "clutter-actor-private.h"
+#include "clutter-debug.h"
+#include "clutter-private.h"
+
+/* the number of events kept in the ring buffer; must be a power of 2 */
+#define N_EVENTS        (1 << 16)
+
+typedef struct _ClutterProfilerEvent    ClutterProfilerEvent;
+
+struct _ClutterProfilerEvent
+{
+  /* static strings, or the name of a GType */
+  const gchar *name;
+  const gchar *category;
+
+  /* 0 for the master clock, or the index of a stage plus one */
+  guint track;
+
+  gint64 start;
+  gint64 duration;
+
+  /* only used by the frame events */
+  guint n_picks;
+  gint64 phases[CLUTTER_PROFILER_N_PHASES];
+};
+
+static const gchar *phase_names[CLUTTER_PROFILER_N_PHASES] = {
+  "Events",
+  "Timelines",
+  "Relayout",
+  "Paint nodes",
+  "Paint",
+  "Pick",
+  "Swap",
+};
+
+gboolean _clutter_profiler_running = FALSE;
+
+/* the ring buffer; the head is only ever increased, and the slot of
+ * an event is the value of the head when the event was reserved,
+ * modulo the size of the ring, so that writers do not need a lock
+ */
+static ClutterProfilerEvent *profiler_events = NULL;
+static volatile gint profiler_head = 0;
+
+/* the accumulated timings of the current frame */
+static gint64 profiler_frame_start = 0;
+static guint profiler_frame_picks = 0;
+static gint64 profiler_frame_phases[CLUTTER_PROFILER_N_PHASES];
+
+/* the stages seen by the profiler, and their names */
+static GHashTable *profiler_tracks = NULL;
+static GPtrArray *profiler_track_names = NULL;
+
+static gchar *profiler_output = NULL;
+
+gboolean _clutter_profiler_record_actors = FALSE;
+
+#define N_COSTS         (CLUTTER_PROFILER_COST_PREFERRED_SIZE + 1)
+
+static const gchar *cost_names[N_COSTS] = {
+  "paint",
+  "allocate",
+  "preferred-size",
+};
+
+/* a map from actors to an array of N_COSTS ClutterProfilerActorCost */
+static GHashTable *profiler_actor_costs = NULL;
+
+/* the time spent in the nested operations of each operation currently
+ * being measured, used to compute the exclusive time
+ */
+static GArray *profiler_actor_stack = NULL;
+
+static gchar *profiler_actors_output = NULL;
+
+static ClutterProfilerEvent *
+clutter_profiler_reserve_event (void)
+{
+  guint slot = (guint) g_atomic_int_add (&profiler_head, 1);
+
+  return &profiler_events[slot & (N_EVENTS - 1)];
+}
+
+static guint
+clutter_profiler_get_track (ClutterStage *stage)
+{
+  gpointer track;
+
+  if (stage == NULL)
+    return 0;
+
+  if (profiler_tracks == NULL)
+    {
+      profiler_tracks = g_hash_table_new (NULL, NULL);
+      profiler_track_names = g_ptr_array_new_with_free_func (g_free);
+      g_ptr_array_add (profiler_track_names, g_strdup ("Master clock"));
+    }
+
+  track = g_hash_table_lookup (profiler_tracks, stage);
+  if (track == NULL)
+    {
+      track = GUINT_TO_POINTER (profiler_track_names->len);
+
+      g_ptr_array_add (profiler_track_names,
+                       g_strdup (_clutter_actor_get_debug_name (CLUTTER_ACTOR (stage))));
+      g_hash_table_insert (profiler_tracks, stage, track);
+    }
+
+  return GPOINTER_TO_UINT (track);
+}
+
+/* the name of the track is kept, as the events recorded on it may
+ * still be in the ring buffer; a new stage allocated at the same
+ * address gets a new track
+ */
+void
+_clutter_profiler_forget_stage (ClutterStage *stage)
+{
+  if (profiler_tracks != NULL)
+    g_hash_table_remove (profiler_tracks, stage);
+}
+
+static void
+clutter_profiler_add_event (const gchar *name,
+                            const gchar *category,
+                            guint        track,
+                            gint64       start,
+                            gint64       end)
+{
+  ClutterProfilerEvent *event = clutter_profiler_reserve_event ();
+
+  event->name = name;
+  event->category = category;
+  event->track = track;
+  event->start = start;
+  event->duration = end - start;
+  event->n_picks = 0;
+}
+
+void
+_clutter_profiler_frame_begin (void)
+{
+  if (G_LIKELY (!_clutter_profiler_running))
+    return;
+
+  profiler_frame_start = g_get_monotonic_time ();
+  profiler_frame_picks = 0;
+  memset (profiler_frame_phases, 0, sizeof (profiler_frame_phases));
+}
+
+void
+_clutter_profiler_frame_end (void)
+{
+  ClutterProfilerEvent *event;
+
+  if (G_LIKELY (!_clutter_profiler_running))
+    return;
+
+  /* the profiler was started during the frame */
+  if (profiler_frame_start == 0)
+    return;
+
+  event = clutter_profiler_reserve_event ();
+  event->name = "Frame";
+  event->category = "frame";
+  event->track = 0;
+  event->start = profiler_frame_start;
+  event->duration = g_get_monotonic_time () - profiler_frame_start;
+  event->n_picks = profiler_frame_picks;
+  memcpy (event->phases, profiler_frame_phases, sizeof (event->phases));
+
+  profiler_frame_start = 0;
+}
+
+void
+_clutter_profiler_end (ClutterProfilerPhase  phase,
+                       ClutterStage         *stage,
+                       gint64                start)
+{
+  gint64 end;
+
+  if (start == 0 || !_clutter_profiler_running)
+    return;
+
+  end = g_get_monotonic_time ();
+
+  profiler_frame_phases[phase] += end - start;
+  if (phase == CLUTTER_PROFILER_PHASE_PICK)
+    profiler_frame_picks += 1;
+
+  clutter_profiler_add_event (phase_names[phase], "phase",
+                              clutter_profiler_get_track (stage),
+                              start, end);
+}
+
+void
+_clutter_profiler_accumulate (ClutterProfilerPhase phase,
+                              gint64               start)
+{
+  if (start == 0 || !_clutter_profiler_running)
+    return;
+
+  profiler_frame_phases[phase] += g_get_monotonic_time () - start;
+}
+
+void
+_clutter_profiler_end_actor (ClutterActor *actor,
+                             gint64        start)
+{
+  ClutterActor *stage;
+
+  if (start == 0 || !_clutter_profiler_running)
+    return;
+
+  stage = _clutter_actor_get_stage_internal (actor);
+
+  clutter_profiler_add_event (G_OBJECT_TYPE_NAME (actor), "actor",
+                              clutter_profiler_get_track ((ClutterStage *) stage),
+                              start, g_get_monotonic_time ());
+}
+
+static void
+clutter_profiler_write_at_exit (void)
+{
+  GError *error = NULL;
+
+  if (profiler_output == NULL)
+    return;
+
+  if (!clutter_profiler_write_trace (profiler_output, &error))
+    {
+      g_warning ("Unable to write the profiler trace to '%s': %s",
+                 profiler_output,
+                 error->message);
+      g_error_free (error);
+    }
+}
+
+static void
+clutter_profiler_write_actors_at_exit (void)
+{
+  GError *error = NULL;
+
+  if (profiler_actors_output == NULL)
+    return;
+
+  if (!clutter_profiler_write_actor_costs (profiler_actors_output, &error))
+    {
+      g_warning ("Unable to write the costs of the actors to '%s': %s",
+                 profiler_actors_output,
+                 error->message);
+      g_error_free (error);
+    }
+}
+
+/*< private >
+ * _clutter_profiler_init:
+ * @output: the path of the file the trace should be written to
+ *
+ * Starts the profiler, and writes the trace to @output when the
+ * process terminates.
+ */
+void
+_clutter_profiler_init (const gchar *output)
+{
+  if (profiler_output != NULL)
+    return;
+
+  profiler_output = g_strdup (output);
+  atexit (clutter_profiler_write_at_exit);
+
+  clutter_profiler_start ();
+}
+
+/**
+ * clutter_profiler_start:
+ *
+ * Starts recording the timings of each frame.
+ *
+ * Since: 1.26
+ */
+void
+clutter_profiler_start (void)
+{
+  if (profiler_events == NULL)
+    profiler_events = g_new0 (ClutterProfilerEvent, N_EVENTS);
+
+  profiler_frame_start = 0;
+
+  _clutter_profiler_running = TRUE;
+}
+
+/**
+ * clutter_profiler_stop:
+ *
+ * Stops recording the timings of each frame. The events recorded so
+ * far are kept, and can be written using clutter_profiler_write_trace().
+ *
+ * Since: 1.26
+ */
+void
+clutter_profiler_stop (void)
+{
+  _clutter_profiler_running = FALSE;
+}
+
+/**
+ * clutter_profiler_is_running:
+ *
+ * Checks whether the profiler is recording.
+ *
+ * Return value: %TRUE if the profiler is recording
+ *
+ * Since: 1.26
+ */
+gboolean
+clutter_profiler_is_running (void)
+{
+  return _clutter_profiler_running;
+}
+
+static void
+append_json_string (GString     *buffer,
+                    const gchar *str)
+{
+  const gchar *p;
+
+  g_string_append_c (buffer, '"');
+
+  for (p = str; *p != '\0'; p++)
+    {
+      if (*p == '"' || *p == '\\')
+        {
+          g_string_append_c (buffer, '\\');
+          g_string_append_c (buffer, *p);
+        }
+      else if ((guchar) *p < 0x20)
+        g_string_append_printf (buffer, "\\u%04x", (guint) *p);
+      else
+        g_string_append_c (buffer, *p);
+    }
+
+  g_string_append_c (buffer, '"');
+}
+
+/**
+ * clutter_profiler_write_trace:
+ * @filename: the path of the file to write
+ * @error: return location for a #GError, or %NULL
+ *
+ * Writes the events recorded by the profiler to @filename, using the
+ * JSON Trace Event format.
+ *
+ * Each frame is a complete event on the master clock track, with the
+ * time spent in each phase, and the number of picks, as arguments;
+ * the phases, and the painting of each actor, are complete events on
+ * the track of their stage, named after the phase or after the type
+ * of the actor, respectively.
+ *
+ * Return value: %TRUE if the file was written
+ *
+ * Since: 1.26
+ */
+gboolean
+clutter_profiler_write_trace (const gchar  *filename,
+                              GError      **error)
+{
+  GString *buffer;
+  guint head, n_events, i;
+  gboolean res;
+
+  g_return_val_if_fail (filename != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  buffer = g_string_new ("{\"traceEvents\":[\n");
+
+  if (profiler_track_names != NULL)
+    {
+      for (i = 0; i < profiler_track_names->len; i++)
+        {
+          g_string_append_printf (buffer,
+                                  "{\"name\":\"thread_name\",\"ph\":\"M\","
+                                  "\"pid\":0,\"tid\":%u,\"args\":{\"name\":",
+                                  i);
+          append_json_string (buffer, g_ptr_array_index (profiler_track_names, i));
+          g_string_append (buffer, "}},\n");
+        }
+    }
+
+  head = (guint) g_atomic_int_get (&profiler_head);
+  n_events = profiler_events != NULL ? MIN (head, N_EVENTS) : 0;
+
+  for (i = head - n_events; i != head; i++)
+    {
+      const ClutterProfilerEvent *event;
+      gint phase;
+
+      event = &profiler_events[i & (N_EVENTS - 1)];
+
+      g_string_append (buffer, "{\"name\":");
+      append_json_string (buffer, event->name);
+      g_string_append_printf (buffer,
+                              ",\"cat\":\"%s\",\"ph\":\"X\","
+                              "\"pid\":0,\"tid\":%u,"
+                              "\"ts\":%" G_GINT64_FORMAT ","
+                              "\"dur\":%" G_GINT64_FORMAT,
+                              event->category,
+                              event->track,
+                              event->start,
+                              event->duration);
+
+      if (strcmp (event->category, "frame") == 0)
+        {
+          g_string_append_printf (buffer, ",\"args\":{\"picks\":%u", event->n_picks);
+
+          for (phase = 0; phase < CLUTTER_PROFILER_N_PHASES; phase++)
+            g_string_append_printf (buffer, ",\"%s\":%" G_GINT64_FORMAT,
+                                    phase_names[phase],
+                                    event->phases[phase]);
+
+          g_string_append_c (buffer, '}');
+        }
+
+      g_string_append (buffer, "},\n");
+    }
+
+  /* the trailing metadata event avoids dealing with the trailing comma */
+  g_string_append (buffer,
+                   "{\"name\":\"process_name\",\"ph\":\"M\","
+                   "\"pid\":0,\"args\":{\"name\":");
+  append_json_string (buffer, g_get_prgname () != NULL ? g_get_prgname () : "clutter");
+  g_string_append (buffer, "}}\n]}\n");
+
+  res = g_file_set_contents (filename, buffer->str, buffer->len, error);
+
+  g_string_free (buffer, TRUE);
+
+  return res;
+}
+
+/*< private >
+ * _clutter_profiler_init_actors:
+ * @output: the path of the file the costs should be written to
+ *
+ * Starts recording the costs of the actors, and writes them to @output
+ * when the process terminates.
+ */
+void
+_clutter_profiler_init_actors (const gchar *output)
+{
+  if (profiler_actors_output != NULL)
+    return;
+
+  profiler_actors_output = g_strdup (output);
+  atexit (clutter_profiler_write_actors_at_exit);
+
+  clutter_profiler_set_record_actor_costs (TRUE);
+}
+
+gint64
+_clutter_profiler_actor_push (void)
+{
+  gint64 child_time = 0;
+
+  if (profiler_actor_stack == NULL)
+    profiler_actor_stack = g_array_new (FALSE, FALSE, sizeof (gint64));
+
+  g_array_append_val (profiler_actor_stack, child_time);
+
+  return g_get_monotonic_time ();
+}
+
+void
+_clutter_profiler_actor_end (ClutterActor        *actor,
+                             ClutterProfilerCost  cost,
+                             gboolean             cache_miss,
+                             gint64               start)
+{
+  ClutterProfilerActorCost *costs;
+  gint64 inclusive_time, child_time;
+  guint depth;
+
+  /* the stack has to be unwound even if the recording was stopped
+   * in the middle of the operation
+   */
+  if (start == 0)
+    return;
+
+  inclusive_time = g_get_monotonic_time () - start;
+
+  depth = profiler_actor_stack->len - 1;
+  child_time = g_array_index (profiler_actor_stack, gint64, depth);
+  g_array_set_size (profiler_actor_stack, depth);
+
+  if (depth > 0)
+    g_array_index (profiler_actor_stack, gint64, depth - 1) += inclusive_time;
+
+  if (!_clutter_profiler_record_actors)
+    return;
+
+  if (profiler_actor_costs == NULL)
+    profiler_actor_costs = g_hash_table_new_full (NULL, NULL, NULL, g_free);
+
+  costs = g_hash_table_lookup (profiler_actor_costs, actor);
+  if (costs == NULL)
+    {
+      costs = g_new0 (ClutterProfilerActorCost, N_COSTS);
+      g_hash_table_insert (profiler_actor_costs, actor, costs);
+    }
+
+  costs[cost].n_calls += 1;
+  if (cache_miss)
+    costs[cost].n_cache_misses += 1;
+
+  costs[cost].inclusive_time += inclusive_time;
+  costs[cost].exclusive_time += inclusive_time - child_time;
+}
+
+void
+_clutter_profiler_forget_actor (ClutterActor *actor)
+{
+  if (profiler_actor_costs != NULL)
+    g_hash_table_remove (profiler_actor_costs, actor);
+}
+
+/**
+ * clutter_profiler_set_record_actor_costs:
+ * @record: whether the costs of the actors should be recorded
+ *
+ * Sets whether the profiler should record the cost of painting,
+ * allocating and querying the preferred size of each actor.
+ *
+ * Recording the costs of the actors is independent from recording
+ * the timings of each frame, and has a higher overhead.
+ *
+ * Since: 1.26
+ */
+void
+clutter_profiler_set_record_actor_costs (gboolean record)
+{
+  _clutter_profiler_record_actors = !!record;
+}
+
+/**
+ * clutter_profiler_get_record_actor_costs:
+ *
+ * Retrieves whether the profiler is recording the costs of the actors.
+ *
+ * Return value: %TRUE if the costs of the actors are recorded
+ *
+ * Since: 1.26
+ */
+gboolean
+clutter_profiler_get_record_actor_costs (void)
+{
+  return _clutter_profiler_record_actors;
+}
+
+/**
+ * clutter_profiler_get_actor_cost:
+ * @actor: a #ClutterActor
+ * @cost: the operation to query
+ * @retval: (out caller-allocates): return location for the cost
+ *
+ * Retrieves the accumulated cost of @cost for @actor, since the
+ * costs were last reset using clutter_profiler_reset_actor_costs().
+ *
+ * The costs of an actor are discarded when the actor is finalized.
+ *
+ * Return value: %TRUE if any cost was recorded for @actor
+ *
+ * Since: 1.26
+ */
+gboolean
+clutter_profiler_get_actor_cost (ClutterActor             *actor,
+                                 ClutterProfilerCost       cost,
+                                 ClutterProfilerActorCost *retval)
+{
+  ClutterProfilerActorCost *costs = NULL;
+
+  g_return_val_if_fail (CLUTTER_IS_ACTOR (actor), FALSE);
+  g_return_val_if_fail (cost < N_COSTS, FALSE);
+  g_return_val_if_fail (retval != NULL, FALSE);
+
+  if (profiler_actor_costs != NULL)
+    costs = g_hash_table_lookup (profiler_actor_costs, actor);
+
+  if (costs == NULL)
+    {
+      memset (retval, 0, sizeof (ClutterProfilerActorCost));
+      return FALSE;
+    }
+
+  *retval = costs[cost];
+
+  return TRUE;
+}
+
+/**
+ * clutter_profiler_reset_actor_costs:
+ *
+ * Discards the costs recorded for all actors.
+ *
+ * Since: 1.26
+ */
+void
+clutter_profiler_reset_actor_costs (void)
+{
+  if (profiler_actor_costs != NULL)
+    g_hash_table_remove_all (profiler_actor_costs);
+}
+
+static void
+append_folded_frame (GString      *buffer,
+                     ClutterActor *actor)
+{
+  const gchar *name = clutter_actor_get_name (actor);
+  gsize start = buffer->len;
+  gsize i;
+
+  g_string_append (buffer, G_OBJECT_TYPE_NAME (actor));
+
+  if (name != NULL)
+    {
+      g_string_append_c (buffer, ':');
+      g_string_append (buffer, name);
+    }
+
+  /* semicolons separate frames, and new lines separate stacks */
+  for (i = start; i < buffer->len; i++)
+    {
+      if (buffer->str[i] == ';' || buffer->str[i] == '\n')
+        buffer->str[i] = '_';
+    }
+}
+
+static void
+append_folded_stack (GString      *buffer,
+                     ClutterActor *actor)
+{
+  ClutterActor *parent = clutter_actor_get_parent (actor);
+
+  if (parent != NULL)
+    {
+      append_folded_stack (buffer, parent);
+      g_string_append_c (buffer, ';');
+    }
+
+  append_folded_frame (buffer, actor);
+}
+
+/**
+ * clutter_profiler_write_actor_costs:
+ * @filename: the path of the file to write
+ * @error: return location for a #GError, or %NULL
+ *
+ * Writes the costs recorded for each actor to @filename, using the
+ * "folded stacks" format, which can be used to generate a flame graph.
+ *
+ * Each line contains the kind of operation and the path of the actor
+ * from its top-level, separated by semicolons, followed by the
+ * exclusive time of the operation on the actor, in microseconds; for
+ * instance:
+ *
+ * |[
+ *   paint;ClutterStage;ClutterActor:toolbar;ClutterText 1250
+ * ]|
+ *
+ * Return value: %TRUE if the file was written
+ *
+ * Since: 1.26
+ */
+gboolean
+clutter_profiler_write_actor_costs (const gchar  *filename,
+                                    GError      **error)
+{
+  GHashTableIter iter;
+  gpointer key, value;
+  GString *buffer;
+  gboolean res;
+
+  g_return_val_if_fail (filename != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  buffer = g_string_new (NULL);
+
+  if (profiler_actor_costs != NULL)
+    {
+      g_hash_table_iter_init (&iter, profiler_actor_costs);
+      while (g_hash_table_iter_next (&iter, &key, &value))
+        {
+          const ClutterProfilerActorCost *costs = value;
+          gint cost;
+
+          for (cost = 0; cost < N_COSTS; cost++)
+            {
+              if (costs[cost].n_calls == 0)
+                continue;
+
+              g_string_append (buffer, cost_names[cost]);
+              g_string_append_c (buffer, ';');
+              append_folded_stack (buffer, key);
+              g_string_append_printf (buffer, " %" G_GINT64_FORMAT "\n",
+                                      costs[cost].exclusive_time);
+            }
+        }
+    }
+
+  res = g_file_set_contents (filename, buffer->str, buffer->len, error);
+
+  g_string_free (buffer, TRUE);
+
+  return res;
+}
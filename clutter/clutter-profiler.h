@@ -0,0 +1,84 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CLUTTER_PROFILER_H__
+#define __CLUTTER_PROFILER_H__
+
+#if !defined(__CLUTTER_H_INSIDE__) && !defined(CLUTTER_COMPILATION)
+#error "Only <clutter/clutter.h> can be included directly."
+#endif
+
+#include <clutter/clutter-types.h>
+
+G_BEGIN_DECLS
+
+typedef struct _ClutterProfilerActorCost        ClutterProfilerActorCost;
+
+/**
+ * ClutterProfilerActorCost:
+ * @n_calls: the number of times the operation was performed
+ * @n_cache_misses: the number of times the operation could not use
+ *   a cached result; only recorded for %CLUTTER_PROFILER_COST_ALLOCATE
+ *   and %CLUTTER_PROFILER_COST_PREFERRED_SIZE
+ * @inclusive_time: the time spent in the operation, in microseconds,
+ *   including the time spent in the same, or other, operations on
+ *   other actors
+ * @exclusive_time: the time spent in the operation, in microseconds,
+ *   excluding the time spent in operations on other actors
+ *
+ * The accumulated cost of an operation on a #ClutterActor.
+ *
+ * Since: 1.26
+ */
+struct _ClutterProfilerActorCost
+{
+  guint n_calls;
+  guint n_cache_misses;
+
+  gint64 inclusive_time;
+  gint64 exclusive_time;
+};
+
+CLUTTER_AVAILABLE_IN_1_26
+void            clutter_profiler_start          (void);
+CLUTTER_AVAILABLE_IN_1_26
+void            clutter_profiler_stop           (void);
+CLUTTER_AVAILABLE_IN_1_26
+gboolean        clutter_profiler_is_running     (void);
+CLUTTER_AVAILABLE_IN_1_26
+gboolean        clutter_profiler_write_trace    (const gchar  *filename,
+                                                 GError      **error);
+
+CLUTTER_AVAILABLE_IN_1_26
+void            clutter_profiler_set_record_actor_costs (gboolean record);
+CLUTTER_AVAILABLE_IN_1_26
+gboolean        clutter_profiler_get_record_actor_costs (void);
+CLUTTER_AVAILABLE_IN_1_26
+gboolean        clutter_profiler_get_actor_cost         (ClutterActor             *actor,
+                                                         ClutterProfilerCost       cost,
+                                                         ClutterProfilerActorCost *retval);
+CLUTTER_AVAILABLE_IN_1_26
+void            clutter_profiler_reset_actor_costs      (void);
+CLUTTER_AVAILABLE_IN_1_26
+gboolean        clutter_profiler_write_actor_costs      (const gchar              *filename,
+                                                         GError                  **error);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_PROFILER_H__ */
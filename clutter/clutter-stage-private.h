@@ -94,6 +94,8 @@ gint32          _clutter_stage_acquire_pick_id          (ClutterStage *stage,
                                                          ClutterActor *actor);
 void            _clutter_stage_release_pick_id          (ClutterStage *stage,
                                                          gint32        pick_id);
+void            _clutter_stage_reserve_pick_ids         (ClutterStage *stage,
+                                                         guint         n_ids);
 ClutterActor *  _clutter_stage_get_actor_by_pick_id     (ClutterStage *stage,
                                                          gint32        pick_id);
 
@@ -71,6 +71,7 @@
 #include "clutter-master-clock.h"
 #include "clutter-paint-volume-private.h"
 #include "clutter-private.h"
+#include "clutter-profiler-private.h"
 #include "clutter-stage-manager-private.h"
 #include "clutter-stage-private.h"
 #include "clutter-version.h" 	/* For flavour */
@@ -104,6 +105,45 @@ struct _ClutterStageQueueRedrawEntry
   ClutterPaintVolume clip;
 };
 
+/* The number of pixel buffers used for asynchronous read-backs */
+#define N_READ_BACK_SLOTS       3
+
+/* The number of frames after which a read-back is delivered */
+#define READ_BACK_LATENCY       2
+
+typedef struct _ClutterStageReadBack
+{
+  gint x;
+  gint y;
+  gint width;
+  gint height;
+
+  guchar *buffer;
+  gint rowstride;
+
+  ClutterStageReadPixelsFunc func;
+  gpointer user_data;
+  GDestroyNotify notify;
+
+  /* the order in which the read-backs are delivered */
+  guint serial;
+
+  /* the frame in which the pixels were read */
+  guint frame;
+  guint failed : 1;
+} ClutterStageReadBack;
+
+typedef struct _ClutterStageReadBackSlot
+{
+  /* the read-back in flight, or NULL if the slot is free */
+  ClutterStageReadBack *read_back;
+
+  /* a bitmap backed by a pixel buffer, reused by the following
+   * read-backs as long as they have the same size
+   */
+  CoglBitmap *bitmap;
+} ClutterStageReadBackSlot;
+
 struct _ClutterStagePrivate
 {
   /* the stage implementation */
@@ -139,6 +179,17 @@ struct _ClutterStagePrivate
 
   ClutterIDPool *pick_id_pool;
 
+  /* read-backs waiting for the next frame */
+  GQueue pending_read_backs;
+
+  /* read-backs recorded into a pixel buffer, and waiting for the
+   * GPU to complete them
+   */
+  ClutterStageReadBackSlot read_back_slots[N_READ_BACK_SLOTS];
+  guint n_read_backs_in_flight;
+  guint read_back_frame;
+  guint read_back_serial;
+
 #ifdef CLUTTER_ENABLE_DEBUG
   gulong redraw_count;
 #endif /* CLUTTER_ENABLE_DEBUG */
@@ -617,6 +668,197 @@ _clutter_stage_update_active_framebuffer (ClutterStage *stage)
     priv->active_framebuffer = cogl_get_draw_framebuffer ();
 }
 
+static void
+clutter_stage_read_back_free (ClutterStageReadBack *read_back)
+{
+  if (read_back->notify != NULL)
+    read_back->notify (read_back->user_data);
+
+  g_slice_free (ClutterStageReadBack, read_back);
+}
+
+static ClutterStageReadBackSlot *
+clutter_stage_get_oldest_read_back (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  ClutterStageReadBackSlot *retval = NULL;
+  gint i;
+
+  for (i = 0; i < N_READ_BACK_SLOTS; i++)
+    {
+      ClutterStageReadBackSlot *slot = &priv->read_back_slots[i];
+
+      if (slot->read_back == NULL)
+        continue;
+
+      if (retval == NULL || slot->read_back->serial < retval->read_back->serial)
+        retval = slot;
+    }
+
+  return retval;
+}
+
+/* Delivers the pixels of the read-back in @slot, and frees the slot.
+ *
+ * Mapping the pixel buffer blocks until the GPU has finished writing
+ * into it, which is why read-backs are delivered a few frames after
+ * they have been recorded.
+ */
+static void
+clutter_stage_deliver_read_back (ClutterStage             *stage,
+                                 ClutterStageReadBackSlot *slot)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  ClutterStageReadBack *read_back = slot->read_back;
+  CoglBitmap *bitmap = slot->bitmap;
+  CoglBuffer *buffer = NULL;
+  const guchar *pixels = NULL;
+  guint8 *data = NULL;
+  gint rowstride = 0;
+
+  /* we take the bitmap out of the slot, in case the stage is painted
+   * again from within the callback while the buffer is still mapped
+   */
+  slot->read_back = NULL;
+  slot->bitmap = NULL;
+  priv->n_read_backs_in_flight -= 1;
+
+  if (!read_back->failed)
+    {
+      buffer = COGL_BUFFER (cogl_bitmap_get_buffer (bitmap));
+      data = cogl_buffer_map (buffer, COGL_BUFFER_ACCESS_READ, 0);
+    }
+
+  if (data != NULL)
+    {
+      rowstride = cogl_bitmap_get_rowstride (bitmap);
+
+      if (read_back->buffer != NULL)
+        {
+          gint i;
+
+          for (i = 0; i < read_back->height; i++)
+            memcpy (read_back->buffer + i * read_back->rowstride,
+                    data + i * rowstride,
+                    read_back->width * 4);
+
+          pixels = read_back->buffer;
+          rowstride = read_back->rowstride;
+        }
+      else
+        pixels = data;
+    }
+
+  read_back->func (stage,
+                   pixels,
+                   read_back->width,
+                   read_back->height,
+                   rowstride,
+                   read_back->user_data);
+
+  if (data != NULL)
+    cogl_buffer_unmap (buffer);
+
+  if (slot->bitmap == NULL)
+    slot->bitmap = bitmap;
+  else
+    cogl_object_unref (bitmap);
+
+  clutter_stage_read_back_free (read_back);
+}
+
+/* Delivers the read-backs that were recorded at least READ_BACK_LATENCY
+ * frames ago, or all of them if @flush is %TRUE
+ */
+static void
+clutter_stage_dispatch_read_backs (ClutterStage *stage,
+                                   gboolean      flush)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  ClutterStageReadBackSlot *slot;
+
+  if (priv->n_read_backs_in_flight == 0)
+    return;
+
+  g_object_ref (stage);
+
+  while ((slot = clutter_stage_get_oldest_read_back (stage)) != NULL)
+    {
+      if (!flush &&
+          priv->read_back_frame - slot->read_back->frame < READ_BACK_LATENCY)
+        break;
+
+      clutter_stage_deliver_read_back (stage, slot);
+    }
+
+  g_object_unref (stage);
+}
+
+/* Records the pending read-backs into pixel buffers; this is called at
+ * the end of each paint, before the stage window swaps its buffers, so
+ * that the GPU can copy the pixels without stalling the pipeline.
+ *
+ * The read-backs that do not fit in a free pixel buffer are left in
+ * the pending queue.
+ */
+static void
+clutter_stage_record_read_backs (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  ClutterBackend *backend = clutter_get_default_backend ();
+  CoglContext *ctx = clutter_backend_get_cogl_context (backend);
+  ClutterStageReadBack *read_back;
+
+  while ((read_back = g_queue_peek_head (&priv->pending_read_backs)) != NULL)
+    {
+      ClutterStageReadBackSlot *slot = NULL;
+      gint i;
+
+      for (i = 0; i < N_READ_BACK_SLOTS; i++)
+        {
+          if (priv->read_back_slots[i].read_back == NULL)
+            {
+              slot = &priv->read_back_slots[i];
+              break;
+            }
+        }
+
+      /* if all the pixel buffers are in use, mapping the oldest one
+       * would stall the frame until the GPU is done with it; the
+       * remaining read-backs are recorded in one of the following
+       * frames instead
+       */
+      if (slot == NULL)
+        break;
+
+      g_queue_pop_head (&priv->pending_read_backs);
+
+      if (slot->bitmap == NULL ||
+          cogl_bitmap_get_width (slot->bitmap) != read_back->width ||
+          cogl_bitmap_get_height (slot->bitmap) != read_back->height)
+        {
+          if (slot->bitmap != NULL)
+            cogl_object_unref (slot->bitmap);
+
+          slot->bitmap = cogl_bitmap_new_with_size (ctx,
+                                                    read_back->width,
+                                                    read_back->height,
+                                                    COGL_PIXEL_FORMAT_RGBA_8888);
+        }
+
+      read_back->frame = priv->read_back_frame;
+      read_back->failed =
+        !cogl_framebuffer_read_pixels_into_bitmap (priv->active_framebuffer,
+                                                   read_back->x,
+                                                   read_back->y,
+                                                   COGL_READ_PIXELS_COLOR_BUFFER,
+                                                   slot->bitmap);
+
+      slot->read_back = read_back;
+      priv->n_read_backs_in_flight += 1;
+    }
+}
+
 /* This provides a common point of entry for painting the scenegraph
  * for picking or painting...
  *
@@ -634,10 +876,18 @@ _clutter_stage_do_paint (ClutterStage                *stage,
   float viewport[4];
   cairo_rectangle_int_t geom;
   int window_scale;
+  gint64 profile_start = 0;
 
   if (priv->impl == NULL)
     return;
 
+  /* picking paints the stage as well, but it is measured on its own;
+   * the buffer swap, which follows the paint, is measured by the stage
+   * window implementation
+   */
+  if (_clutter_context_get_pick_mode () == CLUTTER_PICK_NONE)
+    profile_start = _clutter_profiler_begin ();
+
   _clutter_stage_window_get_geometry (priv->impl, &geom);
   window_scale = _clutter_stage_window_get_scale_factor (priv->impl);
 
@@ -687,6 +937,13 @@ _clutter_stage_do_paint (ClutterStage                *stage,
   clutter_actor_paint (CLUTTER_ACTOR (stage));
 
   g_signal_emit (stage, stage_signals[AFTER_PAINT], 0);
+
+  /* the pick buffer is not the contents of the stage */
+  if (!g_queue_is_empty (&priv->pending_read_backs) &&
+      _clutter_context_get_pick_mode () == CLUTTER_PICK_NONE)
+    clutter_stage_record_read_backs (stage);
+
+  _clutter_profiler_end (CLUTTER_PROFILER_PHASE_PAINT, stage, profile_start);
 }
 
 /* If we don't implement this here, we get the paint function
@@ -959,6 +1216,30 @@ _clutter_stage_has_queued_events (ClutterStage *stage)
   return priv->event_queue->length > 0;
 }
 
+static inline gboolean
+clutter_event_is_raw_motion (const ClutterEvent *event)
+{
+  return event->type == CLUTTER_MOTION &&
+         (event->motion.flags & CLUTTER_EVENT_FLAG_RAW) != 0;
+}
+
+/* Raw motion events are interleaved with the regular motion events of
+ * the same device; they carry the relative motion of the device, so
+ * they are never compressed, and they are skipped when looking for the
+ * event following a regular one
+ */
+static ClutterEvent *
+clutter_stage_get_next_event (GList *l)
+{
+  for (l = l->next; l != NULL; l = l->next)
+    {
+      if (!clutter_event_is_raw_motion (l->data))
+        return l->data;
+    }
+
+  return NULL;
+}
+
 void
 _clutter_stage_process_queued_events (ClutterStage *stage)
 {
@@ -991,7 +1272,7 @@ _clutter_stage_process_queued_events (ClutterStage *stage)
       gboolean check_device = FALSE;
 
       event = l->data;
-      next_event = l->next ? l->next->data : NULL;
+      next_event = clutter_stage_get_next_event (l);
 
       device = clutter_event_get_device (event);
 
@@ -1007,6 +1288,7 @@ _clutter_stage_process_queued_events (ClutterStage *stage)
       if (priv->throttle_motion_events && next_event != NULL)
         {
           if (event->type == CLUTTER_MOTION &&
+              !clutter_event_is_raw_motion (event) &&
               (next_event->type == CLUTTER_MOTION ||
                next_event->type == CLUTTER_LEAVE) &&
               (!check_device || (device == next_device)))
@@ -1058,7 +1340,9 @@ _clutter_stage_needs_update (ClutterStage *stage)
 
   priv = stage->priv;
 
-  return priv->relayout_pending || priv->redraw_pending;
+  return priv->relayout_pending ||
+         priv->redraw_pending ||
+         priv->n_read_backs_in_flight > 0;
 }
 
 void
@@ -1075,12 +1359,17 @@ _clutter_stage_maybe_relayout (ClutterActor *actor)
   /* avoid reentrancy */
   if (!CLUTTER_ACTOR_IN_RELAYOUT (stage))
     {
+      gint64 profile_start = _clutter_profiler_begin ();
+
       priv->relayout_pending = FALSE;
 
       CLUTTER_NOTE (ACTOR, "Recomputing layout");
 
       CLUTTER_SET_PRIVATE_FLAGS (stage, CLUTTER_IN_RELAYOUT);
 
+      /* the allocation changes are notified once the layout is done */
+      _clutter_actor_push_deferred_notify ();
+
       natural_width = natural_height = 0;
       clutter_actor_get_preferred_size (CLUTTER_ACTOR (stage),
                                         NULL, NULL,
@@ -1099,6 +1388,12 @@ _clutter_stage_maybe_relayout (ClutterActor *actor)
                               &box, CLUTTER_ALLOCATION_NONE);
 
       CLUTTER_UNSET_PRIVATE_FLAGS (stage, CLUTTER_IN_RELAYOUT);
+
+      _clutter_actor_pop_deferred_notify ();
+
+      _clutter_profiler_end (CLUTTER_PROFILER_PHASE_RELAYOUT,
+                             stage,
+                             profile_start);
     }
 }
 
@@ -1174,12 +1469,32 @@ _clutter_stage_do_update (ClutterStage *stage)
   if (!CLUTTER_ACTOR_IS_REALIZED (stage))
     return FALSE;
 
+  /* deliver the read-backs recorded during the previous frames */
+  if (priv->n_read_backs_in_flight > 0)
+    {
+      priv->read_back_frame += 1;
+
+      clutter_stage_dispatch_read_backs (stage, FALSE);
+
+      /* the read-backs that could not be recorded during the previous
+       * frame, because all the pixel buffers were in use, need a new
+       * frame to be recorded
+       */
+      if (!g_queue_is_empty (&priv->pending_read_backs))
+        clutter_actor_queue_redraw (CLUTTER_ACTOR (stage));
+    }
+
   /* NB: We need to ensure we have an up to date layout *before* we
    * check or clear the pending redraws flag since a relayout may
    * queue a redraw.
    */
   _clutter_stage_maybe_relayout (CLUTTER_ACTOR (stage));
 
+  /* start a new set of geometry snapshots for this frame, now that the
+   * layout is up to date
+   */
+  _clutter_actor_invalidate_geometry_snapshots ();
+
   if (!priv->redraw_pending)
     return FALSE;
 
@@ -1390,6 +1705,7 @@ _clutter_stage_do_pick (ClutterStage   *stage,
   gint read_y;
   float stage_width, stage_height;
   int window_scale;
+  gint64 profile_start;
 
   priv = stage->priv;
 
@@ -1406,6 +1722,8 @@ _clutter_stage_do_pick (ClutterStage   *stage,
   if (x < 0 || x >= stage_width || y < 0 || y >= stage_height)
     return actor;
 
+  profile_start = _clutter_profiler_begin ();
+
   context = _clutter_context_get_default ();
   clutter_stage_ensure_current (stage);
   window_scale = _clutter_stage_window_get_scale_factor (priv->impl);
@@ -1487,6 +1805,8 @@ _clutter_stage_do_pick (ClutterStage   *stage,
       retval = _clutter_stage_get_actor_by_pick_id (stage, id_);
     }
 
+  _clutter_profiler_end (CLUTTER_PROFILER_PHASE_PICK, stage, profile_start);
+
   return retval;
 }
 
@@ -1701,11 +2021,39 @@ clutter_stage_dispose (GObject *object)
   ClutterStage        *stage = CLUTTER_STAGE (object);
   ClutterStagePrivate *priv = stage->priv;
   ClutterStageManager *stage_manager;
+  ClutterStageReadBack *read_back;
+  gint i;
 
   clutter_actor_hide (CLUTTER_ACTOR (object));
 
   _clutter_clear_events_queue_for_stage (stage);
 
+  /* deliver the read-backs in flight, and fail the ones that were
+   * never recorded
+   */
+  clutter_stage_dispatch_read_backs (stage, TRUE);
+
+  while ((read_back = g_queue_pop_head (&priv->pending_read_backs)) != NULL)
+    {
+      read_back->func (stage,
+                       NULL,
+                       read_back->width,
+                       read_back->height,
+                       0,
+                       read_back->user_data);
+
+      clutter_stage_read_back_free (read_back);
+    }
+
+  for (i = 0; i < N_READ_BACK_SLOTS; i++)
+    {
+      if (priv->read_back_slots[i].bitmap != NULL)
+        {
+          cogl_object_unref (priv->read_back_slots[i].bitmap);
+          priv->read_back_slots[i].bitmap = NULL;
+        }
+    }
+
   if (priv->impl != NULL)
     {
       CLUTTER_NOTE (BACKEND, "Disposing of the stage implementation");
@@ -1751,6 +2099,8 @@ clutter_stage_finalize (GObject *object)
   if (priv->paint_notify != NULL)
     priv->paint_notify (priv->paint_data);
 
+  _clutter_profiler_forget_stage (stage);
+
   G_OBJECT_CLASS (clutter_stage_parent_class)->finalize (object);
 }
 
@@ -2338,6 +2688,9 @@ clutter_stage_set_perspective_internal (ClutterStage       *stage,
   cogl_matrix_get_inverse (&priv->projection,
                            &priv->inverse_projection);
 
+  /* the paint boxes of the actors depend on the projection */
+  _clutter_actor_invalidate_geometry_snapshots ();
+
   priv->dirty_projection = TRUE;
   clutter_actor_queue_redraw (CLUTTER_ACTOR (stage));
 }
@@ -2784,6 +3137,93 @@ clutter_stage_read_pixels (ClutterStage *stage,
   return pixels;
 }
 
+/**
+ * clutter_stage_read_pixels_async:
+ * @stage: A #ClutterStage
+ * @x: x coordinate of the first pixel that is read from stage
+ * @y: y coordinate of the first pixel that is read from stage
+ * @width: Width dimention of pixels to be read, or -1 for the
+ *   entire stage width
+ * @height: Height dimention of pixels to be read, or -1 for the
+ *   entire stage height
+ * @buffer: (array) (nullable): a buffer to copy the pixels into,
+ *   or %NULL
+ * @rowstride: the rowstride of @buffer; ignored if @buffer is %NULL
+ * @func: the function to call when the pixels are available
+ * @user_data: data to pass to @func
+ * @notify: (nullable): function called to release @user_data
+ *
+ * Asynchronously reads the pixels of the stage in RGBA 8bit data.
+ *
+ * Unlike clutter_stage_read_pixels(), this function does not paint
+ * the stage immediately and does not wait for the GPU to finish
+ * drawing it; a redraw is queued, the pixels are read into a pixel
+ * buffer at the end of the next frame, and @func is called one or
+ * two frames later, once the GPU has finished copying them. If too
+ * many read-backs are in flight, the read is postponed to one of the
+ * following frames. This makes it possible to record the
+ * contents of the stage at each frame without halving the frame rate.
+ *
+ * If @buffer is %NULL, @func receives a pointer to the pixel buffer,
+ * which is only valid during the call; otherwise, the pixels are
+ * copied into @buffer, which must be large enough to hold @height
+ * rows of @rowstride bytes, and must remain valid until @func is
+ * called.
+ *
+ * If the read fails, or if the stage is destroyed before the next
+ * frame, @func is called with %NULL pixels.
+ *
+ * Since: 1.26
+ */
+void
+clutter_stage_read_pixels_async (ClutterStage               *stage,
+                                 gint                        x,
+                                 gint                        y,
+                                 gint                        width,
+                                 gint                        height,
+                                 guchar                     *buffer,
+                                 gint                        rowstride,
+                                 ClutterStageReadPixelsFunc  func,
+                                 gpointer                    user_data,
+                                 GDestroyNotify              notify)
+{
+  ClutterStagePrivate *priv;
+  ClutterStageReadBack *read_back;
+  ClutterActorBox box;
+
+  g_return_if_fail (CLUTTER_IS_STAGE (stage));
+  g_return_if_fail (func != NULL);
+
+  priv = stage->priv;
+
+  clutter_actor_get_allocation_box (CLUTTER_ACTOR (stage), &box);
+
+  if (width < 0)
+    width = ceilf (box.x2 - box.x1);
+
+  if (height < 0)
+    height = ceilf (box.y2 - box.y1);
+
+  g_return_if_fail (width > 0 && height > 0);
+  g_return_if_fail (buffer == NULL || rowstride >= width * 4);
+
+  read_back = g_slice_new0 (ClutterStageReadBack);
+  read_back->x = x;
+  read_back->y = y;
+  read_back->width = width;
+  read_back->height = height;
+  read_back->buffer = buffer;
+  read_back->rowstride = rowstride;
+  read_back->func = func;
+  read_back->user_data = user_data;
+  read_back->notify = notify;
+  read_back->serial = priv->read_back_serial++;
+
+  g_queue_push_tail (&priv->pending_read_backs, read_back);
+
+  clutter_actor_queue_redraw (CLUTTER_ACTOR (stage));
+}
+
 /**
  * clutter_stage_get_actor_at_pos:
  * @stage: a #ClutterStage
@@ -3480,6 +3920,11 @@ _clutter_stage_maybe_setup_viewport (ClutterStage *stage)
 
       clutter_stage_apply_scale (stage);
 
+      /* the transformations of the actors to eye coordinates depend
+       * on the view
+       */
+      _clutter_actor_invalidate_geometry_snapshots ();
+
       priv->dirty_viewport = FALSE;
     }
 
@@ -4234,6 +4679,17 @@ _clutter_stage_release_pick_id (ClutterStage *stage,
   _clutter_id_pool_remove (priv->pick_id_pool, pick_id);
 }
 
+void
+_clutter_stage_reserve_pick_ids (ClutterStage *stage,
+                                 guint         n_ids)
+{
+  ClutterStagePrivate *priv = stage->priv;
+
+  g_assert (priv->pick_id_pool != NULL);
+
+  _clutter_id_pool_reserve (priv->pick_id_pool, n_ids);
+}
+
 ClutterActor *
 _clutter_stage_get_actor_by_pick_id (ClutterStage *stage,
                                      gint32        pick_id)
@@ -226,6 +226,44 @@ guchar *        clutter_stage_read_pixels                       (ClutterStage
                                                                  gint                   width,
                                                                  gint                   height);
 
+/**
+ * ClutterStageReadPixelsFunc:
+ * @stage: the #ClutterStage that was read
+ * @pixels: (array) (nullable): the RGBA 8bit pixel data, or %NULL if
+ *   the read failed
+ * @width: the width of the area that was read
+ * @height: the height of the area that was read
+ * @rowstride: the rowstride of @pixels
+ * @user_data: data passed to clutter_stage_read_pixels_async()
+ *
+ * The function called when the pixels requested by
+ * clutter_stage_read_pixels_async() are available.
+ *
+ * Unless a buffer was passed to clutter_stage_read_pixels_async(),
+ * @pixels is owned by Clutter, and it is only valid until this
+ * function returns.
+ *
+ * Since: 1.26
+ */
+typedef void (* ClutterStageReadPixelsFunc) (ClutterStage *stage,
+                                             const guchar *pixels,
+                                             gint          width,
+                                             gint          height,
+                                             gint          rowstride,
+                                             gpointer      user_data);
+
+CLUTTER_AVAILABLE_IN_1_26
+void            clutter_stage_read_pixels_async                 (ClutterStage          *stage,
+                                                                 gint                   x,
+                                                                 gint                   y,
+                                                                 gint                   width,
+                                                                 gint                   height,
+                                                                 guchar                *buffer,
+                                                                 gint                   rowstride,
+                                                                 ClutterStageReadPixelsFunc func,
+                                                                 gpointer               user_data,
+                                                                 GDestroyNotify         notify);
+
 CLUTTER_AVAILABLE_IN_ALL
 void            clutter_stage_get_redraw_clip_bounds            (ClutterStage          *stage,
                                                                  cairo_rectangle_int_t *clip);
@@ -7,6 +7,7 @@
 
 #include "clutter-actor.h"
 #include "clutter-color.h"
+#include "clutter-device-manager-private.h"
 #include "clutter-event.h"
 #include "clutter-keysyms.h"
 #include "clutter-main.h"
@@ -465,3 +466,46 @@ clutter_test_check_color_at_point (ClutterActor       *stage,
 
   return retval;
 }
+
+/**
+ * clutter_test_create_input_device:
+ * @device_type: the type of the device
+ * @n_axes: the number of axes of the device
+ *
+ * Creates a slave #ClutterInputDevice with @n_axes axes, which is not
+ * added to the device manager; it can be used to create synthetic
+ * events carrying axes values.
+ *
+ * Returns: (transfer full): the newly created device
+ *
+ * Since: 1.26
+ */
+ClutterInputDevice *
+clutter_test_create_input_device (ClutterInputDeviceType device_type,
+                                  guint                  n_axes)
+{
+  static gint device_counter = 1000;
+  ClutterInputDevice *device;
+  guint i;
+
+  device = g_object_new (CLUTTER_TYPE_INPUT_DEVICE,
+                         "id", device_counter++,
+                         "backend", clutter_get_default_backend (),
+                         "device-type", device_type,
+                         "device-mode", CLUTTER_INPUT_MODE_SLAVE,
+                         "name", "Test device",
+                         "enabled", TRUE,
+                         NULL);
+
+  for (i = 0; i < n_axes; i++)
+    {
+      ClutterInputAxis axis;
+
+      /* past the known axes, we keep adding generic ones */
+      axis = MIN (i + CLUTTER_INPUT_AXIS_X, CLUTTER_INPUT_AXIS_LAST - 1);
+
+      _clutter_input_device_add_axis (device, axis, 0, 1, 1);
+    }
+
+  return device;
+}
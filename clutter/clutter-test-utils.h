@@ -159,6 +159,10 @@ gboolean        clutter_test_check_color_at_point       (ClutterActor       *sta
                                                          const ClutterColor *color,
                                                          ClutterColor       *result);
 
+CLUTTER_AVAILABLE_IN_1_26
+ClutterInputDevice *    clutter_test_create_input_device        (ClutterInputDeviceType  device_type,
+                                                                 guint                   n_axes);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_TEST_UTILS_H__ */
@@ -63,6 +63,7 @@
 #include "clutter-units.h"
 #include "clutter-paint-volume-private.h"
 #include "clutter-scriptable.h"
+#include "clutter-stage-private.h"
 
 /* cursor width in pixels */
 #define DEFAULT_CURSOR_SIZE     2
@@ -114,6 +115,13 @@ struct _ClutterTextPrivate
   LayoutCache cached_layouts[N_CACHED_LAYOUTS];
   guint cache_age;
 
+  /* The contents of a static layout, painted once into a texture and
+   * then painted using a single rectangle */
+  PangoLayout *baked_layout;
+  CoglPipeline *baked_pipeline;
+  PangoRectangle baked_rect;
+  guint baked_n_paints;
+
   /* These are the attributes set by the attributes property */
   PangoAttrList *attrs;
   /* These are the attributes derived from the text when the
@@ -151,6 +159,10 @@ struct _ClutterTextPrivate
 
   /* Where to draw the cursor */
   ClutterRect cursor_rect;
+
+  /* The area covered by the cursor, or by the selection, the last
+   * time the actor was painted */
+  ClutterRect cursor_area;
   ClutterColor cursor_color;
   guint cursor_size;
 
@@ -201,6 +213,7 @@ struct _ClutterTextPrivate
   guint show_password_hint      : 1;
   guint password_hint_visible   : 1;
   guint resolved_direction      : 4;
+  guint baked_layout_static     : 1;
 };
 
 enum
@@ -260,6 +273,7 @@ static void clutter_text_settings_changed_cb (ClutterText *text);
 static void buffer_connect_signals (ClutterText *self);
 static void buffer_disconnect_signals (ClutterText *self);
 static ClutterTextBuffer *get_buffer (ClutterText *self);
+static void clutter_text_queue_redraw_cursor (ClutterText *self);
 
 static const ClutterColor default_cursor_color    = {   0,   0,   0, 255 };
 static const ClutterColor default_selection_color = {   0,   0,   0, 255 };
@@ -351,7 +365,7 @@ clutter_text_clear_selection (ClutterText *self)
     {
       priv->selection_bound = priv->position;
       g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_SELECTION_BOUND]);
-      clutter_text_queue_redraw (CLUTTER_ACTOR (self));
+      clutter_text_queue_redraw_cursor (self);
     }
 }
 
@@ -585,6 +599,25 @@ clutter_text_create_layout_no_cache (ClutterText       *text,
   return layout;
 }
 
+static void
+clutter_text_dirty_baked_layout (ClutterText *text)
+{
+  ClutterTextPrivate *priv = text->priv;
+
+  g_clear_object (&priv->baked_layout);
+
+  if (priv->baked_pipeline != NULL)
+    {
+      baked_bytes -= (gsize) priv->baked_rect.width * priv->baked_rect.height * 4;
+
+      cogl_object_unref (priv->baked_pipeline);
+      priv->baked_pipeline = NULL;
+    }
+
+  priv->baked_n_paints = 0;
+  priv->baked_layout_static = FALSE;
+}
+
 static void
 clutter_text_dirty_cache (ClutterText *text)
 {
@@ -600,6 +633,7 @@ clutter_text_dirty_cache (ClutterText *text)
 	priv->cached_layouts[i].layout = NULL;
       }
 
+  clutter_text_dirty_baked_layout (text);
   clutter_text_dirty_paint_volume (text);
 }
 
@@ -872,6 +906,307 @@ clutter_text_create_layout (ClutterText *text,
   return oldest_cache->layout;
 }
 
+/* Layouts with fewer lines than this are always painted in one go,
+ * using the display list that cogl-pango caches on the layout
+ */
+#define MIN_LINES_FOR_CULLING   32
+
+typedef struct _LayoutLineExtents       LayoutLineExtents;
+typedef struct _LayoutLines             LayoutLines;
+
+struct _LayoutLineExtents
+{
+  /* owned by the PangoLayout */
+  PangoLayoutLine *line;
+
+  /* the origin of the line, in Pango units */
+  gint x;
+  gint baseline;
+
+  /* these are kept monotonic, so that they can be bisected: @top is
+   * the smallest top edge of this line and of all the lines after it,
+   * and @bottom is the largest bottom edge of this line and of all the
+   * lines before it; both take the ink extents into account
+   */
+  gint top;
+  gint bottom;
+};
+
+struct _LayoutLines
+{
+  /* the horizontal extents of the whole layout, in Pango units */
+  gint x1;
+  gint x2;
+
+  gint n_lines;
+  LayoutLineExtents *lines;
+};
+
+static GQuark quark_layout_lines = 0;
+
+static void
+layout_lines_free (gpointer data)
+{
+  LayoutLines *lines = data;
+
+  g_free (lines->lines);
+  g_slice_free (LayoutLines, lines);
+}
+
+/*
+ * clutter_text_get_layout_lines:
+ * @layout: a #PangoLayout created by clutter_text_create_layout()
+ *
+ * Retrieves the per-line extents of @layout. The extents are computed
+ * the first time they are needed and stored on the layout itself, so
+ * they live exactly as long as the cached layout does.
+ */
+static LayoutLines *
+clutter_text_get_layout_lines (PangoLayout *layout)
+{
+  LayoutLines *lines;
+  PangoLayoutIter *iter;
+  PangoRectangle ink_rect, logical_rect;
+  gint i;
+
+  lines = g_object_get_qdata (G_OBJECT (layout), quark_layout_lines);
+  if (lines != NULL)
+    return lines;
+
+  lines = g_slice_new (LayoutLines);
+  lines->n_lines = pango_layout_get_line_count (layout);
+  lines->lines = g_new (LayoutLineExtents, lines->n_lines);
+
+  pango_layout_get_extents (layout, &ink_rect, &logical_rect);
+  lines->x1 = MIN (ink_rect.x, logical_rect.x);
+  lines->x2 = MAX (ink_rect.x + ink_rect.width,
+                   logical_rect.x + logical_rect.width);
+
+  iter = pango_layout_get_iter (layout);
+  i = 0;
+
+  do
+    {
+      LayoutLineExtents *extents = &lines->lines[i];
+
+      pango_layout_iter_get_line_extents (iter, &ink_rect, &logical_rect);
+
+      extents->line = pango_layout_iter_get_line_readonly (iter);
+      extents->x = logical_rect.x;
+      extents->baseline = pango_layout_iter_get_baseline (iter);
+      extents->top = MIN (ink_rect.y, logical_rect.y);
+      extents->bottom = MAX (ink_rect.y + ink_rect.height,
+                             logical_rect.y + logical_rect.height);
+
+      if (i > 0)
+        extents->bottom = MAX (extents->bottom, lines->lines[i - 1].bottom);
+
+      i += 1;
+    }
+  while (i < lines->n_lines && pango_layout_iter_next_line (iter));
+
+  pango_layout_iter_free (iter);
+
+  lines->n_lines = i;
+
+  for (i = lines->n_lines - 2; i >= 0; i--)
+    lines->lines[i].top = MIN (lines->lines[i].top, lines->lines[i + 1].top);
+
+  g_object_set_qdata_full (G_OBJECT (layout), quark_layout_lines,
+                           lines,
+                           layout_lines_free);
+
+  return lines;
+}
+
+/* Checks whether the rectangle going from @y1 to @y2, in Pango units
+ * relative to the layout, is outside the stage clip planes
+ */
+static gboolean
+layout_lines_rect_is_culled (const LayoutLines  *lines,
+                             const CoglMatrix   *modelview,
+                             const ClutterPlane *planes,
+                             gint                layout_x,
+                             gint                layout_y,
+                             gint                y1,
+                             gint                y2)
+{
+  ClutterPaintVolume pv;
+  ClutterVertex origin;
+  ClutterCullResult result;
+
+  _clutter_paint_volume_init_static (&pv, NULL);
+
+  origin.x = layout_x + lines->x1 / (float) PANGO_SCALE;
+  origin.y = layout_y + y1 / (float) PANGO_SCALE;
+  origin.z = 0.f;
+  clutter_paint_volume_set_origin (&pv, &origin);
+  clutter_paint_volume_set_width (&pv, (lines->x2 - lines->x1) / (float) PANGO_SCALE);
+  clutter_paint_volume_set_height (&pv, MAX (y2 - y1, 0) / (float) PANGO_SCALE);
+
+  _clutter_paint_volume_transform (&pv, modelview);
+  _clutter_paint_volume_complete (&pv);
+
+  result = _clutter_paint_volume_cull (&pv, planes);
+
+  clutter_paint_volume_free (&pv);
+
+  return result == CLUTTER_CULL_RESULT_OUT;
+}
+
+/*
+ * clutter_text_get_visible_lines:
+ * @self: a #ClutterText
+ * @fb: the framebuffer being painted
+ * @lines: the line extents of the layout being painted
+ * @layout_x: the horizontal offset of the layout
+ * @layout_y: the vertical offset of the layout
+ * @first_line: (out): return location for the first visible line
+ * @last_line: (out): return location for the last visible line
+ *
+ * Computes the range of lines of a layout that intersect the current
+ * stage clip, using a bisection over the monotonic line extents.
+ *
+ * Since the clip is convex and the lines are stacked vertically the
+ * visible lines always form a contiguous range: a prefix of lines
+ * that is culled can only get smaller lines culled, and the same
+ * applies to suffixes.
+ *
+ * Return value: %FALSE if culling is not possible, for instance
+ *   because we're painting to an offscreen framebuffer
+ */
+static gboolean
+clutter_text_get_visible_lines (ClutterText       *self,
+                                CoglFramebuffer   *fb,
+                                const LayoutLines *lines,
+                                gint               layout_x,
+                                gint               layout_y,
+                                gint              *first_line,
+                                gint              *last_line)
+{
+  ClutterActor *actor = CLUTTER_ACTOR (self);
+  const ClutterPlane *stage_clip;
+  ClutterActor *stage;
+  CoglMatrix modelview;
+  gint top, bottom;
+  gint lo, hi;
+
+  if (G_UNLIKELY (clutter_paint_debug_flags & CLUTTER_DEBUG_DISABLE_CULLING))
+    return FALSE;
+
+  stage = _clutter_actor_get_stage_internal (actor);
+  if (stage == NULL)
+    return FALSE;
+
+  stage_clip = _clutter_stage_get_clip (CLUTTER_STAGE (stage));
+  if (stage_clip == NULL)
+    return FALSE;
+
+  /* the clip planes only make sense for the stage framebuffer */
+  if (fb != _clutter_stage_get_active_framebuffer (CLUTTER_STAGE (stage)))
+    return FALSE;
+
+  cogl_framebuffer_get_modelview_matrix (fb, &modelview);
+
+  top = lines->lines[0].top;
+  bottom = lines->lines[lines->n_lines - 1].bottom;
+
+  /* find the first line such that the lines up to it are not culled */
+  lo = 0;
+  hi = lines->n_lines;
+  while (lo < hi)
+    {
+      gint mid = lo + (hi - lo) / 2;
+
+      if (layout_lines_rect_is_culled (lines, &modelview, stage_clip,
+                                       layout_x, layout_y,
+                                       top, lines->lines[mid].bottom))
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+  *first_line = lo;
+
+  /* find the last line such that the lines from it are not culled */
+  lo = *first_line - 1;
+  hi = lines->n_lines - 1;
+  while (lo < hi)
+    {
+      gint mid = hi - (hi - lo) / 2;
+
+      if (layout_lines_rect_is_culled (lines, &modelview, stage_clip,
+                                       layout_x, layout_y,
+                                       lines->lines[mid].top, bottom))
+        hi = mid - 1;
+      else
+        lo = mid;
+    }
+
+  *last_line = hi;
+
+  CLUTTER_NOTE (CLIPPING, "Text[%p]: painting lines %d-%d of %d",
+                self,
+                *first_line, *last_line,
+                lines->n_lines);
+
+  return TRUE;
+}
+
+/*
+ * clutter_text_render_layout:
+ * @self: a #ClutterText
+ * @fb: the framebuffer being painted
+ * @layout: the #PangoLayout to paint
+ * @x: the horizontal offset of the layout, in pixels
+ * @y: the vertical offset of the layout, in pixels
+ * @color: the color of the text
+ *
+ * Paints @layout, skipping the lines that are outside of the current
+ * stage clip. Layouts that are entirely visible, or that are too short
+ * to be worth culling, are painted through the display list cached by
+ * cogl-pango.
+ */
+static void
+clutter_text_render_layout (ClutterText     *self,
+                            CoglFramebuffer *fb,
+                            PangoLayout     *layout,
+                            gint             x,
+                            gint             y,
+                            const CoglColor *color)
+{
+  LayoutLines *lines;
+  gint first_line, last_line;
+  gint i;
+
+  if (pango_layout_get_line_count (layout) < MIN_LINES_FOR_CULLING)
+    {
+      cogl_pango_render_layout (layout, x, y, color, 0);
+      return;
+    }
+
+  lines = clutter_text_get_layout_lines (layout);
+
+  if (!clutter_text_get_visible_lines (self, fb, lines, x, y,
+                                       &first_line,
+                                       &last_line) ||
+      (first_line == 0 && last_line == lines->n_lines - 1))
+    {
+      cogl_pango_render_layout (layout, x, y, color, 0);
+      return;
+    }
+
+  for (i = first_line; i <= last_line; i++)
+    {
+      const LayoutLineExtents *extents = &lines->lines[i];
+
+      cogl_pango_render_layout_line (extents->line,
+                                     x * PANGO_SCALE + extents->x,
+                                     y * PANGO_SCALE + extents->baseline,
+                                     color);
+    }
+}
+
 /**
  * clutter_text_coords_to_position:
  * @self: a #ClutterText
@@ -1602,7 +1937,223 @@ add_selection_rectangle_to_path (ClutterText           *text,
                                  const ClutterActorBox *box,
                                  gpointer               user_data)
 {
+  ClutterRect *area = &text->priv->cursor_area;
+  ClutterRect rect;
+
   cogl_path_rectangle (user_data, box->x1, box->y1, box->x2, box->y2);
+
+  clutter_rect_init (&rect, box->x1, box->y1, box->x2 - box->x1, box->y2 - box->y1);
+
+  if (clutter_rect_get_width (area) == 0.f || clutter_rect_get_height (area) == 0.f)
+    *area = rect;
+  else
+    clutter_rect_union (area, &rect, area);
+}
+
+/* The number of consecutive paints of the same layout after which it
+ * gets baked into a texture; this avoids paying the price of baking
+ * for text that changes at every frame
+ */
+#define N_PAINTS_BEFORE_BAKING  2
+
+/* The maximum size of the texture used to bake a layout, the maximum
+ * number of pixels in it, and the maximum number of bytes used by the
+ * baked layouts of all the ClutterText instances
+ */
+#define MAX_BAKED_SIZE          1024
+#define MAX_BAKED_AREA          (256 * 1024)
+#define MAX_BAKED_BYTES         (16 * 1024 * 1024)
+
+static gsize baked_bytes = 0;
+
+static gboolean
+attr_list_has_colors (PangoAttrList *attrs)
+{
+  PangoAttrIterator *iter;
+  gboolean retval = FALSE;
+
+  if (attrs == NULL)
+    return FALSE;
+
+  iter = pango_attr_list_get_iterator (attrs);
+
+  do
+    {
+      if (pango_attr_iterator_get (iter, PANGO_ATTR_FOREGROUND) != NULL ||
+          pango_attr_iterator_get (iter, PANGO_ATTR_BACKGROUND) != NULL ||
+          pango_attr_iterator_get (iter, PANGO_ATTR_UNDERLINE_COLOR) != NULL ||
+          pango_attr_iterator_get (iter, PANGO_ATTR_STRIKETHROUGH_COLOR) != NULL)
+        {
+          retval = TRUE;
+          break;
+        }
+    }
+  while (pango_attr_iterator_next (iter));
+
+  pango_attr_iterator_destroy (iter);
+
+  return retval;
+}
+
+/*
+ * clutter_text_bake_layout:
+ * @layout: a #PangoLayout
+ * @rect: the ink rectangle of @layout, in pixels
+ *
+ * Paints the glyphs of @layout in white into a texture, so that the
+ * layout can be painted using a single rectangle, and with the text
+ * color and the paint opacity applied as the pipeline color.
+ *
+ * Return value: (transfer full): a #CoglPipeline with the baked layout
+ *   as its first layer, or %NULL
+ */
+static CoglPipeline *
+clutter_text_bake_layout (PangoLayout          *layout,
+                          const PangoRectangle *rect)
+{
+  CoglFramebuffer *offscreen;
+  CoglPipeline *pipeline;
+  CoglHandle texture;
+  CoglContext *ctx;
+  CoglColor white;
+
+  texture = cogl_texture_new_with_size (rect->width, rect->height,
+                                        COGL_TEXTURE_NO_SLICING,
+                                        COGL_PIXEL_FORMAT_RGBA_8888_PRE);
+  if (texture == NULL)
+    return NULL;
+
+  offscreen = COGL_FRAMEBUFFER (cogl_offscreen_new_to_texture (texture));
+  if (offscreen == NULL)
+    {
+      cogl_object_unref (texture);
+      return NULL;
+    }
+
+  cogl_framebuffer_orthographic (offscreen,
+                                 0, 0,
+                                 rect->width, rect->height,
+                                 -1.f, 1.f);
+  cogl_framebuffer_clear4f (offscreen, COGL_BUFFER_BIT_COLOR,
+                            0.f, 0.f, 0.f, 0.f);
+
+  cogl_color_init_from_4ub (&white, 255, 255, 255, 255);
+
+  cogl_pango_show_layout (offscreen, layout, -rect->x, -rect->y, &white);
+
+  cogl_object_unref (offscreen);
+
+  ctx = clutter_backend_get_cogl_context (clutter_get_default_backend ());
+
+  pipeline = cogl_pipeline_new (ctx);
+  cogl_pipeline_set_layer_texture (pipeline, 0, texture);
+  cogl_object_unref (texture);
+
+  return pipeline;
+}
+
+/*
+ * clutter_text_render_baked_layout:
+ * @self: a #ClutterText
+ * @fb: the framebuffer being painted
+ * @layout: the #PangoLayout to paint
+ * @color: the color of the text
+ *
+ * Paints @layout using its baked contents, if @self is a static
+ * label; since the text color and the opacity are applied when
+ * painting the baked contents, changing them does not require
+ * baking the layout again.
+ *
+ * Return value: %TRUE if the layout was painted
+ */
+static gboolean
+clutter_text_render_baked_layout (ClutterText     *self,
+                                  CoglFramebuffer *fb,
+                                  PangoLayout     *layout,
+                                  const CoglColor *color)
+{
+  ClutterTextPrivate *priv = self->priv;
+  CoglColor baked_color;
+  float x, y;
+
+  /* editable text is likely to change anyway; the cursor and the
+   * selection are painted on top of the layout, using it, so we skip
+   * baking while they are visible
+   */
+  if (priv->editable || clutter_text_should_draw_cursor (self))
+    return FALSE;
+
+  if (priv->baked_layout != layout)
+    {
+      PangoRectangle *rect = &priv->baked_rect;
+
+      clutter_text_dirty_baked_layout (self);
+
+      priv->baked_layout = g_object_ref (layout);
+
+      pango_layout_get_pixel_extents (layout, rect, NULL);
+
+      /* the glyphs are baked in white, so we cannot bake layouts
+       * using color attributes; long layouts are culled line by
+       * line instead
+       */
+      priv->baked_layout_static =
+        rect->width > 0 && rect->width <= MAX_BAKED_SIZE &&
+        rect->height > 0 && rect->height <= MAX_BAKED_SIZE &&
+        rect->width * rect->height <= MAX_BAKED_AREA &&
+        pango_layout_get_line_count (layout) < MIN_LINES_FOR_CULLING &&
+        !attr_list_has_colors (pango_layout_get_attributes (layout));
+    }
+
+  if (!priv->baked_layout_static)
+    return FALSE;
+
+  if (priv->baked_pipeline == NULL)
+    {
+      gsize size;
+
+      priv->baked_n_paints += 1;
+      if (priv->baked_n_paints < N_PAINTS_BEFORE_BAKING)
+        return FALSE;
+
+      /* keep using cogl-pango once the textures of all the baked
+       * layouts are over budget
+       */
+      size = (gsize) priv->baked_rect.width * priv->baked_rect.height * 4;
+      if (baked_bytes + size > MAX_BAKED_BYTES)
+        return FALSE;
+
+      CLUTTER_NOTE (PAINT, "Text[%p]: baking layout (%d x %d)",
+                    self,
+                    priv->baked_rect.width,
+                    priv->baked_rect.height);
+
+      priv->baked_pipeline = clutter_text_bake_layout (layout,
+                                                       &priv->baked_rect);
+      if (priv->baked_pipeline == NULL)
+        {
+          priv->baked_layout_static = FALSE;
+          return FALSE;
+        }
+
+      baked_bytes += size;
+    }
+
+  baked_color = *color;
+  cogl_color_premultiply (&baked_color);
+  cogl_pipeline_set_color (priv->baked_pipeline, &baked_color);
+
+  x = priv->text_x + priv->baked_rect.x;
+  y = priv->text_y + priv->baked_rect.y;
+
+  cogl_framebuffer_draw_textured_rectangle (fb, priv->baked_pipeline,
+                                            x, y,
+                                            x + priv->baked_rect.width,
+                                            y + priv->baked_rect.height,
+                                            0.f, 0.f,
+                                            1.f, 1.f);
+
+  return TRUE;
 }
 
 /* Draws the selected text, its background, and the cursor */
@@ -1614,11 +2165,16 @@ selection_paint (ClutterText *self)
   guint8 paint_opacity = clutter_actor_get_paint_opacity (actor);
   const ClutterColor *color;
 
+  /* add_selection_rectangle_to_path() will update the area */
+  clutter_rect_init (&priv->cursor_area, 0.f, 0.f, 0.f, 0.f);
+
   if (!clutter_text_should_draw_cursor (self))
     return;
 
   if (priv->position == priv->selection_bound)
     {
+      priv->cursor_area = priv->cursor_rect;
+
       /* No selection, just draw the cursor */
       if (priv->cursor_color_set)
         color = &priv->cursor_color;
@@ -1681,7 +2237,9 @@ selection_paint (ClutterText *self)
                                 color->blue,
                                 paint_opacity * color->alpha / 255);
 
-      cogl_pango_render_layout (layout, priv->text_x, 0, &cogl_color, 0);
+      clutter_text_render_layout (self, fb, layout,
+                                  priv->text_x, 0,
+                                  &cogl_color);
 
       cogl_framebuffer_pop_clip (fb);
     }
@@ -2377,6 +2935,7 @@ clutter_text_paint (ClutterActor *self)
       priv->text_y = text_y;
 
       clutter_text_ensure_cursor_position (text);
+      clutter_text_dirty_paint_volume (text);
     }
 
   real_opacity = clutter_actor_get_paint_opacity (self)
@@ -2391,7 +2950,10 @@ clutter_text_paint (ClutterActor *self)
                             priv->text_color.green,
                             priv->text_color.blue,
                             real_opacity);
-  cogl_pango_render_layout (layout, priv->text_x, priv->text_y, &color, 0);
+  if (!clutter_text_render_baked_layout (text, fb, layout, &color))
+    clutter_text_render_layout (text, fb, layout,
+                                priv->text_x, priv->text_y,
+                                &color);
 
   selection_paint (text);
 
@@ -2449,6 +3011,115 @@ clutter_text_get_paint_volume_for_cursor (ClutterText        *text,
     }
 }
 
+static gboolean
+clutter_text_has_cached_layout (ClutterText *self)
+{
+  ClutterTextPrivate *priv = self->priv;
+  int i;
+
+  for (i = 0; i < N_CACHED_LAYOUTS; i++)
+    if (priv->cached_layouts[i].layout != NULL)
+      return TRUE;
+
+  return FALSE;
+}
+
+/*
+ * clutter_text_queue_redraw_cursor:
+ * @self: a #ClutterText
+ *
+ * Queues a redraw limited to the area covered by the cursor, or by the
+ * selection, the last time @self was painted, and to the area that
+ * they are going to cover after a change in their state.
+ *
+ * This function should be called after changing the cursor position,
+ * the selection bound or the cursor state, in place of
+ * clutter_text_queue_redraw(), as it avoids repainting the whole
+ * contents of the actor.
+ */
+static void
+clutter_text_queue_redraw_cursor (ClutterText *self)
+{
+  ClutterTextPrivate *priv = self->priv;
+  ClutterActor *actor = CLUTTER_ACTOR (self);
+  ClutterPaintVolume clip;
+  ClutterVertex origin;
+  gboolean has_clip = FALSE;
+
+  /* if the layout needs to be recreated, or if there's no allocation,
+   * then we cannot know what the cursor area is going to be, and the
+   * contents are going to be repainted anyway
+   */
+  if (!clutter_actor_has_allocation (actor) ||
+      !clutter_text_has_cached_layout (self))
+    {
+      clutter_text_queue_redraw (actor);
+      return;
+    }
+
+  /* a single line editable text might scroll to keep the cursor in
+   * view, which changes the position of the whole layout
+   */
+  if (priv->editable && priv->single_line_mode)
+    {
+      PangoRectangle logical_rect = { 0, };
+      ClutterActorBox alloc;
+
+      clutter_actor_get_allocation_box (actor, &alloc);
+      pango_layout_get_pixel_extents (clutter_text_create_layout (self, -1, -1),
+                                      NULL,
+                                      &logical_rect);
+
+      if (logical_rect.width > (alloc.x2 - alloc.x1) - 2 * TEXT_PADDING)
+        {
+          clutter_text_queue_redraw (actor);
+          return;
+        }
+    }
+
+  /* the paint volume includes the cursor */
+  clutter_text_dirty_paint_volume (self);
+
+  _clutter_paint_volume_init_static (&clip, actor);
+
+  if (clutter_rect_get_width (&priv->cursor_area) > 0.f &&
+      clutter_rect_get_height (&priv->cursor_area) > 0.f)
+    {
+      origin.x = clutter_rect_get_x (&priv->cursor_area);
+      origin.y = clutter_rect_get_y (&priv->cursor_area);
+      origin.z = 0.f;
+
+      clutter_paint_volume_set_origin (&clip, &origin);
+      clutter_paint_volume_set_width (&clip, clutter_rect_get_width (&priv->cursor_area));
+      clutter_paint_volume_set_height (&clip, clutter_rect_get_height (&priv->cursor_area));
+
+      has_clip = TRUE;
+    }
+
+  if (clutter_text_should_draw_cursor (self))
+    {
+      ClutterPaintVolume cursor_volume;
+
+      _clutter_paint_volume_init_static (&cursor_volume, actor);
+
+      clutter_text_get_paint_volume_for_cursor (self, &cursor_volume);
+      clutter_paint_volume_union (&clip, &cursor_volume);
+
+      clutter_paint_volume_free (&cursor_volume);
+
+      has_clip = TRUE;
+    }
+
+  if (has_clip)
+    {
+      CLUTTER_NOTE (PAINT, "Text[%p]: queueing cursor redraw", self);
+
+      _clutter_actor_queue_redraw_with_clip (actor, 0, &clip);
+    }
+
+  clutter_paint_volume_free (&clip);
+}
+
 static gboolean
 clutter_text_get_paint_volume (ClutterActor       *self,
                                ClutterPaintVolume *volume)
@@ -2464,8 +3135,9 @@ clutter_text_get_paint_volume (ClutterActor       *self,
   if (!priv->paint_volume_valid)
     {
       PangoLayout *layout;
-      PangoRectangle ink_rect;
+      PangoRectangle ink_rect, logical_rect;
       ClutterVertex origin;
+      float x1, y1, x2, y2;
 
       /* If the text is single line editable then it gets clipped to
          the allocation anyway so we can just use that */
@@ -2483,16 +3155,47 @@ clutter_text_get_paint_volume (ClutterActor       *self,
       _clutter_paint_volume_init_static (&priv->paint_volume, self);
 
       layout = clutter_text_get_layout (text);
-      pango_layout_get_extents (layout, &ink_rect, NULL);
+      pango_layout_get_extents (layout, &ink_rect, &logical_rect);
+
+      /* the layout is painted at the scroll and alignment offsets,
+       * so the ink rectangle has to be moved there before it is
+       * compared with the allocation
+       */
+      x1 = priv->text_x + ink_rect.x / (float) PANGO_SCALE;
+      y1 = priv->text_y + ink_rect.y / (float) PANGO_SCALE;
+      x2 = x1 + ink_rect.width / (float) PANGO_SCALE;
+      y2 = y1 + ink_rect.height / (float) PANGO_SCALE;
+
+      /* clutter_text_paint() clips non-editable layouts overflowing
+       * the allocation, so nothing outside of it will ever be drawn;
+       * this keeps the volume of a long text inside a scrolling view
+       * from covering the whole layout
+       */
+      if (!priv->editable && !(priv->wrap && priv->ellipsize))
+        {
+          ClutterActorBox alloc;
+          float alloc_width, alloc_height;
 
-      origin.x = ink_rect.x / (float) PANGO_SCALE;
-      origin.y = ink_rect.y / (float) PANGO_SCALE;
+          clutter_actor_get_allocation_box (self, &alloc);
+          alloc_width = alloc.x2 - alloc.x1;
+          alloc_height = alloc.y2 - alloc.y1;
+
+          if (PANGO_PIXELS_CEIL (logical_rect.width) > alloc_width ||
+              PANGO_PIXELS_CEIL (logical_rect.height) > alloc_height)
+            {
+              x1 = CLAMP (x1, 0, alloc_width);
+              y1 = CLAMP (y1, 0, alloc_height);
+              x2 = CLAMP (x2, x1, alloc_width);
+              y2 = CLAMP (y2, y1, alloc_height);
+            }
+        }
+
+      origin.x = x1;
+      origin.y = y1;
       origin.z = 0;
       clutter_paint_volume_set_origin (&priv->paint_volume, &origin);
-      clutter_paint_volume_set_width (&priv->paint_volume,
-                                      ink_rect.width / (float) PANGO_SCALE);
-      clutter_paint_volume_set_height (&priv->paint_volume,
-                                       ink_rect.height / (float) PANGO_SCALE);
+      clutter_paint_volume_set_width (&priv->paint_volume, x2 - x1);
+      clutter_paint_volume_set_height (&priv->paint_volume, y2 - y1);
 
       /* If the cursor is visible then that will likely be drawn
          outside of the ink rectangle so we should merge that in */
@@ -2635,6 +3338,9 @@ clutter_text_allocate (ClutterActor           *self,
   ClutterText *text = CLUTTER_TEXT (self);
   ClutterActorClass *parent_class;
 
+  /* the paint volume is clipped to the allocation */
+  clutter_text_dirty_paint_volume (text);
+
   /* Ensure that there is a cached layout with the right width so
    * that we don't need to create the text during the paint run
    *
@@ -2666,7 +3372,7 @@ clutter_text_key_focus_in (ClutterActor *actor)
 
   priv->has_focus = TRUE;
 
-  clutter_text_queue_redraw (actor);
+  clutter_text_queue_redraw_cursor (CLUTTER_TEXT (actor));
 }
 
 static void
@@ -2676,7 +3382,7 @@ clutter_text_key_focus_out (ClutterActor *actor)
 
   priv->has_focus = FALSE;
 
-  clutter_text_queue_redraw (actor);
+  clutter_text_queue_redraw_cursor (CLUTTER_TEXT (actor));
 }
 
 static gboolean
@@ -3184,7 +3890,12 @@ clutter_text_set_color_internal (ClutterText        *self,
       break;
     }
 
-  clutter_text_queue_redraw (CLUTTER_ACTOR (self));
+  /* the cursor and selection colors only affect the cursor area */
+  if (pspec->param_id == PROP_COLOR)
+    clutter_text_queue_redraw (CLUTTER_ACTOR (self));
+  else
+    clutter_text_queue_redraw_cursor (self);
+
   g_object_notify_by_pspec (G_OBJECT (self), pspec);
   if (other)
     g_object_notify_by_pspec (G_OBJECT (self), other);
@@ -3360,6 +4071,8 @@ clutter_text_class_init (ClutterTextClass *klass)
 
   gobject_class->set_property = clutter_text_set_property;
   gobject_class->get_property = clutter_text_get_property;
+  quark_layout_lines = g_quark_from_static_string ("-clutter-text-layout-lines");
+
   gobject_class->dispose = clutter_text_dispose;
   gobject_class->finalize = clutter_text_finalize;
 
@@ -4662,8 +5375,7 @@ clutter_text_set_cursor_visible (ClutterText *self,
     {
       priv->cursor_visible = cursor_visible;
 
-      clutter_text_dirty_cache (self);
-      clutter_actor_queue_relayout (CLUTTER_ACTOR (self));
+      clutter_text_queue_redraw_cursor (self);
 
       g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CURSOR_VISIBLE]);
     }
@@ -4845,7 +5557,7 @@ clutter_text_set_selection_bound (ClutterText *self,
       else
         priv->selection_bound = selection_bound;
 
-      clutter_text_queue_redraw (CLUTTER_ACTOR (self));
+      clutter_text_queue_redraw_cursor (self);
 
       g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_SELECTION_BOUND]);
     }
@@ -5751,7 +6463,7 @@ clutter_text_set_cursor_position (ClutterText *self,
      time the cursor is moved up or down */
   priv->x_pos = -1;
 
-  clutter_text_queue_redraw (CLUTTER_ACTOR (self));
+  clutter_text_queue_redraw_cursor (self);
 
   /* XXX:2.0 - remove */
   g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_POSITION]);
@@ -5787,7 +6499,7 @@ clutter_text_set_cursor_size (ClutterText *self,
 
       priv->cursor_size = size;
 
-      clutter_text_queue_redraw (CLUTTER_ACTOR (self));
+      clutter_text_queue_redraw_cursor (self);
 
       g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_CURSOR_SIZE]);
     }
@@ -85,6 +85,7 @@
 #include "clutter-pan-action.h"
 #include "clutter-path-constraint.h"
 #include "clutter-path.h"
+#include "clutter-profiler.h"
 #include "clutter-property-transition.h"
 #include "clutter-rotate-action.h"
 #include "clutter-scriptable.h"
@@ -44,6 +44,7 @@
 #include "clutter-feature.h"
 #include "clutter-main.h"
 #include "clutter-private.h"
+#include "clutter-profiler-private.h"
 #include "clutter-stage-private.h"
 
 static void clutter_stage_window_iface_init (ClutterStageWindowIface *iface);
@@ -425,6 +426,7 @@ clutter_stage_cogl_redraw (ClutterStageWindow *stage_window)
   int damage[4], ndamage;
   gboolean force_swap;
   int window_scale;
+  gint64 swap_start;
 
   wrapper = CLUTTER_ACTOR (stage_cogl->wrapper);
 
@@ -613,6 +615,18 @@ clutter_stage_cogl_redraw (ClutterStageWindow *stage_window)
     }
 
   /* push on the screen */
+  swap_start = _clutter_profiler_begin ();
+
+  /* If we have swap buffer events then the swap functions return
+   * immediately and we need to track that there is a swap in progress;
+   * Cogl emits the frame events for the swaps of a region as well, and
+   * on Wayland it only emits them once the compositor asks for a new
+   * frame through the frame callback of the surface, which is what keeps
+   * us from drawing frames that are not going to be shown
+   */
+  if (clutter_feature_available (CLUTTER_FEATURE_SWAP_EVENTS))
+    stage_cogl->pending_swaps++;
+
   if (use_clipped_redraw && !force_swap)
     {
       CLUTTER_NOTE (BACKEND,
@@ -630,16 +644,14 @@ clutter_stage_cogl_redraw (ClutterStageWindow *stage_window)
       CLUTTER_NOTE (BACKEND, "cogl_onscreen_swap_buffers (onscreen: %p)",
                     stage_cogl->onscreen);
 
-      /* If we have swap buffer events then cogl_onscreen_swap_buffers
-       * will return immediately and we need to track that there is a
-       * swap in progress... */
-      if (clutter_feature_available (CLUTTER_FEATURE_SWAP_EVENTS))
-        stage_cogl->pending_swaps++;
-
       cogl_onscreen_swap_buffers_with_damage (stage_cogl->onscreen,
 					      damage, ndamage);
     }
 
+  _clutter_profiler_end (CLUTTER_PROFILER_PHASE_SWAP,
+                         stage_cogl->wrapper,
+                         swap_start);
+
   /* reset the redraw clipping for the next paint... */
   stage_cogl->initialized_redraw_clip = FALSE;
 
@@ -72,7 +72,6 @@
 #include "clutter-alpha.h"
 #include "clutter-behaviour.h"
 #include "clutter-behaviour-path.h"
-#include "clutter-bezier.h"
 #include "clutter-debug.h"
 #include "clutter-enum-types.h"
 #include "clutter-main.h"
@@ -65,6 +65,10 @@
 #define INITIAL_POINTER_X 16
 #define INITIAL_POINTER_Y 16
 
+/* The number of touch points tracked by each seat; this must fit in
+ * the bit masks of ClutterSeatEvdev */
+#define MAX_TOUCH_SLOTS 32
+
 typedef struct _ClutterTouchState ClutterTouchState;
 typedef struct _ClutterEventFilter ClutterEventFilter;
 
@@ -72,6 +76,10 @@ struct _ClutterTouchState
 {
   guint32 id;
   ClutterPoint coords;
+
+  /* the last motion, delivered with the next touch frame */
+  ClutterInputDevice *device;
+  guint32 time;
 };
 
 struct _ClutterSeatEvdev
@@ -84,7 +92,10 @@ struct _ClutterSeatEvdev
   ClutterInputDevice *core_pointer;
   ClutterInputDevice *core_keyboard;
 
-  GHashTable *touches;
+  /* indexed by seat slot */
+  ClutterTouchState touches[MAX_TOUCH_SLOTS];
+  guint32 active_touches;
+  guint32 pending_touches;
 
   struct xkb_state *xkb;
   xkb_led_index_t caps_lock_led;
@@ -100,6 +111,8 @@ struct _ClutterSeatEvdev
   guint32 repeat_count;
   guint32 repeat_timer;
   ClutterInputDevice *repeat_device;
+  ClutterEvent *repeat_event;
+  uint32_t repeat_button_state;
 
   gfloat pointer_x;
   gfloat pointer_y;
@@ -275,6 +288,8 @@ clear_repeat_timer (ClutterSeatEvdev *seat)
       seat->repeat_timer = 0;
       g_clear_object (&seat->repeat_device);
     }
+
+  g_clear_pointer (&seat->repeat_event, clutter_event_free);
 }
 
 static gboolean
@@ -357,6 +372,10 @@ notify_key_device (ClutterInputDevice *input_device,
         clear_repeat_timer (seat);
         seat->repeat_device = g_object_ref (input_device);
 
+        /* keep the translated event around for the repeats */
+        seat->repeat_event = clutter_event_copy (event);
+        seat->repeat_button_state = seat->button_state;
+
         if (seat->repeat_count == 1)
           interval = seat->repeat_delay;
         else
@@ -379,13 +398,46 @@ static gboolean
 keyboard_repeat (gpointer data)
 {
   ClutterSeatEvdev *seat = data;
+  ClutterEvent *event;
   guint32 time;
 
   g_return_val_if_fail (seat->repeat_device != NULL, G_SOURCE_REMOVE);
 
   time = g_source_get_time (g_main_context_find_source_by_id (NULL, seat->repeat_timer)) / 1000;
 
-  notify_key_device (seat->repeat_device, time, seat->repeat_key, AUTOREPEAT_VALUE, FALSE);
+  /* Any other key event stops or restarts the repeat, so the state of
+   * the keyboard cannot change while a key repeats, and we can reuse
+   * the event translated for the key press; we only need to go
+   * through xkb again if the pointer buttons or the stage changed
+   */
+  if (seat->repeat_event == NULL ||
+      seat->repeat_button_state != seat->button_state ||
+      clutter_event_get_stage (seat->repeat_event) !=
+        _clutter_input_device_get_stage (seat->repeat_device))
+    {
+      notify_key_device (seat->repeat_device, time, seat->repeat_key, AUTOREPEAT_VALUE, FALSE);
+      return G_SOURCE_CONTINUE;
+    }
+
+  event = clutter_event_copy (seat->repeat_event);
+  event->key.time = time;
+  clutter_event_set_flags (event, CLUTTER_EVENT_FLAG_SYNTHETIC);
+
+  queue_event (event);
+
+  seat->repeat_count += 1;
+
+  /* switch from the repeat delay to the repeat interval */
+  if (seat->repeat_count == 2)
+    {
+      seat->repeat_timer =
+        clutter_threads_add_timeout_full (CLUTTER_PRIORITY_EVENTS,
+                                          seat->repeat_interval,
+                                          keyboard_repeat,
+                                          seat,
+                                          NULL);
+      return G_SOURCE_REMOVE;
+    }
 
   return G_SOURCE_CONTINUE;
 }
@@ -976,12 +1028,6 @@ clutter_event_source_free (ClutterEventSource *source)
   g_source_unref (g_source);
 }
 
-static void
-clutter_touch_state_free (ClutterTouchState *touch_state)
-{
-  g_slice_free (ClutterTouchState, touch_state);
-}
-
 static void
 clutter_seat_evdev_set_libinput_seat (ClutterSeatEvdev *seat,
                                       struct libinput_seat *libinput_seat)
@@ -1025,9 +1071,6 @@ clutter_seat_evdev_new (ClutterDeviceManagerEvdev *manager_evdev)
   _clutter_device_manager_add_device (manager, device);
   seat->core_keyboard = device;
 
-  seat->touches = g_hash_table_new_full (NULL, NULL, NULL,
-                                         (GDestroyNotify) clutter_touch_state_free);
-
   ctx = xkb_context_new(0);
   g_assert (ctx);
 
@@ -1073,7 +1116,6 @@ clutter_seat_evdev_free (ClutterSeatEvdev *seat)
       g_object_unref (device);
     }
   g_slist_free (seat->devices);
-  g_hash_table_unref (seat->touches);
 
   xkb_state_unref (seat->xkb);
 
@@ -1189,6 +1231,7 @@ clutter_device_manager_evdev_remove_device (ClutterDeviceManager *manager,
   ClutterDeviceManagerEvdevPrivate *priv;
   ClutterInputDeviceEvdev *device_evdev;
   ClutterSeatEvdev *seat;
+  guint i;
 
   device_evdev = CLUTTER_INPUT_DEVICE_EVDEV (device);
   seat = _clutter_input_device_evdev_get_seat (device_evdev);
@@ -1202,6 +1245,17 @@ clutter_device_manager_evdev_remove_device (ClutterDeviceManager *manager,
   if (seat->repeat_timer && seat->repeat_device == device)
     clear_repeat_timer (seat);
 
+  /* forget the touch points of the device */
+  for (i = 0; i < MAX_TOUCH_SLOTS; i++)
+    {
+      if (seat->touches[i].device == device)
+        {
+          seat->active_touches &= ~(1u << i);
+          seat->pending_touches &= ~(1u << i);
+          seat->touches[i].device = NULL;
+        }
+    }
+
   g_object_unref (device);
 }
 
@@ -1341,41 +1395,82 @@ process_base_event (ClutterDeviceManagerEvdev *manager_evdev,
 
 static ClutterTouchState *
 _device_seat_add_touch (ClutterInputDevice *input_device,
-                        guint32             id)
+                        gint32              id)
 {
   ClutterInputDeviceEvdev *device_evdev =
     CLUTTER_INPUT_DEVICE_EVDEV (input_device);
   ClutterSeatEvdev *seat = _clutter_input_device_evdev_get_seat (device_evdev);
   ClutterTouchState *touch;
 
-  touch = g_slice_new0 (ClutterTouchState);
+  if (id < 0 || id >= MAX_TOUCH_SLOTS)
+    {
+      g_warning ("Ignoring touch point in seat slot %d, only %d touch points "
+                 "are supported", id, MAX_TOUCH_SLOTS);
+      return NULL;
+    }
+
+  touch = &seat->touches[id];
   touch->id = id;
+  touch->device = input_device;
 
-  g_hash_table_insert (seat->touches, GUINT_TO_POINTER (id), touch);
+  seat->active_touches |= 1u << id;
+  seat->pending_touches &= ~(1u << id);
 
   return touch;
 }
 
 static void
 _device_seat_remove_touch (ClutterInputDevice *input_device,
-                           guint32             id)
+                           gint32              id)
 {
   ClutterInputDeviceEvdev *device_evdev =
     CLUTTER_INPUT_DEVICE_EVDEV (input_device);
   ClutterSeatEvdev *seat = _clutter_input_device_evdev_get_seat (device_evdev);
 
-  g_hash_table_remove (seat->touches, GUINT_TO_POINTER (id));
+  if (id < 0 || id >= MAX_TOUCH_SLOTS)
+    return;
+
+  seat->active_touches &= ~(1u << id);
+  seat->pending_touches &= ~(1u << id);
 }
 
 static ClutterTouchState *
 _device_seat_get_touch (ClutterInputDevice *input_device,
-                        guint32             id)
+                        gint32              id)
 {
   ClutterInputDeviceEvdev *device_evdev =
     CLUTTER_INPUT_DEVICE_EVDEV (input_device);
   ClutterSeatEvdev *seat = _clutter_input_device_evdev_get_seat (device_evdev);
 
-  return g_hash_table_lookup (seat->touches, GUINT_TO_POINTER (id));
+  if (id < 0 || id >= MAX_TOUCH_SLOTS ||
+      (seat->active_touches & (1u << id)) == 0)
+    return NULL;
+
+  return &seat->touches[id];
+}
+
+static void
+_device_seat_flush_touch (ClutterSeatEvdev *seat,
+                          gint32            id)
+{
+  ClutterTouchState *touch = &seat->touches[id];
+
+  seat->pending_touches &= ~(1u << id);
+
+  notify_touch_event (touch->device, CLUTTER_TOUCH_UPDATE, touch->time, id,
+                      touch->coords.x, touch->coords.y);
+}
+
+/* Touch motions are accumulated until the end of the touch frame, so
+ * that all the touch points that moved together are queued together,
+ * and a touch point that moved more than once only sends its last
+ * position
+ */
+static void
+_device_seat_flush_touches (ClutterSeatEvdev *seat)
+{
+  while (seat->pending_touches != 0)
+    _device_seat_flush_touch (seat, g_bit_nth_lsf (seat->pending_touches, -1));
 }
 
 static void
@@ -1690,7 +1785,7 @@ process_device_event (ClutterDeviceManagerEvdev *manager_evdev,
         stage_width = clutter_actor_get_width (CLUTTER_ACTOR (stage));
         stage_height = clutter_actor_get_height (CLUTTER_ACTOR (stage));
 
-        slot = libinput_event_touch_get_slot (touch_event);
+        slot = libinput_event_touch_get_seat_slot (touch_event);
         time = libinput_event_touch_get_time (touch_event);
         x = libinput_event_touch_get_x_transformed (touch_event,
                                                     stage_width);
@@ -1698,6 +1793,9 @@ process_device_event (ClutterDeviceManagerEvdev *manager_evdev,
                                                     stage_height);
 
         touch_state = _device_seat_add_touch (device, slot);
+        if (touch_state == NULL)
+          break;
+
         touch_state->coords.x = x;
         touch_state->coords.y = y;
 
@@ -1711,13 +1809,20 @@ process_device_event (ClutterDeviceManagerEvdev *manager_evdev,
         gint32 slot;
         guint32 time;
         ClutterTouchState *touch_state;
+        ClutterSeatEvdev *seat;
         struct libinput_event_touch *touch_event =
           libinput_event_get_touch_event (event);
         device = libinput_device_get_user_data (libinput_device);
 
-        slot = libinput_event_touch_get_slot (touch_event);
+        slot = libinput_event_touch_get_seat_slot (touch_event);
         time = libinput_event_touch_get_time (touch_event);
         touch_state = _device_seat_get_touch (device, slot);
+        if (touch_state == NULL)
+          break;
+
+        seat = _clutter_input_device_evdev_get_seat (CLUTTER_INPUT_DEVICE_EVDEV (device));
+        if (seat->pending_touches & (1u << slot))
+          _device_seat_flush_touch (seat, slot);
 
         notify_touch_event (device, CLUTTER_TOUCH_END, time, slot,
 			    touch_state->coords.x, touch_state->coords.y);
@@ -1745,7 +1850,7 @@ process_device_event (ClutterDeviceManagerEvdev *manager_evdev,
         stage_width = clutter_actor_get_width (CLUTTER_ACTOR (stage));
         stage_height = clutter_actor_get_height (CLUTTER_ACTOR (stage));
 
-        slot = libinput_event_touch_get_slot (touch_event);
+        slot = libinput_event_touch_get_seat_slot (touch_event);
         time = libinput_event_touch_get_time (touch_event);
         x = libinput_event_touch_get_x_transformed (touch_event,
                                                     stage_width);
@@ -1753,17 +1858,32 @@ process_device_event (ClutterDeviceManagerEvdev *manager_evdev,
                                                     stage_height);
 
         touch_state = _device_seat_get_touch (device, slot);
+        if (touch_state == NULL)
+          break;
+
         touch_state->coords.x = x;
         touch_state->coords.y = y;
+        touch_state->device = device;
+        touch_state->time = time;
 
-        notify_touch_event (device, CLUTTER_TOUCH_UPDATE, time, slot,
-			    touch_state->coords.x, touch_state->coords.y);
+        /* the update is queued at the end of the touch frame */
+        seat = _clutter_input_device_evdev_get_seat (CLUTTER_INPUT_DEVICE_EVDEV (device));
+        seat->pending_touches |= 1u << slot;
+        break;
+      }
+    case LIBINPUT_EVENT_TOUCH_FRAME:
+      {
+        ClutterSeatEvdev *seat;
+
+        device = libinput_device_get_user_data (libinput_device);
+        seat = _clutter_input_device_evdev_get_seat (CLUTTER_INPUT_DEVICE_EVDEV (device));
+
+        _device_seat_flush_touches (seat);
         break;
       }
     case LIBINPUT_EVENT_TOUCH_CANCEL:
       {
         ClutterTouchState *touch_state;
-        GHashTableIter iter;
         guint32 time;
         struct libinput_event_touch *touch_event =
           libinput_event_get_touch_event (event);
@@ -1772,14 +1892,19 @@ process_device_event (ClutterDeviceManagerEvdev *manager_evdev,
         device = libinput_device_get_user_data (libinput_device);
         time = libinput_event_touch_get_time (touch_event);
         seat = _clutter_input_device_evdev_get_seat (CLUTTER_INPUT_DEVICE_EVDEV (device));
-        g_hash_table_iter_init (&iter, seat->touches);
 
-        while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &touch_state))
+        /* pending motions are dropped along with the touch points */
+        seat->pending_touches = 0;
+
+        while (seat->active_touches != 0)
           {
+            gint32 slot = g_bit_nth_lsf (seat->active_touches, -1);
+
+            touch_state = &seat->touches[slot];
             notify_touch_event (device, CLUTTER_TOUCH_CANCEL,
                                 time, touch_state->id,
                                 touch_state->coords.x, touch_state->coords.y);
-            g_hash_table_iter_remove (&iter);
+            _device_seat_remove_touch (device, slot);
           }
 
         break;
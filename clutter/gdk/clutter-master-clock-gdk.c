@@ -38,6 +38,7 @@
 #include "clutter-master-clock.h"
 #include "clutter-master-clock-gdk.h"
 #include "clutter-stage-gdk.h"
+#include "clutter-actor-private.h"
 #include "clutter-debug.h"
 #include "clutter-private.h"
 #include "clutter-stage-manager-private.h"
@@ -218,9 +219,14 @@ master_clock_advance_timelines (ClutterMasterClockGdk *master_clock)
   timelines = g_slist_copy (master_clock->timelines);
   g_slist_foreach (timelines, (GFunc) g_object_ref, NULL);
 
+  /* coalesce the property notifications of the actors being animated */
+  _clutter_actor_push_deferred_notify ();
+
   for (l = timelines; l != NULL; l = l->next)
     _clutter_timeline_do_tick (l->data, master_clock->cur_tick / 1000);
 
+  _clutter_actor_pop_deferred_notify ();
+
   g_slist_foreach (timelines, (GFunc) g_object_unref, NULL);
   g_slist_free (timelines);
 
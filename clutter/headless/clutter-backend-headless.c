@@ -0,0 +1,242 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "clutter-backend-headless.h"
+#include "clutter-device-manager-headless.h"
+#include "clutter-stage-headless.h"
+#include "clutter-headless.h"
+
+#include "clutter-debug.h"
+#include "clutter-main.h"
+#include "clutter-master-clock.h"
+#include "clutter-private.h"
+#include "clutter-settings.h"
+
+G_DEFINE_TYPE (ClutterBackendHeadless, clutter_backend_headless, CLUTTER_TYPE_BACKEND);
+
+static gboolean _virtual_time = TRUE;
+
+static gboolean
+clutter_backend_headless_post_parse (ClutterBackend  *backend,
+                                     GError         **error)
+{
+  /* there is no screen to query, so use a fixed resolution; this
+   * also makes the layout of text independent from the host
+   */
+  g_object_set (clutter_settings_get_default (), "font-dpi", 96 * 1024, NULL);
+
+  return TRUE;
+}
+
+static CoglDisplay *
+clutter_backend_headless_get_display (ClutterBackend  *backend,
+                                      CoglRenderer    *renderer,
+                                      CoglSwapChain   *swap_chain,
+                                      GError         **error)
+{
+  /* we never create onscreen framebuffers, so there is no need to
+   * check the onscreen template against the renderer
+   */
+  return cogl_display_new (renderer, NULL);
+}
+
+/* Creates a context using Cogl's stub window system and the no-op
+ * driver; nothing is rendered, but the whole scene graph is still
+ * updated, laid out and painted, so this is enough for measuring the
+ * CPU side of a frame on machines without any GL implementation
+ */
+static gboolean
+clutter_backend_headless_create_nop_context (ClutterBackend  *backend,
+                                             GError         **error)
+{
+  CoglRenderer *renderer;
+  CoglDisplay *display = NULL;
+
+  renderer = cogl_renderer_new ();
+  cogl_renderer_set_winsys_id (renderer, COGL_WINSYS_ID_STUB);
+  cogl_renderer_set_driver (renderer, COGL_DRIVER_NOP);
+
+  if (!cogl_renderer_connect (renderer, error))
+    goto error;
+
+  display = cogl_display_new (renderer, NULL);
+  if (!cogl_display_setup (display, error))
+    goto error;
+
+  backend->cogl_context = cogl_context_new (display, error);
+  if (backend->cogl_context == NULL)
+    goto error;
+
+  backend->cogl_renderer = renderer;
+  backend->cogl_display = display;
+
+  /* the display owns the renderer */
+  cogl_object_unref (renderer);
+
+  backend->cogl_source = cogl_glib_source_new (backend->cogl_context, G_PRIORITY_DEFAULT);
+  g_source_attach (backend->cogl_source, NULL);
+
+  return TRUE;
+
+error:
+  if (display != NULL)
+    cogl_object_unref (display);
+
+  cogl_object_unref (renderer);
+
+  return FALSE;
+}
+
+static gboolean
+clutter_backend_headless_create_context (ClutterBackend  *backend,
+                                         GError         **error)
+{
+  ClutterBackendClass *parent_class =
+    CLUTTER_BACKEND_CLASS (clutter_backend_headless_parent_class);
+  GError *internal_error = NULL;
+
+  if (parent_class->create_context (backend, &internal_error))
+    return TRUE;
+
+  /* if a driver was explicitly requested, we should not ignore it */
+  if (g_getenv ("CLUTTER_DRIVER") != NULL)
+    {
+      g_propagate_error (error, internal_error);
+      return FALSE;
+    }
+
+  CLUTTER_NOTE (BACKEND, "Unable to create a GL context (%s), using the no-op driver",
+                internal_error->message);
+  g_error_free (internal_error);
+
+  return clutter_backend_headless_create_nop_context (backend, error);
+}
+
+static ClutterFeatureFlags
+clutter_backend_headless_get_features (ClutterBackend *backend)
+{
+  /* offscreen framebuffers are not tied to a window system, so we can
+   * have as many stages as we want; we never synchronize to the
+   * vertical refresh, as there is none
+   */
+  return CLUTTER_FEATURE_STAGE_MULTIPLE;
+}
+
+static void
+clutter_backend_headless_init_events (ClutterBackend *backend)
+{
+  ClutterMasterClock *master_clock;
+
+  CLUTTER_NOTE (EVENT, "Creating the headless device manager");
+
+  backend->device_manager = _clutter_device_manager_headless_new (backend);
+
+  master_clock = _clutter_master_clock_get_default ();
+  _clutter_master_clock_set_virtual_time (master_clock, _virtual_time);
+}
+
+static void
+clutter_backend_headless_dispose (GObject *gobject)
+{
+  ClutterBackend *backend = CLUTTER_BACKEND (gobject);
+
+  g_clear_object (&backend->device_manager);
+
+  G_OBJECT_CLASS (clutter_backend_headless_parent_class)->dispose (gobject);
+}
+
+static void
+clutter_backend_headless_class_init (ClutterBackendHeadlessClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  ClutterBackendClass *backend_class = CLUTTER_BACKEND_CLASS (klass);
+
+  gobject_class->dispose = clutter_backend_headless_dispose;
+
+  backend_class->stage_window_type = CLUTTER_TYPE_STAGE_HEADLESS;
+
+  backend_class->post_parse = clutter_backend_headless_post_parse;
+  backend_class->get_display = clutter_backend_headless_get_display;
+  backend_class->create_context = clutter_backend_headless_create_context;
+  backend_class->get_features = clutter_backend_headless_get_features;
+  backend_class->init_events = clutter_backend_headless_init_events;
+}
+
+static void
+clutter_backend_headless_init (ClutterBackendHeadless *backend_headless)
+{
+}
+
+ClutterBackend *
+clutter_backend_headless_new (void)
+{
+  return g_object_new (CLUTTER_TYPE_BACKEND_HEADLESS, NULL);
+}
+
+/**
+ * clutter_headless_set_virtual_time:
+ * @virtual_time: whether the master clock should run in virtual time
+ *
+ * Sets whether the master clock of the headless backend should run in
+ * virtual time.
+ *
+ * In virtual time, frames are drawn one after the other without
+ * waiting, and the time advances by exactly one frame interval, as
+ * defined by clutter_get_default_frame_rate(), at each frame. Timeouts
+ * and other sources in the main loop are not affected.
+ *
+ * Virtual time is enabled by default. This function can be called
+ * before or after clutter_init().
+ *
+ * Since: 1.26
+ */
+void
+clutter_headless_set_virtual_time (gboolean virtual_time)
+{
+  _virtual_time = !!virtual_time;
+
+  if (!_clutter_context_is_initialized ())
+    return;
+
+  g_return_if_fail (CLUTTER_IS_BACKEND_HEADLESS (clutter_get_default_backend ()));
+
+  _clutter_master_clock_set_virtual_time (_clutter_master_clock_get_default (),
+                                          _virtual_time);
+}
+
+/**
+ * clutter_headless_get_virtual_time:
+ *
+ * Retrieves whether the master clock of the headless backend runs in
+ * virtual time.
+ *
+ * Return value: %TRUE if virtual time is enabled
+ *
+ * Since: 1.26
+ */
+gboolean
+clutter_headless_get_virtual_time (void)
+{
+  return _virtual_time;
+}
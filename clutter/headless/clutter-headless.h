@@ -0,0 +1,62 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * SECTION:clutter-headless
+ * @short_description: Headless specific API
+ *
+ * The headless backend for Clutter does not need a windowing system:
+ * each #ClutterStage is rendered into an offscreen framebuffer, and
+ * input can only be synthesized, for instance using clutter_event_put()
+ * with the core devices of the #ClutterDeviceManager.
+ *
+ * The headless backend is meant for testing and benchmarking; it can
+ * be selected by setting the `CLUTTER_BACKEND` environment variable
+ * to "headless", or by calling clutter_set_windowing_backend() with
+ * %CLUTTER_WINDOWING_HEADLESS.
+ *
+ * By default, the master clock of the headless backend runs in virtual
+ * time: frames are drawn back to back, and each frame advances the
+ * time seen by timelines by exactly one frame interval, as defined by
+ * the `CLUTTER_DEFAULT_FPS` environment variable. This makes the state
+ * of animations at each frame independent of the speed of the machine.
+ *
+ * The Clutter headless API is available since Clutter 1.26
+ */
+
+#ifndef __CLUTTER_HEADLESS_H__
+#define __CLUTTER_HEADLESS_H__
+
+#include <glib.h>
+#include <clutter/clutter.h>
+
+G_BEGIN_DECLS
+
+CLUTTER_AVAILABLE_IN_1_26
+void            clutter_headless_set_virtual_time       (gboolean      virtual_time);
+CLUTTER_AVAILABLE_IN_1_26
+gboolean        clutter_headless_get_virtual_time       (void);
+
+CLUTTER_AVAILABLE_IN_1_26
+guint           clutter_headless_stage_get_frame_count  (ClutterStage *stage);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_HEADLESS_H__ */
@@ -0,0 +1,373 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "clutter-stage-headless.h"
+#include "clutter-headless.h"
+
+#include "clutter-backend-private.h"
+#include "clutter-debug.h"
+#include "clutter-main.h"
+#include "clutter-private.h"
+#include "clutter-profiler-private.h"
+#include "clutter-stage-private.h"
+#include "clutter-stage-window.h"
+
+#define DEFAULT_WIDTH   640
+#define DEFAULT_HEIGHT  480
+
+enum
+{
+  PROP_0,
+
+  PROP_WRAPPER,
+  PROP_BACKEND,
+
+  PROP_LAST
+};
+
+static void clutter_stage_window_iface_init (ClutterStageWindowIface *iface);
+
+#define clutter_stage_headless_get_type _clutter_stage_headless_get_type
+
+G_DEFINE_TYPE_WITH_CODE (ClutterStageHeadless,
+                         clutter_stage_headless,
+                         G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (CLUTTER_TYPE_STAGE_WINDOW,
+                                                clutter_stage_window_iface_init));
+
+static gboolean
+clutter_stage_headless_ensure_offscreen (ClutterStageHeadless  *stage_headless,
+                                         GError               **error)
+{
+  CoglContext *context = stage_headless->backend->cogl_context;
+  CoglTexture2D *texture;
+  CoglOffscreen *offscreen;
+
+  if (stage_headless->offscreen != NULL)
+    return TRUE;
+
+  CLUTTER_NOTE (BACKEND, "Creating a %dx%d offscreen framebuffer for stage [%p]",
+                stage_headless->width,
+                stage_headless->height,
+                stage_headless);
+
+  texture = cogl_texture_2d_new_with_size (context,
+                                           stage_headless->width,
+                                           stage_headless->height);
+
+  /* the offscreen framebuffer owns the texture */
+  offscreen = cogl_offscreen_new_with_texture (COGL_TEXTURE (texture));
+  cogl_object_unref (texture);
+
+  if (!cogl_framebuffer_allocate (COGL_FRAMEBUFFER (offscreen), error))
+    {
+      cogl_object_unref (offscreen);
+      return FALSE;
+    }
+
+  stage_headless->offscreen = offscreen;
+
+  return TRUE;
+}
+
+static gboolean
+clutter_stage_headless_realize (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+  GError *error = NULL;
+
+  CLUTTER_NOTE (BACKEND, "Realizing stage '%s' [%p]",
+                G_OBJECT_TYPE_NAME (stage_headless),
+                stage_headless);
+
+  if (stage_headless->backend->cogl_context == NULL)
+    {
+      g_warning ("Failed to realize stage: missing Cogl context");
+      return FALSE;
+    }
+
+  if (!clutter_stage_headless_ensure_offscreen (stage_headless, &error))
+    {
+      g_warning ("Failed to allocate stage: %s", error->message);
+      g_error_free (error);
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+clutter_stage_headless_unrealize (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  CLUTTER_NOTE (BACKEND, "Unrealizing stage [%p]", stage_headless);
+
+  if (stage_headless->offscreen != NULL)
+    {
+      cogl_object_unref (stage_headless->offscreen);
+      stage_headless->offscreen = NULL;
+    }
+}
+
+static ClutterActor *
+clutter_stage_headless_get_wrapper (ClutterStageWindow *stage_window)
+{
+  return CLUTTER_ACTOR (CLUTTER_STAGE_HEADLESS (stage_window)->wrapper);
+}
+
+static void
+clutter_stage_headless_show (ClutterStageWindow *stage_window,
+                             gboolean            do_raise)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  clutter_actor_map (CLUTTER_ACTOR (stage_headless->wrapper));
+}
+
+static void
+clutter_stage_headless_hide (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  clutter_actor_unmap (CLUTTER_ACTOR (stage_headless->wrapper));
+}
+
+static void
+clutter_stage_headless_get_geometry (ClutterStageWindow    *stage_window,
+                                     cairo_rectangle_int_t *geometry)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  if (geometry != NULL)
+    {
+      geometry->x = geometry->y = 0;
+      geometry->width = stage_headless->width;
+      geometry->height = stage_headless->height;
+    }
+}
+
+static void
+clutter_stage_headless_resize (ClutterStageWindow *stage_window,
+                               gint                width,
+                               gint                height)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  if (width <= 0 || height <= 0)
+    return;
+
+  if (width == stage_headless->width && height == stage_headless->height)
+    return;
+
+  stage_headless->width = width;
+  stage_headless->height = height;
+
+  /* the framebuffer is created again with the new size when needed */
+  if (stage_headless->offscreen != NULL)
+    {
+      cogl_object_unref (stage_headless->offscreen);
+      stage_headless->offscreen = NULL;
+    }
+}
+
+static void
+clutter_stage_headless_schedule_update (ClutterStageWindow *stage_window,
+                                        gint                sync_delay)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  /* there is no vertical refresh to synchronize with, so every update
+   * is due as soon as it is scheduled
+   */
+  if (stage_headless->update_time != -1)
+    return;
+
+  stage_headless->update_time = 0;
+}
+
+static gint64
+clutter_stage_headless_get_update_time (ClutterStageWindow *stage_window)
+{
+  return CLUTTER_STAGE_HEADLESS (stage_window)->update_time;
+}
+
+static void
+clutter_stage_headless_clear_update_time (ClutterStageWindow *stage_window)
+{
+  CLUTTER_STAGE_HEADLESS (stage_window)->update_time = -1;
+}
+
+static void
+clutter_stage_headless_redraw (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+  gint64 finish_start;
+
+  if (stage_headless->offscreen == NULL)
+    return;
+
+  _clutter_stage_do_paint (stage_headless->wrapper, NULL);
+
+  /* there is no buffer swap to wait on, so we wait for the rendering
+   * to complete instead; this keeps the cost of the frame on the GPU
+   * within the frame, as it would be on a real window system
+   */
+  finish_start = _clutter_profiler_begin ();
+
+  cogl_framebuffer_finish (COGL_FRAMEBUFFER (stage_headless->offscreen));
+
+  _clutter_profiler_end (CLUTTER_PROFILER_PHASE_SWAP,
+                         stage_headless->wrapper,
+                         finish_start);
+
+  stage_headless->frame_count += 1;
+}
+
+static CoglFramebuffer *
+clutter_stage_headless_get_active_framebuffer (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+  GError *error = NULL;
+
+  if (stage_headless->backend->cogl_context == NULL)
+    return NULL;
+
+  if (!clutter_stage_headless_ensure_offscreen (stage_headless, &error))
+    {
+      g_critical ("Unable to allocate the stage framebuffer: %s",
+                  error->message);
+      g_error_free (error);
+      return NULL;
+    }
+
+  return COGL_FRAMEBUFFER (stage_headless->offscreen);
+}
+
+static gboolean
+clutter_stage_headless_can_clip_redraws (ClutterStageWindow *stage_window)
+{
+  return FALSE;
+}
+
+static void
+clutter_stage_window_iface_init (ClutterStageWindowIface *iface)
+{
+  iface->realize = clutter_stage_headless_realize;
+  iface->unrealize = clutter_stage_headless_unrealize;
+  iface->get_wrapper = clutter_stage_headless_get_wrapper;
+  iface->get_geometry = clutter_stage_headless_get_geometry;
+  iface->resize = clutter_stage_headless_resize;
+  iface->show = clutter_stage_headless_show;
+  iface->hide = clutter_stage_headless_hide;
+  iface->schedule_update = clutter_stage_headless_schedule_update;
+  iface->get_update_time = clutter_stage_headless_get_update_time;
+  iface->clear_update_time = clutter_stage_headless_clear_update_time;
+  iface->redraw = clutter_stage_headless_redraw;
+  iface->get_active_framebuffer = clutter_stage_headless_get_active_framebuffer;
+  iface->can_clip_redraws = clutter_stage_headless_can_clip_redraws;
+}
+
+static void
+clutter_stage_headless_set_property (GObject      *gobject,
+                                     guint         prop_id,
+                                     const GValue *value,
+                                     GParamSpec   *pspec)
+{
+  ClutterStageHeadless *self = CLUTTER_STAGE_HEADLESS (gobject);
+
+  switch (prop_id)
+    {
+    case PROP_WRAPPER:
+      self->wrapper = g_value_get_object (value);
+      break;
+
+    case PROP_BACKEND:
+      self->backend = g_value_get_object (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
+      break;
+    }
+}
+
+static void
+clutter_stage_headless_dispose (GObject *gobject)
+{
+  clutter_stage_headless_unrealize (CLUTTER_STAGE_WINDOW (gobject));
+
+  G_OBJECT_CLASS (clutter_stage_headless_parent_class)->dispose (gobject);
+}
+
+static void
+clutter_stage_headless_class_init (ClutterStageHeadlessClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->set_property = clutter_stage_headless_set_property;
+  gobject_class->dispose = clutter_stage_headless_dispose;
+
+  g_object_class_override_property (gobject_class, PROP_WRAPPER, "wrapper");
+  g_object_class_override_property (gobject_class, PROP_BACKEND, "backend");
+}
+
+static void
+clutter_stage_headless_init (ClutterStageHeadless *stage)
+{
+  stage->width = DEFAULT_WIDTH;
+  stage->height = DEFAULT_HEIGHT;
+
+  stage->update_time = -1;
+}
+
+/**
+ * clutter_headless_stage_get_frame_count:
+ * @stage: a #ClutterStage
+ *
+ * Retrieves the number of frames that have been drawn into the
+ * offscreen framebuffer of @stage.
+ *
+ * This function can only be used with the headless backend.
+ *
+ * Return value: the number of frames drawn
+ *
+ * Since: 1.26
+ */
+guint
+clutter_headless_stage_get_frame_count (ClutterStage *stage)
+{
+  ClutterStageWindow *stage_window;
+
+  g_return_val_if_fail (CLUTTER_IS_STAGE (stage), 0);
+
+  stage_window = _clutter_stage_get_window (stage);
+  if (stage_window == NULL || !CLUTTER_IS_STAGE_HEADLESS (stage_window))
+    {
+      g_critical ("The stage is not a headless stage");
+      return 0;
+    }
+
+  return CLUTTER_STAGE_HEADLESS (stage_window)->frame_count;
+}
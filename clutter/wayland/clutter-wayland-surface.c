@@ -76,6 +76,16 @@ struct _ClutterWaylandSurfacePrivate
   CoglTexture2D *buffer;
   int width, height;
   CoglPipeline *pipeline;
+
+  /* SHM buffers of the same size and format are uploaded into two
+   * textures used in turn, so that we never update the texture that
+   * the last frame is still using; each texture keeps the region that
+   * was damaged since it was last updated
+   */
+  CoglTexture2D *shm_textures[2];
+  cairo_region_t *shm_stale[2];
+  guint shm_current;
+  uint32_t shm_format;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE (ClutterWaylandSurface,
@@ -172,6 +182,7 @@ static void
 free_surface_buffers (ClutterWaylandSurface *self)
 {
   ClutterWaylandSurfacePrivate *priv = self->priv;
+  guint i;
 
   if (priv->buffer)
     {
@@ -179,6 +190,124 @@ free_surface_buffers (ClutterWaylandSurface *self)
       priv->buffer = NULL;
       free_pipeline (self);
     }
+
+  for (i = 0; i < G_N_ELEMENTS (priv->shm_textures); i++)
+    {
+      if (priv->shm_textures[i])
+        {
+          cogl_object_unref (priv->shm_textures[i]);
+          priv->shm_textures[i] = NULL;
+        }
+
+      g_clear_pointer (&priv->shm_stale[i], cairo_region_destroy);
+    }
+}
+
+static CoglPixelFormat
+get_shm_pixel_format (struct wl_shm_buffer *shm_buffer)
+{
+  switch (wl_shm_buffer_get_format (shm_buffer))
+    {
+#if G_BYTE_ORDER == G_BIG_ENDIAN
+    case WL_SHM_FORMAT_ARGB8888:
+      return COGL_PIXEL_FORMAT_ARGB_8888_PRE;
+    case WL_SHM_FORMAT_XRGB8888:
+      return COGL_PIXEL_FORMAT_ARGB_8888;
+#elif G_BYTE_ORDER == G_LITTLE_ENDIAN
+    case WL_SHM_FORMAT_ARGB8888:
+      return COGL_PIXEL_FORMAT_BGRA_8888_PRE;
+    case WL_SHM_FORMAT_XRGB8888:
+      return COGL_PIXEL_FORMAT_BGRA_8888;
+#endif
+    default:
+      g_warn_if_reached ();
+      return COGL_PIXEL_FORMAT_ARGB_8888;
+    }
+}
+
+static void
+upload_shm_region (CoglTexture2D        *texture,
+                   struct wl_shm_buffer *shm_buffer,
+                   int                   x,
+                   int                   y,
+                   int                   width,
+                   int                   height)
+{
+  cogl_texture_set_region (COGL_TEXTURE (texture),
+                           x, y,
+                           x, y,
+                           width, height,
+                           width, height,
+                           get_shm_pixel_format (shm_buffer),
+                           wl_shm_buffer_get_stride (shm_buffer),
+                           wl_shm_buffer_get_data (shm_buffer));
+}
+
+/* Tries to reuse the textures of the previous SHM buffers for
+ * @shm_buffer, which is possible if its size and format did not
+ * change; only the parts of the texture that were damaged since it
+ * was last used are uploaded, and the damage of the new buffer is
+ * uploaded by clutter_wayland_surface_damage_buffer()
+ */
+static gboolean
+reuse_shm_texture (ClutterWaylandSurface *self,
+                   struct wl_resource    *buffer,
+                   struct wl_shm_buffer  *shm_buffer)
+{
+  ClutterWaylandSurfacePrivate *priv = self->priv;
+  ClutterBackend *backend = clutter_get_default_backend ();
+  CoglContext *context = clutter_backend_get_cogl_context (backend);
+  guint next = 1 - priv->shm_current;
+  int i, n_rects;
+
+  if (priv->buffer == NULL ||
+      priv->buffer != priv->shm_textures[priv->shm_current] ||
+      wl_shm_buffer_get_width (shm_buffer) != priv->width ||
+      wl_shm_buffer_get_height (shm_buffer) != priv->height ||
+      wl_shm_buffer_get_format (shm_buffer) != priv->shm_format)
+    return FALSE;
+
+  if (priv->shm_textures[next] == NULL)
+    {
+      priv->shm_textures[next] =
+        cogl_wayland_texture_2d_new_from_buffer (context, buffer, NULL);
+
+      if (priv->shm_textures[next] == NULL)
+        return FALSE;
+
+      priv->shm_stale[next] = cairo_region_create ();
+    }
+  else
+    {
+      cairo_rectangle_int_t bounds = { 0, 0, priv->width, priv->height };
+
+      /* the damage is not clipped to the buffer by the clients */
+      cairo_region_intersect_rectangle (priv->shm_stale[next], &bounds);
+
+      n_rects = cairo_region_num_rectangles (priv->shm_stale[next]);
+
+      for (i = 0; i < n_rects; i++)
+        {
+          cairo_rectangle_int_t rect;
+
+          cairo_region_get_rectangle (priv->shm_stale[next], i, &rect);
+          upload_shm_region (priv->shm_textures[next], shm_buffer,
+                             rect.x, rect.y,
+                             rect.width, rect.height);
+        }
+
+      cairo_region_subtract (priv->shm_stale[next], priv->shm_stale[next]);
+    }
+
+  cogl_object_unref (priv->buffer);
+  priv->buffer = cogl_object_ref (priv->shm_textures[next]);
+  priv->shm_current = next;
+
+  if (priv->pipeline != NULL)
+    cogl_pipeline_set_layer_texture (priv->pipeline, 0,
+                                     COGL_TEXTURE (priv->buffer));
+
+  return TRUE;
 }
 
 static void
@@ -529,16 +658,33 @@ clutter_wayland_surface_attach_buffer (ClutterWaylandSurface *self,
   ClutterWaylandSurfacePrivate *priv;
   ClutterBackend *backend = clutter_get_default_backend ();
   CoglContext *context = clutter_backend_get_cogl_context (backend);
+  struct wl_shm_buffer *shm_buffer;
 
   g_return_val_if_fail (CLUTTER_WAYLAND_IS_SURFACE (self), TRUE);
 
   priv = self->priv;
 
+  shm_buffer = wl_shm_buffer_get (buffer);
+
+  if (shm_buffer != NULL && reuse_shm_texture (self, buffer, shm_buffer))
+    {
+      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_COGL_TEXTURE]);
+      return TRUE;
+    }
+
   free_surface_buffers (self);
 
   priv->buffer =
     cogl_wayland_texture_2d_new_from_buffer (context, buffer, error);
 
+  if (priv->buffer != NULL && shm_buffer != NULL)
+    {
+      priv->shm_textures[0] = cogl_object_ref (priv->buffer);
+      priv->shm_stale[0] = cairo_region_create ();
+      priv->shm_current = 0;
+      priv->shm_format = wl_shm_buffer_get_format (shm_buffer);
+    }
+
   g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_COGL_TEXTURE]);
 
   /* NB: We don't queue a redraw of the actor here because we don't
@@ -594,38 +740,20 @@ clutter_wayland_surface_damage_buffer (ClutterWaylandSurface *self,
 
   if (priv->buffer && shm_buffer)
     {
-      CoglPixelFormat format;
+      upload_shm_region (priv->buffer, shm_buffer, x, y, width, height);
 
-      switch (wl_shm_buffer_get_format (shm_buffer))
+      /* the other texture needs the same update before it is used */
+      if (priv->buffer == priv->shm_textures[priv->shm_current])
         {
-#if G_BYTE_ORDER == G_BIG_ENDIAN
-          case WL_SHM_FORMAT_ARGB8888:
-            format = COGL_PIXEL_FORMAT_ARGB_8888_PRE;
-            break;
-          case WL_SHM_FORMAT_XRGB8888:
-            format = COGL_PIXEL_FORMAT_ARGB_8888;
-            break;
-#elif G_BYTE_ORDER == G_LITTLE_ENDIAN
-          case WL_SHM_FORMAT_ARGB8888:
-            format = COGL_PIXEL_FORMAT_BGRA_8888_PRE;
-            break;
-          case WL_SHM_FORMAT_XRGB8888:
-            format = COGL_PIXEL_FORMAT_BGRA_8888;
-            break;
-#endif
-          default:
-            g_warn_if_reached ();
-            format = COGL_PIXEL_FORMAT_ARGB_8888;
-        }
+          guint other = 1 - priv->shm_current;
+
+          if (priv->shm_stale[other] != NULL)
+            {
+              cairo_rectangle_int_t rect = { x, y, width, height };
 
-      cogl_texture_set_region (COGL_TEXTURE (priv->buffer),
-                               x, y,
-                               x, y,
-                               width, height,
-                               width, height,
-                               format,
-                               wl_shm_buffer_get_stride (shm_buffer),
-                               wl_shm_buffer_get_data (shm_buffer));
+              cairo_region_union_rectangle (priv->shm_stale[other], &rect);
+            }
+        }
     }
 
   g_signal_emit (self, signals[QUEUE_DAMAGE_REDRAW],
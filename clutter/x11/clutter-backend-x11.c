@@ -61,6 +61,7 @@
 #include "clutter-debug.h"
 #include "clutter-device-manager-private.h"
 #include "clutter-event-private.h"
+#include "clutter-event-translator.h"
 #include "clutter-main.h"
 #include "clutter-private.h"
 #include "clutter-settings-private.h"
@@ -115,6 +116,7 @@ static gboolean _no_xevent_retrieval = FALSE;
 static gboolean clutter_enable_xinput = TRUE;
 static gboolean clutter_enable_argb = FALSE;
 static gboolean clutter_enable_stereo = FALSE;
+static gboolean clutter_enable_raw_motion = FALSE;
 static Display  *_foreign_dpy = NULL;
 
 /* options */
@@ -625,6 +627,7 @@ clutter_backend_x11_translate_event (ClutterBackend *backend,
 {
   ClutterBackendX11 *backend_x11 = CLUTTER_BACKEND_X11 (backend);
   ClutterBackendClass *parent_class;
+  ClutterStageX11 *stage_x11;
   XEvent *xevent = native;
 
   /* X11 filter functions have a higher priority */
@@ -660,6 +663,37 @@ clutter_backend_x11_translate_event (ClutterBackend *backend,
    */
   update_last_event_time (backend_x11, xevent);
 
+  /* the stages are not in the list of event translators; events for
+   * a stage window are routed directly to the stage that owns it, so
+   * that we don't have to ask every stage in turn
+   */
+  if (xevent->type != GenericEvent)
+    {
+      stage_x11 = (ClutterStageX11 *)
+        clutter_x11_get_stage_window_from_window (xevent->xany.window);
+
+      if (stage_x11 != NULL)
+        {
+          ClutterEventTranslator *translator;
+
+          translator = CLUTTER_EVENT_TRANSLATOR (stage_x11);
+
+          switch (_clutter_event_translator_translate_event (translator,
+                                                             native,
+                                                             event))
+            {
+            case CLUTTER_TRANSLATE_QUEUE:
+              return TRUE;
+
+            case CLUTTER_TRANSLATE_REMOVE:
+              return FALSE;
+
+            default:
+              break;
+            }
+        }
+    }
+
   /* chain up to the parent implementation, which will handle
    * event translators
    */
@@ -789,18 +823,16 @@ clutter_backend_x11_create_stage (ClutterBackend  *backend,
 				  ClutterStage    *wrapper,
 				  GError         **error)
 {
-  ClutterEventTranslator *translator;
   ClutterStageWindow *stage;
 
+  /* the X11 stage does event translation, but it is not added to the
+   * event translators of the backend: see translate_event() above
+   */
   stage = g_object_new (CLUTTER_TYPE_STAGE_X11,
 			"backend", backend,
 			"wrapper", wrapper,
 			NULL);
 
-  /* the X11 stage does event translation */
-  translator = CLUTTER_EVENT_TRANSLATOR (stage);
-  _clutter_backend_add_event_translator (backend, translator);
-
   CLUTTER_NOTE (BACKEND, "X11 stage created (display:%p, screen:%d, root:%u)",
                 CLUTTER_BACKEND_X11 (backend)->xdpy,
                 CLUTTER_BACKEND_X11 (backend)->xscreen_num,
@@ -1395,6 +1427,61 @@ clutter_x11_get_use_stereo_stage (void)
   return clutter_enable_stereo;
 }
 
+/**
+ * clutter_x11_set_use_raw_motion_events:
+ * @use_raw: %TRUE if raw motion events should be delivered
+ *
+ * Sets whether the Clutter X11 backend should select the XInput 2
+ * raw motion events, and deliver them as #ClutterMotionEvent with
+ * the %CLUTTER_EVENT_FLAG_RAW flag set.
+ *
+ * Raw motion events are delivered at the rate of the device, and
+ * their axes contain the values of the source device, as returned by
+ * clutter_event_get_source_device(), without acceleration or
+ * transformation; this is useful for drawing applications.
+ *
+ * Raw motion events are delivered to the actor that has the pointer,
+ * in addition to the regular motion events, and have the coordinates
+ * of the last regular motion event; they never cause a pick, and they
+ * are never compressed.
+ *
+ * This function can only be called before clutter_init() is called,
+ * and it has no effect if XInput 2 is not available.
+ *
+ * Since: 1.26
+ */
+void
+clutter_x11_set_use_raw_motion_events (gboolean use_raw)
+{
+  if (_clutter_context_is_initialized ())
+    {
+      g_warning ("%s() can only be used before calling clutter_init()",
+                 G_STRFUNC);
+      return;
+    }
+
+  CLUTTER_NOTE (BACKEND, "Raw motion events are %s",
+                use_raw ? "enabled" : "disabled");
+
+  clutter_enable_raw_motion = use_raw;
+}
+
+/**
+ * clutter_x11_get_use_raw_motion_events:
+ *
+ * Retrieves whether the Clutter X11 backend delivers raw motion
+ * events.
+ *
+ * Return value: %TRUE if raw motion events are delivered
+ *
+ * Since: 1.26
+ */
+gboolean
+clutter_x11_get_use_raw_motion_events (void)
+{
+  return clutter_enable_raw_motion;
+}
+
 XVisualInfo *
 _clutter_backend_x11_get_visual_info (ClutterBackendX11 *backend_x11)
 {
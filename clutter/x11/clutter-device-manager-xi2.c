@@ -218,6 +218,8 @@ translate_device_classes (Display             *xdisplay,
           break;
         }
     }
+
+  _clutter_input_device_xi2_update_valuators (device);
 }
 
 static gboolean
@@ -718,46 +720,18 @@ print_keysym (uint32_t symbol,
 
 static gdouble *
 translate_axes (ClutterInputDevice *device,
+                ClutterEvent       *event,
                 gdouble             x,
                 gdouble             y,
                 XIValuatorState    *valuators)
 {
-  guint n_axes = clutter_input_device_get_n_axes (device);
-  guint i;
-  gdouble *retval;
-  double *values;
-
-  retval = g_new0 (gdouble, n_axes);
-  values = valuators->values;
-
-  for (i = 0; i < valuators->mask_len * 8; i++)
-    {
-      ClutterInputAxis axis;
-      gdouble val;
-
-      if (!XIMaskIsSet (valuators->mask, i))
-        continue;
-
-      axis = clutter_input_device_get_axis (device, i);
-      val = *values++;
-
-      switch (axis)
-        {
-        case CLUTTER_INPUT_AXIS_X:
-          retval[i] = x;
-          break;
-
-        case CLUTTER_INPUT_AXIS_Y:
-          retval[i] = y;
-          break;
-
-        default:
-          _clutter_input_device_translate_axis (device, i, val, &retval[i]);
-          break;
-        }
-    }
+  if (device == NULL)
+    return NULL;
 
-  return retval;
+  return _clutter_input_device_xi2_translate_axes (device, event,
+                                                   x, y,
+                                                   valuators,
+                                                   valuators->values);
 }
 
 static void
@@ -897,7 +871,8 @@ clutter_device_manager_xi2_translate_event (ClutterEventTranslator *translator,
     return CLUTTER_TRANSLATE_REMOVE;
 
   if (!(xi_event->evtype == XI_HierarchyChanged ||
-        xi_event->evtype == XI_DeviceChanged))
+        xi_event->evtype == XI_DeviceChanged ||
+        xi_event->evtype == XI_RawMotion))
     {
       stage = get_event_stage (translator, xi_event);
       if (stage == NULL || CLUTTER_ACTOR_IN_DESTRUCTION (stage))
@@ -1072,6 +1047,7 @@ clutter_device_manager_xi2_translate_event (ClutterEventTranslator *translator,
             clutter_event_set_device (event, device);
 
             event->scroll.axes = translate_axes (event->scroll.device,
+                                                 event,
                                                  event->scroll.x,
                                                  event->scroll.y,
                                                  &xev->valuators);
@@ -1119,6 +1095,7 @@ clutter_device_manager_xi2_translate_event (ClutterEventTranslator *translator,
             clutter_event_set_device (event, device);
 
             event->button.axes = translate_axes (event->button.device,
+                                                 event,
                                                  event->button.x,
                                                  event->button.y,
                                                  &xev->valuators);
@@ -1227,6 +1204,7 @@ clutter_device_manager_xi2_translate_event (ClutterEventTranslator *translator,
         clutter_event_set_device (event, device);
 
         event->motion.axes = translate_axes (event->motion.device,
+                                             event,
                                              event->motion.x,
                                              event->motion.y,
                                              &xev->valuators);
@@ -1251,6 +1229,64 @@ clutter_device_manager_xi2_translate_event (ClutterEventTranslator *translator,
       }
       break;
 
+    case XI_RawMotion:
+      {
+        XIRawEvent *xev = (XIRawEvent *) xi_event;
+        ClutterPoint point = CLUTTER_POINT_INIT_ZERO;
+
+        source_device = g_hash_table_lookup (manager_xi2->devices_by_id,
+                                             GINT_TO_POINTER (xev->sourceid));
+        device = g_hash_table_lookup (manager_xi2->devices_by_id,
+                                      GINT_TO_POINTER (xev->deviceid));
+
+        /* raw events are not associated to a window, so we deliver
+         * them to the stage that currently has the pointer
+         */
+        if (device != NULL)
+          stage = clutter_input_device_get_pointer_stage (device);
+
+        if (stage == NULL || CLUTTER_ACTOR_IN_DESTRUCTION (stage))
+          {
+            retval = CLUTTER_TRANSLATE_REMOVE;
+            break;
+          }
+
+        clutter_input_device_get_coords (device, NULL, &point);
+
+        event->motion.type = event->type = CLUTTER_MOTION;
+        event->motion.flags |= CLUTTER_EVENT_FLAG_RAW;
+
+        event->motion.stage = stage;
+        event->motion.time = xev->time;
+        event->motion.x = point.x;
+        event->motion.y = point.y;
+        event->motion.modifier_state =
+          clutter_input_device_get_modifier_state (device);
+
+        clutter_event_set_source_device (event, source_device);
+        clutter_event_set_device (event, device);
+
+        /* the raw values are not accelerated nor transformed; they
+         * are the valuators of the slave device, as the master device
+         * only has the X and Y axes
+         */
+        if (source_device != NULL)
+          event->motion.axes =
+            _clutter_input_device_xi2_translate_axes (source_device, event,
+                                                      point.x, point.y,
+                                                      &xev->valuators,
+                                                      xev->raw_values);
+
+        CLUTTER_NOTE (EVENT, "raw motion: device:%d '%s' (x:%.2f, y:%.2f)",
+                      device->id,
+                      device->device_name,
+                      event->motion.x,
+                      event->motion.y);
+
+        retval = CLUTTER_TRANSLATE_QUEUE;
+      }
+      break;
+
 #ifdef HAVE_XINPUT_2_2
     case XI_TouchBegin:
       {
@@ -1288,6 +1324,7 @@ clutter_device_manager_xi2_translate_event (ClutterEventTranslator *translator,
         clutter_event_set_device (event, device);
 
         event->touch.axes = translate_axes (event->touch.device,
+                                            event,
                                             event->motion.x,
                                             event->motion.y,
                                             &xev->valuators);
@@ -1338,6 +1375,7 @@ clutter_device_manager_xi2_translate_event (ClutterEventTranslator *translator,
         clutter_event_set_device (event, device);
 
         event->touch.axes = translate_axes (event->touch.device,
+                                            event,
                                             event->motion.x,
                                             event->motion.y,
                                             &xev->valuators);
@@ -1612,6 +1650,25 @@ clutter_device_manager_xi2_constructed (GObject *gobject)
                                             clutter_x11_get_root_window (),
                                             &event_mask);
 
+  /* raw events can only be selected on the root window; we select
+   * them for the master devices, so that each physical event is
+   * delivered only once
+   */
+  if (clutter_x11_get_use_raw_motion_events ())
+    {
+      unsigned char raw_mask[XIMaskLen (XI_RawMotion)] = { 0, };
+
+      XISetMask (raw_mask, XI_RawMotion);
+
+      event_mask.deviceid = XIAllMasterDevices;
+      event_mask.mask_len = sizeof (raw_mask);
+      event_mask.mask = raw_mask;
+
+      clutter_device_manager_xi2_select_events (manager,
+                                                clutter_x11_get_root_window (),
+                                                &event_mask);
+    }
+
   XSync (backend_x11->xdpy, False);
 
   if (G_OBJECT_CLASS (clutter_device_manager_xi2_parent_class)->constructed)
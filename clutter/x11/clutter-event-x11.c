@@ -277,28 +277,48 @@ events_queue (ClutterBackendX11 *backend_x11)
 {
   ClutterBackend *backend = CLUTTER_BACKEND (backend_x11);
   Display *xdisplay = backend_x11->xdpy;
-  ClutterEvent *event;
+  ClutterEvent *event = NULL;
   XEvent xevent;
+  int n_events;
+
+  /* drain all the events that can be read from the connection without
+   * blocking, instead of going back to the main loop for each one of
+   * them; the events that arrive in the meantime will wake up the
+   * event source again
+   */
+  n_events = XEventsQueued (xdisplay, QueuedAfterReading);
 
-  while (!clutter_events_pending () && XPending (xdisplay))
+  while (n_events-- > 0)
     {
       XNextEvent (xdisplay, &xevent);
 
-      event = clutter_event_new (CLUTTER_NOTHING);
+      /* most X events get dropped, so we allocate a new ClutterEvent
+       * only after the previous one has been queued; the translators
+       * may have filled some of the fields of a dropped event, e.g.
+       * the stage, so it has to be reset before being used again
+       */
+      if (event == NULL)
+        event = clutter_event_new (CLUTTER_NOTHING);
 
 #ifdef HAVE_XGE
       XGetEventData (xdisplay, &xevent.xcookie);
 #endif
 
       if (_clutter_backend_translate_event (backend, &xevent, event))
-        _clutter_event_push (event, FALSE);
+        {
+          _clutter_event_push (event, FALSE);
+          event = NULL;
+        }
       else
-        clutter_event_free (event);
+        _clutter_event_reset (event);
 
 #ifdef HAVE_XGE
       XFreeEventData (xdisplay, &xevent.xcookie);
 #endif
     }
+
+  if (event != NULL)
+    clutter_event_free (event);
 }
 
 static gboolean
@@ -316,9 +336,11 @@ clutter_event_dispatch (GSource     *source,
   */
   events_queue (backend);
 
-  /* Pop an event off the queue if any */
-  event = clutter_event_get ();
-  if (event != NULL)
+  /* Move all the pending events to the queue of their stage; the
+   * stages will process them, and compress the motion events, at
+   * the next frame
+   */
+  while ((event = clutter_event_get ()) != NULL)
     {
       /* forward the event into clutter for emission etc. */
       _clutter_stage_queue_event (event->any.stage, event, FALSE);
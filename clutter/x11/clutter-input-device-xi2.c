@@ -36,14 +36,33 @@
 
 #include <X11/extensions/XInput2.h>
 
+#include <math.h>
+
 typedef struct _ClutterInputDeviceClass         ClutterInputDeviceXI2Class;
 
 /* a specific XI2 input device */
+/* the mapping of a valuator to an axis, with the linear transformation
+ * from the range of the valuator to the range of the axis
+ */
+typedef struct _ClutterValuatorXI2
+{
+  ClutterInputAxis axis;
+
+  gdouble scale;
+  gdouble offset;
+} ClutterValuatorXI2;
+
 struct _ClutterInputDeviceXI2
 {
   ClutterInputDevice device;
 
   gint device_id;
+
+  /* computed each time the classes of the device change, instead of
+   * for each event
+   */
+  ClutterValuatorXI2 *valuators;
+  guint n_valuators;
 };
 
 #define N_BUTTONS       5
@@ -65,6 +84,16 @@ clutter_input_device_xi2_constructed (GObject *gobject)
     G_OBJECT_CLASS (clutter_input_device_xi2_parent_class)->constructed (gobject);
 }
 
+static void
+clutter_input_device_xi2_finalize (GObject *gobject)
+{
+  ClutterInputDeviceXI2 *device_xi2 = CLUTTER_INPUT_DEVICE_XI2 (gobject);
+
+  g_free (device_xi2->valuators);
+
+  G_OBJECT_CLASS (clutter_input_device_xi2_parent_class)->finalize (gobject);
+}
+
 static gboolean
 clutter_input_device_xi2_keycode_to_evdev (ClutterInputDevice *device,
                                            guint hardware_keycode,
@@ -86,6 +115,7 @@ clutter_input_device_xi2_class_init (ClutterInputDeviceXI2Class *klass)
   ClutterInputDeviceClass *device_class = CLUTTER_INPUT_DEVICE_CLASS (klass);
 
   gobject_class->constructed = clutter_input_device_xi2_constructed;
+  gobject_class->finalize = clutter_input_device_xi2_finalize;
 
   device_class->keycode_to_evdev = clutter_input_device_xi2_keycode_to_evdev;
 }
@@ -172,3 +202,113 @@ _clutter_input_device_xi2_translate_state (ClutterEvent    *event,
 
   _clutter_event_set_state_full (event, button, base, latched, locked, effective);
 }
+
+/*
+ * _clutter_input_device_xi2_update_valuators:
+ * @device: a #ClutterInputDeviceXI2
+ *
+ * Updates the mapping of the valuators of @device to its axes; this
+ * must be called every time the axes of @device change.
+ */
+void
+_clutter_input_device_xi2_update_valuators (ClutterInputDevice *device)
+{
+  ClutterInputDeviceXI2 *device_xi2 = CLUTTER_INPUT_DEVICE_XI2 (device);
+  guint i, n_axes;
+
+  n_axes = device->axes != NULL ? device->axes->len : 0;
+
+  g_free (device_xi2->valuators);
+  device_xi2->valuators = g_new0 (ClutterValuatorXI2, n_axes);
+  device_xi2->n_valuators = n_axes;
+
+  for (i = 0; i < n_axes; i++)
+    {
+      ClutterAxisInfo *info = &g_array_index (device->axes, ClutterAxisInfo, i);
+      ClutterValuatorXI2 *valuator = &device_xi2->valuators[i];
+      gdouble width = info->max_value - info->min_value;
+
+      valuator->axis = info->axis;
+
+      /* an axis with an empty range is left at 0, like
+       * _clutter_input_device_translate_axis() does
+       */
+      if (fabs (width) < 0.0000001)
+        continue;
+
+      valuator->scale = (info->max_axis - info->min_axis) / width;
+      valuator->offset = (info->min_axis * info->max_value
+                       - info->max_axis * info->min_value) / width;
+    }
+}
+
+/*
+ * _clutter_input_device_xi2_translate_axes:
+ * @device: a #ClutterInputDeviceXI2
+ * @event: the #ClutterEvent that will own the axes
+ * @x: the X coordinate of the event
+ * @y: the Y coordinate of the event
+ * @valuators: the valuators of the XI2 event
+ * @values: the values of the valuators; either the values of
+ *   @valuators, or the raw values of a raw event
+ *
+ * Translates the valuators of an XI2 event into the axes of @event,
+ * using the mapping computed by _clutter_input_device_xi2_update_valuators().
+ *
+ * If @event has the %CLUTTER_EVENT_FLAG_RAW flag set, the X and Y axes
+ * are set to the values in @values, instead of @x and @y.
+ *
+ * Return value: the axes, owned by @event, or %NULL
+ */
+gdouble *
+_clutter_input_device_xi2_translate_axes (ClutterInputDevice *device,
+                                          ClutterEvent       *event,
+                                          gdouble             x,
+                                          gdouble             y,
+                                          XIValuatorState    *valuators,
+                                          const double       *values)
+{
+  ClutterInputDeviceXI2 *device_xi2 = CLUTTER_INPUT_DEVICE_XI2 (device);
+  gboolean raw;
+  gdouble *retval;
+  guint i, n_valuators;
+
+  /* raw events keep the unaccelerated X and Y values of the device,
+   * instead of the coordinates of the pointer on the stage
+   */
+  raw = (clutter_event_get_flags (event) & CLUTTER_EVENT_FLAG_RAW) != 0;
+
+  retval = _clutter_event_get_axes_storage (event, device_xi2->n_valuators);
+  if (retval == NULL)
+    return NULL;
+
+  n_valuators = MIN (valuators->mask_len * 8, device_xi2->n_valuators);
+
+  for (i = 0; i < n_valuators; i++)
+    {
+      const ClutterValuatorXI2 *valuator = &device_xi2->valuators[i];
+      gdouble val;
+
+      if (!XIMaskIsSet (valuators->mask, i))
+        continue;
+
+      val = *values++;
+
+      switch (valuator->axis)
+        {
+        case CLUTTER_INPUT_AXIS_X:
+          retval[i] = raw ? val : x;
+          break;
+
+        case CLUTTER_INPUT_AXIS_Y:
+          retval[i] = raw ? val : y;
+          break;
+
+        default:
+          retval[i] = val * valuator->scale + valuator->offset;
+          break;
+        }
+    }
+
+  return retval;
+}
@@ -42,6 +42,14 @@ void  _clutter_input_device_xi2_translate_state (ClutterEvent    *event,
 						 XIButtonState   *buttons_state,
 						 XIGroupState    *group_state);
 
+void      _clutter_input_device_xi2_update_valuators (ClutterInputDevice *device);
+gdouble * _clutter_input_device_xi2_translate_axes   (ClutterInputDevice *device,
+                                                      ClutterEvent       *event,
+                                                      gdouble             x,
+                                                      gdouble             y,
+                                                      XIValuatorState    *valuators,
+                                                      const double       *values);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_INPUT_DEVICE_XI2_H__ */
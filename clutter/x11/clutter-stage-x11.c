@@ -53,8 +53,6 @@ static ClutterStageWindowIface *clutter_stage_window_parent_iface = NULL;
 static void clutter_stage_window_iface_init     (ClutterStageWindowIface     *iface);
 static void clutter_event_translator_iface_init (ClutterEventTranslatorIface *iface);
 
-static ClutterStageCogl *clutter_x11_get_stage_window_from_window (Window win);
-
 static GHashTable *clutter_stages_by_xid = NULL;
 
 #define clutter_stage_x11_get_type      _clutter_stage_x11_get_type
@@ -880,24 +878,12 @@ clutter_stage_x11_finalize (GObject *gobject)
   G_OBJECT_CLASS (clutter_stage_x11_parent_class)->finalize (gobject);
 }
 
-static void
-clutter_stage_x11_dispose (GObject *gobject)
-{
-  ClutterEventTranslator *translator = CLUTTER_EVENT_TRANSLATOR (gobject);
-  ClutterBackend *backend = CLUTTER_STAGE_COGL (gobject)->backend;
-
-  _clutter_backend_remove_event_translator (backend, translator);
-
-  G_OBJECT_CLASS (clutter_stage_x11_parent_class)->dispose (gobject);
-}
-
 static void
 clutter_stage_x11_class_init (ClutterStageX11Class *klass)
 {
   GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
 
   gobject_class->finalize = clutter_stage_x11_finalize;
-  gobject_class->dispose = clutter_stage_x11_dispose;
 }
 
 static void
@@ -1292,7 +1278,7 @@ clutter_x11_get_stage_window (ClutterStage *stage)
   return CLUTTER_STAGE_X11 (impl)->xwin;
 }
 
-static ClutterStageCogl *
+ClutterStageCogl *
 clutter_x11_get_stage_window_from_window (Window win)
 {
   if (clutter_stages_by_xid == NULL)
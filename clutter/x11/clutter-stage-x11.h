@@ -97,6 +97,7 @@ void  _clutter_stage_x11_update_foreign_event_mask (CoglOnscreen *onscreen,
 void  _clutter_stage_x11_events_device_changed (ClutterStageX11 *stage_x11,
                                                 ClutterInputDevice *device,
                                                 ClutterDeviceManager *device_manager);
+ClutterStageCogl *clutter_x11_get_stage_window_from_window (Window win);
 
 /* Private to subclasses */
 void            _clutter_stage_x11_set_user_time                (ClutterStageX11 *stage_x11,
@@ -152,6 +152,11 @@ void     clutter_x11_set_use_stereo_stage (gboolean use_stereo);
 CLUTTER_AVAILABLE_IN_1_22
 gboolean clutter_x11_get_use_stereo_stage (void);
 
+CLUTTER_AVAILABLE_IN_1_26
+void     clutter_x11_set_use_raw_motion_events (gboolean use_raw);
+CLUTTER_AVAILABLE_IN_1_26
+gboolean clutter_x11_get_use_raw_motion_events (void);
+
 CLUTTER_AVAILABLE_IN_ALL
 Time clutter_x11_get_current_event_time (void);
 
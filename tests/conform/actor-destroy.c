@@ -190,6 +190,88 @@ actor_destruction (void)
   g_assert_null (test);
 }
 
+static void
+on_destroy_count (ClutterActor *actor,
+                  gpointer      data)
+{
+  guint *n_destroyed = data;
+
+  *n_destroyed += 1;
+}
+
+static void
+on_destroy_n_children (ClutterActor *actor,
+                       gpointer      data)
+{
+  gint *n_children = data;
+
+  *n_children = clutter_actor_get_n_children (actor);
+}
+
+static void
+actor_destruction_deferred (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *root = clutter_actor_new ();
+  ClutterActor *test = g_object_new (TEST_TYPE_DESTROY, NULL);
+  guint n_destroyed = 0, n_actors = 0;
+  gint n_root_children = -1;
+  int i, j;
+
+  g_object_add_weak_pointer (G_OBJECT (root), (gpointer *) &root);
+  g_object_add_weak_pointer (G_OBJECT (test), (gpointer *) &test);
+
+  for (i = 0; i < 10; i++)
+    {
+      ClutterActor *group = clutter_actor_new ();
+
+      for (j = 0; j < 100; j++)
+        {
+          ClutterActor *child = clutter_actor_new ();
+
+          g_signal_connect (child, "destroy",
+                            G_CALLBACK (on_destroy_count),
+                            &n_destroyed);
+          clutter_actor_add_child (group, child);
+          n_actors += 1;
+        }
+
+      clutter_actor_add_child (root, group);
+    }
+
+  clutter_container_add_actor (CLUTTER_CONTAINER (test), clutter_rectangle_new ());
+  clutter_actor_add_child (root, test);
+
+  clutter_actor_add_child (stage, root);
+  clutter_actor_show (stage);
+  g_assert (CLUTTER_ACTOR_IS_MAPPED (root));
+
+  g_signal_connect (root, "destroy",
+                    G_CALLBACK (on_destroy_n_children),
+                    &n_root_children);
+
+  clutter_actor_destroy_deferred (root);
+
+  /* the actor is detached immediately, and destroyed later */
+  g_assert (root != NULL);
+  g_assert (clutter_actor_get_parent (root) == NULL);
+  g_assert (!CLUTTER_ACTOR_IS_MAPPED (root));
+  g_assert_cmpint (clutter_actor_get_n_children (stage), ==, 0);
+  g_assert_cmpint (n_destroyed, ==, 0);
+
+  /* calling it twice is harmless */
+  clutter_actor_destroy_deferred (root);
+
+  while (root != NULL || test != NULL || n_destroyed < n_actors)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpint (n_destroyed, ==, n_actors);
+
+  /* the children are still attached when their parent is destroyed */
+  g_assert_cmpint (n_root_children, ==, 11);
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/actor/destruction", actor_destruction)
+  CLUTTER_TEST_UNIT ("/actor/destruction/deferred", actor_destruction_deferred)
 )
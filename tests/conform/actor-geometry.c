@@ -0,0 +1,124 @@
+#include <math.h>
+#include <clutter/clutter.h>
+
+static void
+check_transformed_position (ClutterActor *actor,
+                            gfloat        x,
+                            gfloat        y)
+{
+  ClutterActorBox box;
+  gfloat real_x, real_y;
+
+  /* make sure the layout is up to date */
+  clutter_actor_get_allocation_box (actor, &box);
+
+  clutter_actor_get_transformed_position (actor, &real_x, &real_y);
+
+  if (g_test_verbose ())
+    g_print ("actor '%s': expected (%.2f, %.2f), got (%.2f, %.2f)\n",
+             clutter_actor_get_name (actor),
+             x, y,
+             real_x, real_y);
+
+  g_assert_cmpfloat (fabsf (real_x - x), <, 0.5f);
+  g_assert_cmpfloat (fabsf (real_y - y), <, 0.5f);
+}
+
+static void
+actor_geometry_transform (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *parent, *other, *child;
+
+  parent = clutter_actor_new ();
+  clutter_actor_set_name (parent, "parent");
+  clutter_actor_set_position (parent, 100, 100);
+  clutter_actor_set_size (parent, 200, 200);
+  clutter_actor_add_child (stage, parent);
+
+  other = clutter_actor_new ();
+  clutter_actor_set_name (other, "other");
+  clutter_actor_set_position (other, 300, 50);
+  clutter_actor_set_size (other, 100, 100);
+  clutter_actor_add_child (stage, other);
+
+  child = clutter_actor_new ();
+  clutter_actor_set_name (child, "child");
+  clutter_actor_set_position (child, 10, 20);
+  clutter_actor_set_size (child, 50, 50);
+  clutter_actor_add_child (parent, child);
+
+  clutter_actor_show (stage);
+
+  check_transformed_position (child, 110, 120);
+
+  /* changing the transformation of an ancestor does not need a
+   * relayout, but it still changes the position of the child
+   */
+  clutter_actor_set_translation (parent, 50, 0, 0);
+  check_transformed_position (child, 160, 120);
+
+  /* the position is read again, without changes in between */
+  check_transformed_position (child, 160, 120);
+
+  clutter_actor_set_translation (parent, 0, 0, 0);
+  clutter_actor_set_position (parent, 0, 0);
+  check_transformed_position (child, 10, 20);
+
+  /* moving the child to another parent */
+  g_object_ref (child);
+  clutter_actor_remove_child (parent, child);
+  clutter_actor_add_child (other, child);
+  g_object_unref (child);
+  check_transformed_position (child, 310, 70);
+
+  clutter_actor_destroy (parent);
+  clutter_actor_destroy (other);
+}
+
+static void
+actor_geometry_paint_box (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *actor;
+  ClutterActorBox box;
+
+  actor = clutter_actor_new ();
+  clutter_actor_set_background_color (actor, CLUTTER_COLOR_Red);
+  clutter_actor_set_position (actor, 50, 50);
+  clutter_actor_set_size (actor, 100, 100);
+  clutter_actor_add_child (stage, actor);
+
+  clutter_actor_show (stage);
+
+  /* the paint box is only available after the allocation, which
+   * clutter_actor_get_allocation_box() forces
+   */
+  clutter_actor_get_allocation_box (actor, &box);
+  g_assert (clutter_actor_get_paint_box (actor, &box));
+  g_assert_cmpfloat (fabsf (box.x1 - 50), <, 1.f);
+  g_assert_cmpfloat (fabsf (box.y1 - 50), <, 1.f);
+  g_assert_cmpfloat (fabsf (box.x2 - 150), <, 1.f);
+  g_assert_cmpfloat (fabsf (box.y2 - 150), <, 1.f);
+
+  /* the paint box follows the changes of the actor */
+  clutter_actor_set_translation (actor, 20, 30, 0);
+  g_assert (clutter_actor_get_paint_box (actor, &box));
+  g_assert_cmpfloat (fabsf (box.x1 - 70), <, 1.f);
+  g_assert_cmpfloat (fabsf (box.y1 - 80), <, 1.f);
+
+  clutter_actor_set_size (actor, 200, 200);
+  g_assert (!clutter_actor_get_paint_box (actor, &box));
+
+  clutter_actor_get_allocation_box (actor, &box);
+  g_assert (clutter_actor_get_paint_box (actor, &box));
+  g_assert_cmpfloat (fabsf (box.x2 - 270), <, 1.f);
+  g_assert_cmpfloat (fabsf (box.y2 - 280), <, 1.f);
+
+  clutter_actor_destroy (actor);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/actor/geometry/transform", actor_geometry_transform)
+  CLUTTER_TEST_UNIT ("/actor/geometry/paint-box", actor_geometry_paint_box)
+)
@@ -0,0 +1,284 @@
+#include <gio/gio.h>
+#include <clutter/clutter.h>
+
+typedef struct {
+  GObject parent_instance;
+
+  char *label;
+  gboolean active;
+} TestItem;
+
+typedef struct {
+  GObjectClass parent_class;
+} TestItemClass;
+
+enum {
+  PROP_0,
+  PROP_LABEL,
+  PROP_ACTIVE
+};
+
+GType test_item_get_type (void);
+
+G_DEFINE_TYPE (TestItem, test_item, G_TYPE_OBJECT)
+
+static void
+test_item_finalize (GObject *gobject)
+{
+  TestItem *self = (TestItem *) gobject;
+
+  g_free (self->label);
+
+  G_OBJECT_CLASS (test_item_parent_class)->finalize (gobject);
+}
+
+static void
+test_item_set_property (GObject      *gobject,
+                        guint         prop_id,
+                        const GValue *value,
+                        GParamSpec   *pspec)
+{
+  TestItem *self = (TestItem *) gobject;
+
+  switch (prop_id)
+    {
+    case PROP_LABEL:
+      g_free (self->label);
+      self->label = g_value_dup_string (value);
+      break;
+
+    case PROP_ACTIVE:
+      self->active = g_value_get_boolean (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
+    }
+}
+
+static void
+test_item_get_property (GObject    *gobject,
+                        guint       prop_id,
+                        GValue     *value,
+                        GParamSpec *pspec)
+{
+  TestItem *self = (TestItem *) gobject;
+
+  switch (prop_id)
+    {
+    case PROP_LABEL:
+      g_value_set_string (value, self->label);
+      break;
+
+    case PROP_ACTIVE:
+      g_value_set_boolean (value, self->active);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
+    }
+}
+
+static void
+test_item_class_init (TestItemClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->finalize = test_item_finalize;
+  gobject_class->set_property = test_item_set_property;
+  gobject_class->get_property = test_item_get_property;
+
+  g_object_class_install_property (gobject_class, PROP_LABEL,
+                                   g_param_spec_string ("label", "Label", "Label",
+                                                        NULL,
+                                                        G_PARAM_READWRITE));
+  g_object_class_install_property (gobject_class, PROP_ACTIVE,
+                                   g_param_spec_boolean ("active", "Active", "Active",
+                                                         FALSE,
+                                                         G_PARAM_READWRITE));
+}
+
+static void
+test_item_init (TestItem *self)
+{
+}
+
+static TestItem *
+test_item_new (int index_)
+{
+  char *label = g_strdup_printf ("item%d", index_);
+  TestItem *res;
+
+  res = g_object_new (test_item_get_type (), "label", label, NULL);
+  g_free (label);
+
+  return res;
+}
+
+static void
+append_items (GListStore *store,
+              int         n_items)
+{
+  int first = g_list_model_get_n_items (G_LIST_MODEL (store));
+  int i;
+
+  for (i = 0; i < n_items; i++)
+    {
+      TestItem *item = test_item_new (first + i);
+
+      g_list_store_append (store, item);
+      g_object_unref (item);
+    }
+}
+
+static void
+check_children (ClutterActor *actor,
+                GListModel   *model)
+{
+  ClutterActorIter iter;
+  ClutterActor *child;
+  guint i = 0;
+
+  clutter_actor_iter_init (&iter, actor);
+  while (clutter_actor_iter_next (&iter, &child))
+    {
+      TestItem *item = g_list_model_get_item (model, i);
+
+      g_assert_cmpstr (clutter_text_get_text (CLUTTER_TEXT (child)), ==, item->label);
+
+      g_object_unref (item);
+      i += 1;
+    }
+}
+
+static void
+actor_model_bind_properties (void)
+{
+  GListStore *store = g_list_store_new (test_item_get_type ());
+  ClutterActor *actor;
+  ClutterActor *child;
+  TestItem *item;
+
+  append_items (store, 5);
+
+  actor = clutter_actor_new ();
+  g_object_ref_sink (actor);
+
+  clutter_actor_bind_model_with_properties (actor, G_LIST_MODEL (store),
+                                            CLUTTER_TYPE_TEXT,
+                                            "label", "text", G_BINDING_SYNC_CREATE,
+                                            "active", "editable", G_BINDING_SYNC_CREATE | G_BINDING_BIDIRECTIONAL,
+                                            NULL);
+
+  /* small models are created before binding returns */
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 5);
+  check_children (actor, G_LIST_MODEL (store));
+
+  /* model -> child */
+  item = g_list_model_get_item (G_LIST_MODEL (store), 2);
+  child = clutter_actor_get_child_at_index (actor, 2);
+  g_object_set (item, "label", "changed", NULL);
+  g_assert_cmpstr (clutter_text_get_text (CLUTTER_TEXT (child)), ==, "changed");
+
+  g_object_set (item, "active", TRUE, NULL);
+  g_assert (clutter_text_get_editable (CLUTTER_TEXT (child)));
+
+  /* child -> model, only for bidirectional properties */
+  clutter_text_set_editable (CLUTTER_TEXT (child), FALSE);
+  g_assert (!item->active);
+
+  clutter_text_set_text (CLUTTER_TEXT (child), "unchanged");
+  g_assert_cmpstr (item->label, ==, "changed");
+
+  g_object_unref (item);
+
+  /* removing and inserting in the middle of the model */
+  g_list_store_remove (store, 1);
+  item = test_item_new (100);
+  g_list_store_insert (store, 3, item);
+  g_object_unref (item);
+
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 5);
+  item = g_list_model_get_item (G_LIST_MODEL (store), 3);
+  child = clutter_actor_get_child_at_index (actor, 3);
+  g_assert_cmpstr (clutter_text_get_text (CLUTTER_TEXT (child)), ==, "item100");
+  g_object_unref (item);
+
+  clutter_actor_destroy (actor);
+  g_object_unref (actor);
+  g_object_unref (store);
+}
+
+static void
+actor_model_incremental (void)
+{
+  GListStore *store = g_list_store_new (test_item_get_type ());
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *actor, *first_child, *third_child;
+  TestItem *item;
+  guint n_items, n_children;
+
+  append_items (store, 20000);
+
+  actor = clutter_actor_new ();
+  clutter_actor_add_child (stage, actor);
+  clutter_actor_show (stage);
+
+  clutter_actor_bind_model_with_properties (actor, G_LIST_MODEL (store),
+                                            CLUTTER_TYPE_TEXT,
+                                            "label", "text", G_BINDING_SYNC_CREATE,
+                                            NULL);
+
+  /* only the first batch of children is created when binding */
+  g_assert_cmpint (clutter_actor_get_n_children (actor), >, 0);
+  g_assert_cmpint (clutter_actor_get_n_children (actor), <, 20000);
+
+  /* items changed past the children created so far are picked up
+   * by the following batches
+   */
+  append_items (store, 10);
+  g_list_store_remove (store, 19000);
+
+  /* items changed before the last child created so far only replace
+   * the children of the changed items, and keep all the other ones
+   */
+  while (clutter_actor_get_n_children (actor) < 3)
+    g_main_context_iteration (NULL, TRUE);
+
+  n_children = clutter_actor_get_n_children (actor);
+  first_child = clutter_actor_get_child_at_index (actor, 0);
+  third_child = clutter_actor_get_child_at_index (actor, 2);
+
+  item = test_item_new (-1);
+  g_list_store_insert (store, 0, item);
+  g_object_unref (item);
+
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, n_children + 1);
+  g_assert_cmpstr (clutter_text_get_text (CLUTTER_TEXT (clutter_actor_get_first_child (actor))),
+                   ==, "item-1");
+  g_assert (clutter_actor_get_child_at_index (actor, 1) == first_child);
+
+  g_list_store_remove (store, 2);
+
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, n_children);
+  g_assert (clutter_actor_get_child_at_index (actor, 1) == first_child);
+  g_assert (clutter_actor_get_child_at_index (actor, 2) == third_child);
+
+  g_assert_cmpint (clutter_actor_get_n_children (actor), <,
+                   g_list_model_get_n_items (G_LIST_MODEL (store)));
+
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (store));
+  while (clutter_actor_get_n_children (actor) < n_items)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, n_items);
+  check_children (actor, G_LIST_MODEL (store));
+
+  clutter_actor_destroy (actor);
+  g_object_unref (store);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/actor/model/bind-properties", actor_model_bind_properties)
+  CLUTTER_TEST_UNIT ("/actor/model/incremental", actor_model_incremental)
+)
@@ -0,0 +1,100 @@
+#include <clutter/clutter.h>
+
+static void
+on_notify (GObject    *gobject,
+           GParamSpec *pspec,
+           gpointer    user_data)
+{
+  int *counter = user_data;
+
+  *counter += 1;
+}
+
+static void
+actor_notify_listeners (void)
+{
+  ClutterActor *actor = clutter_actor_new ();
+  int n_x = 0, n_any = 0;
+  gulong id;
+
+  g_object_ref_sink (actor);
+
+  /* nothing is listening, so nothing should be emitted */
+  clutter_actor_set_x (actor, 10.f);
+  clutter_actor_set_opacity (actor, 128);
+
+  g_signal_connect (actor, "notify::x", G_CALLBACK (on_notify), &n_x);
+  clutter_actor_set_x (actor, 20.f);
+  clutter_actor_set_y (actor, 20.f);
+  g_assert_cmpint (n_x, ==, 1);
+
+  id = g_signal_connect (actor, "notify", G_CALLBACK (on_notify), &n_any);
+  clutter_actor_set_opacity (actor, 255);
+  g_assert_cmpint (n_any, ==, 1);
+
+  /* frozen notifications are still emitted on thaw, and coalesced */
+  g_object_freeze_notify (G_OBJECT (actor));
+  clutter_actor_set_x (actor, 30.f);
+  clutter_actor_set_x (actor, 40.f);
+  g_assert_cmpint (n_x, ==, 1);
+  g_object_thaw_notify (G_OBJECT (actor));
+  g_assert_cmpint (n_x, ==, 2);
+
+  /* blocked handlers are not invoked */
+  n_any = 0;
+  g_signal_handler_block (actor, id);
+  clutter_actor_set_opacity (actor, 64);
+  g_assert_cmpint (n_any, ==, 0);
+  g_signal_handler_unblock (actor, id);
+
+  clutter_actor_destroy (actor);
+  g_object_unref (actor);
+}
+
+static void
+on_transition_stopped (ClutterActor *actor,
+                       const char   *name,
+                       gboolean      is_finished,
+                       gpointer      user_data)
+{
+  gboolean *done = user_data;
+
+  *done = TRUE;
+}
+
+static void
+actor_notify_animation (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *actor = clutter_actor_new ();
+  gboolean done = FALSE;
+  int n_x = 0;
+
+  clutter_actor_set_size (actor, 50, 50);
+  clutter_actor_add_child (stage, actor);
+  clutter_actor_show (stage);
+
+  g_signal_connect (actor, "notify::x", G_CALLBACK (on_notify), &n_x);
+  g_signal_connect (actor, "transition-stopped::x",
+                    G_CALLBACK (on_transition_stopped),
+                    &done);
+
+  clutter_actor_save_easing_state (actor);
+  clutter_actor_set_easing_duration (actor, 100);
+  clutter_actor_set_x (actor, 100.f);
+  clutter_actor_restore_easing_state (actor);
+
+  while (!done)
+    g_main_context_iteration (NULL, TRUE);
+
+  /* the notifications emitted while animating are delivered */
+  g_assert_cmpint (n_x, >, 0);
+  g_assert_cmpfloat (clutter_actor_get_x (actor), ==, 100.f);
+
+  clutter_actor_destroy (actor);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/actor/notify/listeners", actor_notify_listeners)
+  CLUTTER_TEST_UNIT ("/actor/notify/animation", actor_notify_animation)
+)
@@ -292,6 +292,82 @@ binding_pool (void)
   clutter_actor_destroy (CLUTTER_ACTOR (key_group));
 }
 
+static gboolean
+count_action (GObject             *gobject,
+              const gchar         *action_name,
+              guint                key_val,
+              ClutterModifierType  modifiers,
+              gpointer             user_data)
+{
+  gint *count = user_data;
+
+  g_assert_cmpstr (action_name, ==, "count");
+  g_assert_cmpuint (modifiers, ==, CLUTTER_CONTROL_MASK);
+
+  *count += 1;
+
+  return TRUE;
+}
+
+static void
+binding_pool_remove (void)
+{
+  ClutterBindingPool *pool;
+  GObject *gobject;
+  gint count = 0;
+  guint i;
+
+  pool = clutter_binding_pool_new ("test-remove");
+  gobject = g_object_new (G_TYPE_OBJECT, NULL);
+
+  for (i = 0; i < 64; i++)
+    {
+      clutter_binding_pool_install_action (pool, "count",
+                                           0x1000 + i, CLUTTER_CONTROL_MASK,
+                                           G_CALLBACK (count_action),
+                                           &count, NULL);
+      clutter_binding_pool_install_action (pool, "other",
+                                           0x1000 + i, 0,
+                                           G_CALLBACK (count_action),
+                                           &count, NULL);
+    }
+
+  g_assert_cmpstr (clutter_binding_pool_find_action (pool, 0x1000 + 42, 0), ==, "other");
+
+  /* modifiers that are not part of a binding are ignored */
+  g_assert (clutter_binding_pool_activate (pool, 0x1000 + 42,
+                                           CLUTTER_CONTROL_MASK | CLUTTER_BUTTON1_MASK,
+                                           gobject));
+  g_assert_cmpint (count, ==, 1);
+
+  clutter_binding_pool_remove_action (pool, 0x1000 + 42, CLUTTER_CONTROL_MASK);
+  g_assert_null (clutter_binding_pool_find_action (pool, 0x1000 + 42, CLUTTER_CONTROL_MASK));
+  g_assert (!clutter_binding_pool_activate (pool, 0x1000 + 42,
+                                            CLUTTER_CONTROL_MASK,
+                                            gobject));
+  g_assert_cmpint (count, ==, 1);
+
+  /* the other bindings are still there */
+  g_assert_cmpstr (clutter_binding_pool_find_action (pool, 0x1000 + 42, 0), ==, "other");
+  g_assert (clutter_binding_pool_activate (pool, 0x1000 + 43,
+                                           CLUTTER_CONTROL_MASK,
+                                           gobject));
+  g_assert_cmpint (count, ==, 2);
+
+  clutter_binding_pool_install_action (pool, "count",
+                                       0x1000 + 42, CLUTTER_CONTROL_MASK,
+                                       G_CALLBACK (count_action),
+                                       &count, NULL);
+  g_assert (clutter_binding_pool_activate (pool, 0x1000 + 42,
+                                           CLUTTER_CONTROL_MASK,
+                                           gobject));
+  g_assert_cmpint (count, ==, 3);
+
+  g_object_unref (gobject);
+  g_object_unref (pool);
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/binding-pool", binding_pool)
+  CLUTTER_TEST_UNIT ("/binding-pool/remove", binding_pool_remove)
 )
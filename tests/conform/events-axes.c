@@ -0,0 +1,125 @@
+#include <clutter/clutter.h>
+
+static ClutterEvent *
+create_motion_event (ClutterInputDevice *device,
+                     ClutterInputDevice *source_device,
+                     guint               n_axes)
+{
+  ClutterEvent *event;
+  guint i;
+
+  event = clutter_event_new (CLUTTER_MOTION);
+  clutter_event_set_device (event, device);
+
+  if (source_device != NULL)
+    {
+      clutter_event_set_source_device (event, source_device);
+      clutter_event_set_flags (event, CLUTTER_EVENT_FLAG_RAW);
+    }
+
+  /* the event takes ownership of the axes */
+  event->motion.axes = g_new (gdouble, n_axes);
+  for (i = 0; i < n_axes; i++)
+    event->motion.axes[i] = i + 0.5;
+
+  return event;
+}
+
+static void
+check_axes (const ClutterEvent *event,
+            guint               expected_n_axes)
+{
+  gdouble *axes;
+  guint n_axes, i;
+
+  axes = clutter_event_get_axes (event, &n_axes);
+  g_assert (axes != NULL);
+  g_assert_cmpuint (n_axes, ==, expected_n_axes);
+
+  for (i = 0; i < n_axes; i++)
+    g_assert_cmpfloat (axes[i], ==, i + 0.5);
+}
+
+static void
+check_copy_and_free (ClutterInputDevice *device,
+                     ClutterInputDevice *source_device,
+                     guint               n_axes)
+{
+  ClutterEvent *event, *copy, *copy_of_copy;
+
+  event = create_motion_event (device, source_device, n_axes);
+  check_axes (event, n_axes);
+
+  copy = clutter_event_copy (event);
+  check_axes (copy, n_axes);
+  g_assert (clutter_event_get_axes (copy, NULL) !=
+            clutter_event_get_axes (event, NULL));
+
+  /* the copy must not share the storage of the original */
+  clutter_event_free (event);
+  check_axes (copy, n_axes);
+
+  copy_of_copy = clutter_event_copy (copy);
+  check_axes (copy_of_copy, n_axes);
+
+  clutter_event_free (copy);
+  check_axes (copy_of_copy, n_axes);
+
+  clutter_event_free (copy_of_copy);
+}
+
+static void
+event_axes_inline (void)
+{
+  ClutterInputDevice *device;
+
+  device = clutter_test_create_input_device (CLUTTER_TABLET_DEVICE, 4);
+  g_assert_cmpuint (clutter_input_device_get_n_axes (device), ==, 4);
+
+  check_copy_and_free (device, NULL, 4);
+
+  g_object_unref (device);
+}
+
+static void
+event_axes_allocated (void)
+{
+  ClutterInputDevice *device;
+
+  /* more axes than the ones stored inside the event */
+  device = clutter_test_create_input_device (CLUTTER_TABLET_DEVICE, 20);
+  g_assert_cmpuint (clutter_input_device_get_n_axes (device), ==, 20);
+
+  check_copy_and_free (device, NULL, 20);
+
+  g_object_unref (device);
+}
+
+static void
+event_axes_raw (void)
+{
+  ClutterInputDevice *device, *source_device;
+
+  /* the axes of raw events are the ones of the source device, which
+   * may have more axes than the device of the event
+   */
+  device = clutter_test_create_input_device (CLUTTER_POINTER_DEVICE, 2);
+  source_device = clutter_test_create_input_device (CLUTTER_TABLET_DEVICE, 4);
+
+  check_copy_and_free (device, source_device, 4);
+
+  g_object_unref (source_device);
+
+  source_device = clutter_test_create_input_device (CLUTTER_TABLET_DEVICE, 20);
+
+  check_copy_and_free (device, source_device, 20);
+
+  g_object_unref (source_device);
+  g_object_unref (device);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/event/axes/inline", event_axes_inline)
+  CLUTTER_TEST_UNIT ("/event/axes/allocated", event_axes_allocated)
+  CLUTTER_TEST_UNIT ("/event/axes/raw", event_axes_raw)
+)
@@ -0,0 +1,44 @@
+#include <clutter/clutter.h>
+
+static void
+keysyms_to_unicode (void)
+{
+  /* Latin-1 */
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_a), ==, 'a');
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_eacute), ==, 0x00e9);
+
+  /* legacy character sets */
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_Cyrillic_a), ==, 0x0430);
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_Korean_Won), ==, 0x20a9);
+
+  /* numeric keypad */
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_KP_Space), ==, ' ');
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_KP_Add), ==, '+');
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_KP_5), ==, '5');
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_KP_Equal), ==, '=');
+
+  /* outside of the direct lookup ranges */
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_EuroSign), ==, 0x20ac);
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_OE), ==, 0x0152);
+
+  /* no character */
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_KP_Enter), ==, 0);
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_F1), ==, 0);
+  g_assert_cmpuint (clutter_keysym_to_unicode (CLUTTER_KEY_Shift_L), ==, 0);
+}
+
+static void
+keysyms_from_unicode (void)
+{
+  g_assert_cmpuint (clutter_unicode_to_keysym ('a'), ==, CLUTTER_KEY_a);
+  g_assert_cmpuint (clutter_unicode_to_keysym (0x0430), ==, CLUTTER_KEY_Cyrillic_a);
+  g_assert_cmpuint (clutter_unicode_to_keysym (0x20ac), ==, CLUTTER_KEY_EuroSign);
+
+  /* characters without a key symbol are directly encoded */
+  g_assert_cmpuint (clutter_unicode_to_keysym (0x1f600), ==, 0x0101f600);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/keysyms/to-unicode", keysyms_to_unicode)
+  CLUTTER_TEST_UNIT ("/keysyms/from-unicode", keysyms_from_unicode)
+)
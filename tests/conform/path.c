@@ -1,10 +1,11 @@
+#define CLUTTER_ENABLE_EXPERIMENTAL_API
+#define COGL_ENABLE_EXPERIMENTAL_API
+
 #include <clutter/clutter.h>
 #include <cairo.h>
 #include <string.h>
 #include <math.h>
 
-#include "test-conform-common.h"
-
 #define MAX_NODES 128
 
 #define FLOAT_FUZZ_AMOUNT 5.0f
@@ -589,6 +590,112 @@ path_test_get_length (CallbackData *data)
   return TRUE;
 }
 
+static gboolean
+path_test_get_points (CallbackData *data)
+{
+  static const gdouble progress[] = { 0.0, 0.1, 0.3, 0.5, 0.2, 0.9, 1.0 };
+  ClutterPoint points[G_N_ELEMENTS (progress)];
+  ClutterPoint point;
+  gint i;
+
+  set_triangle_path (data);
+
+  clutter_path_get_points (data->path,
+                           progress, G_N_ELEMENTS (progress),
+                           points);
+
+  /* The batch results match the single point ones, even if the
+     progress values are not sorted */
+  for (i = 0; i < G_N_ELEMENTS (progress); i++)
+    {
+      clutter_path_get_point (data->path, progress[i], &point);
+
+      if (!clutter_point_equals (&point, &points[i]))
+        {
+          if (g_test_verbose ())
+            g_print ("Expected %g, %g at %g, got %g, %g instead.\n",
+                     point.x, point.y,
+                     progress[i],
+                     points[i].x, points[i].y);
+
+          return FALSE;
+        }
+    }
+
+  return TRUE;
+}
+
+static gboolean
+path_test_curve_speed (CallbackData *data)
+{
+  ClutterPoint point;
+  gint i;
+
+  /* A straight curve with both control points on its start point
+     moves very slowly at the beginning; the positions must still be
+     evenly spaced along it */
+  clutter_path_set_description (data->path, "M 0 0 C 0 0 0 0 90 0");
+
+  for (i = 0; i <= 10; i++)
+    {
+      clutter_path_get_point (data->path, i / 10.0, &point);
+
+      if (fabsf (point.x - i * 9.0f) > 0.5f || fabsf (point.y) > 0.5f)
+        {
+          if (g_test_verbose ())
+            g_print ("Expected %g, 0, got %g, %g instead.\n",
+                     i * 9.0f,
+                     point.x, point.y);
+
+          return FALSE;
+        }
+    }
+
+  set_triangle_path (data);
+
+  return TRUE;
+}
+
+static gboolean
+path_test_primitive_cache (CallbackData *data)
+{
+  CoglPrimitive *fill, *stroke;
+  gboolean ret;
+
+  set_triangle_path (data);
+
+  fill = clutter_path_get_fill_primitive (data->path);
+  stroke = clutter_path_get_stroke_primitive (data->path,
+                                              2.f,
+                                              CLUTTER_LINE_JOIN_MITER);
+
+  if (fill == NULL || stroke == NULL)
+    return FALSE;
+
+  /* The meshes are cached as long as the path does not change */
+  if (clutter_path_get_fill_primitive (data->path) != fill
+      || clutter_path_get_stroke_primitive (data->path,
+                                            2.f,
+                                            CLUTTER_LINE_JOIN_MITER) != stroke)
+    return FALSE;
+
+  cogl_object_ref (fill);
+  cogl_object_ref (stroke);
+
+  /* Changing the nodes or the line drops them */
+  set_triangle_path (data);
+
+  ret = clutter_path_get_fill_primitive (data->path) != fill
+     && clutter_path_get_stroke_primitive (data->path,
+                                           4.f,
+                                           CLUTTER_LINE_JOIN_ROUND) != stroke;
+
+  cogl_object_unref (fill);
+  cogl_object_unref (stroke);
+
+  return ret;
+}
+
 static gboolean
 path_test_boxed_type (CallbackData *data)
 {
@@ -655,6 +762,9 @@ path_tests[] =
     { "Convert to cairo path and back", path_test_convert_to_cairo_path },
     { "Clear", path_test_clear },
     { "Get position", path_test_get_position },
+    { "Get points", path_test_get_points },
+    { "Curve speed", path_test_curve_speed },
+    { "Cache fill and stroke primitives", path_test_primitive_cache },
     { "Check node boxed type", path_test_boxed_type },
     { "Get length", path_test_get_length }
   };
@@ -709,9 +819,8 @@ compare_nodes (CallbackData *data)
   return !data->nodes_different && data->nodes_found == data->n_nodes;
 }
 
-void
-path_base (TestConformSimpleFixture *fixture,
-           gconstpointer _data)
+static void
+path_base (void)
 {
   CallbackData data;
   gint i;
@@ -738,3 +847,79 @@ path_base (TestConformSimpleFixture *fixture,
   g_object_unref (data.path);
 }
 
+static void
+on_primitives_paint (ClutterActor *actor,
+                     ClutterPath  *path)
+{
+  CoglFramebuffer *fb = cogl_get_draw_framebuffer ();
+  CoglContext *ctx = clutter_backend_get_cogl_context (clutter_get_default_backend ());
+  CoglPipeline *pipeline = cogl_pipeline_new (ctx);
+
+  cogl_pipeline_set_color4ub (pipeline, 0xff, 0x00, 0x00, 0xff);
+  cogl_framebuffer_draw_primitive (fb, pipeline,
+                                   clutter_path_get_fill_primitive (path));
+
+  cogl_pipeline_set_color4ub (pipeline, 0x00, 0x00, 0xff, 0xff);
+  cogl_framebuffer_draw_primitive (fb, pipeline,
+                                   clutter_path_get_stroke_primitive (path,
+                                                                      4.f,
+                                                                      CLUTTER_LINE_JOIN_MITER));
+
+  cogl_object_unref (pipeline);
+}
+
+static void
+check_color_at_point (ClutterActor       *stage,
+                      gfloat              x,
+                      gfloat              y,
+                      const ClutterColor *color)
+{
+  ClutterPoint point = CLUTTER_POINT_INIT (x, y);
+
+  clutter_test_assert_color_at_point (stage, &point, color);
+}
+
+static void
+path_primitives (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *actor;
+  ClutterPath *path;
+
+  /* a square with a square hole, using the even-odd rule */
+  path = clutter_path_new_with_description ("M 10 10 L 90 10 L 90 90 L 10 90 z "
+                                            "M 30 30 L 70 30 L 70 70 L 30 70 z");
+
+  actor = clutter_actor_new ();
+  clutter_actor_set_background_color (actor, CLUTTER_COLOR_White);
+  clutter_actor_set_size (actor, 100, 100);
+  g_signal_connect_after (actor, "paint", G_CALLBACK (on_primitives_paint), path);
+  clutter_actor_add_child (stage, actor);
+
+  clutter_actor_show (stage);
+
+  /* inside the outer square, but outside the hole */
+  check_color_at_point (stage, 20, 50, CLUTTER_COLOR_Red);
+  check_color_at_point (stage, 50, 80, CLUTTER_COLOR_Red);
+
+  /* the hole is not filled */
+  check_color_at_point (stage, 50, 50, CLUTTER_COLOR_White);
+
+  /* outside of the path */
+  check_color_at_point (stage, 5, 50, CLUTTER_COLOR_White);
+  check_color_at_point (stage, 95, 50, CLUTTER_COLOR_White);
+
+  /* both sub-paths are stroked, centered on their outlines */
+  check_color_at_point (stage, 10, 50, CLUTTER_COLOR_Blue);
+  check_color_at_point (stage, 89, 50, CLUTTER_COLOR_Blue);
+  check_color_at_point (stage, 50, 30, CLUTTER_COLOR_Blue);
+  check_color_at_point (stage, 69, 50, CLUTTER_COLOR_Blue);
+
+  clutter_actor_destroy (actor);
+  g_object_unref (path);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/path/base", path_base)
+  CLUTTER_TEST_UNIT ("/path/primitives", path_primitives)
+)
@@ -0,0 +1,111 @@
+#include <glib/gstdio.h>
+#include <json-glib/json-glib.h>
+#include <clutter/clutter.h>
+
+static gboolean
+trace_has_event (JsonArray   *events,
+                 const gchar *name)
+{
+  guint i;
+
+  for (i = 0; i < json_array_get_length (events); i++)
+    {
+      JsonObject *event = json_array_get_object_element (events, i);
+
+      if (g_strcmp0 (json_object_get_string_member (event, "name"), name) == 0 &&
+          g_strcmp0 (json_object_get_string_member (event, "ph"), "X") == 0)
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+static void
+profiler_write_trace (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  JsonParser *parser;
+  JsonObject *root;
+  GError *error = NULL;
+  gchar *filename;
+  gint fd;
+
+  clutter_profiler_start ();
+  g_assert_true (clutter_profiler_is_running ());
+
+  clutter_actor_show (stage);
+  clutter_stage_get_actor_at_pos (CLUTTER_STAGE (stage),
+                                  CLUTTER_PICK_ALL,
+                                  10, 10);
+
+  clutter_profiler_stop ();
+  g_assert_false (clutter_profiler_is_running ());
+
+  fd = g_file_open_tmp ("clutter-profiler-XXXXXX.json", &filename, &error);
+  g_assert_no_error (error);
+  g_close (fd, NULL);
+
+  clutter_profiler_write_trace (filename, &error);
+  g_assert_no_error (error);
+
+  parser = json_parser_new ();
+  json_parser_load_from_file (parser, filename, &error);
+  g_assert_no_error (error);
+
+  root = json_node_get_object (json_parser_get_root (parser));
+  g_assert_true (json_object_has_member (root, "traceEvents"));
+  g_assert_true (trace_has_event (json_object_get_array_member (root, "traceEvents"),
+                                  "Pick"));
+
+  g_object_unref (parser);
+  g_unlink (filename);
+  g_free (filename);
+}
+
+static void
+profiler_actor_costs (void)
+{
+  ClutterActor *actor, *child;
+  ClutterProfilerActorCost cost;
+
+  clutter_profiler_set_record_actor_costs (TRUE);
+
+  actor = clutter_actor_new ();
+  child = clutter_actor_new ();
+  clutter_actor_set_size (child, 100, 100);
+  clutter_actor_add_child (actor, child);
+
+  /* the first request is a cache miss, the second is not; the child
+   * has a fixed size, so its requests never miss the cache
+   */
+  clutter_actor_get_preferred_width (actor, -1, NULL, NULL);
+  clutter_actor_get_preferred_width (actor, -1, NULL, NULL);
+
+  clutter_profiler_set_record_actor_costs (FALSE);
+
+  g_assert_true (clutter_profiler_get_actor_cost (actor,
+                                                  CLUTTER_PROFILER_COST_PREFERRED_SIZE,
+                                                  &cost));
+  g_assert_cmpuint (cost.n_calls, ==, 2);
+  g_assert_cmpuint (cost.n_cache_misses, ==, 1);
+  g_assert_cmpint (cost.exclusive_time, <=, cost.inclusive_time);
+
+  g_assert_true (clutter_profiler_get_actor_cost (child,
+                                                  CLUTTER_PROFILER_COST_PREFERRED_SIZE,
+                                                  &cost));
+  g_assert_cmpuint (cost.n_calls, >, 0);
+  g_assert_cmpuint (cost.n_cache_misses, ==, 0);
+
+  clutter_profiler_reset_actor_costs ();
+  g_assert_false (clutter_profiler_get_actor_cost (actor,
+                                                   CLUTTER_PROFILER_COST_PREFERRED_SIZE,
+                                                   &cost));
+  g_assert_cmpuint (cost.n_calls, ==, 0);
+
+  clutter_actor_destroy (actor);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/profiler/write-trace", profiler_write_trace)
+  CLUTTER_TEST_UNIT ("/profiler/actor-costs", profiler_actor_costs)
+)
@@ -0,0 +1,127 @@
+#define CLUTTER_ENABLE_EXPERIMENTAL_API
+#define COGL_ENABLE_EXPERIMENTAL_API
+
+#include <clutter/clutter.h>
+
+typedef struct {
+  ClutterActor *stage;
+  ClutterActor *child;
+
+  CoglOnscreen *onscreen;
+  CoglFrameClosure *closure;
+
+  guint n_swaps;
+  guint n_synced;
+} ThrottleData;
+
+static void
+on_frame_event (CoglOnscreen  *onscreen,
+                CoglFrameEvent event,
+                CoglFrameInfo *info,
+                void          *user_data)
+{
+  ThrottleData *data = user_data;
+
+  if (event == COGL_FRAME_EVENT_SYNC)
+    data->n_synced += 1;
+}
+
+static void
+on_stage_paint (ClutterActor *stage,
+                ThrottleData *data)
+{
+  if (data->onscreen == NULL)
+    {
+      CoglFramebuffer *fb = cogl_get_draw_framebuffer ();
+
+      g_assert (cogl_is_onscreen (fb));
+
+      data->onscreen = COGL_ONSCREEN (fb);
+      data->closure = cogl_onscreen_add_frame_callback (data->onscreen,
+                                                        on_frame_event,
+                                                        data,
+                                                        NULL);
+    }
+  else
+    {
+      /* a new frame is only drawn once all the swaps of the previous
+       * ones, including the swaps of a region, have been synchronized
+       */
+      g_assert_cmpuint (data->n_synced, >=, data->n_swaps);
+    }
+
+  /* every paint of the stage is followed by a swap */
+  data->n_swaps += 1;
+}
+
+static gboolean
+queue_child_redraw (gpointer user_data)
+{
+  ThrottleData *data = user_data;
+
+  /* only the area of the child is redrawn, and swapped */
+  clutter_actor_queue_redraw (data->child);
+
+  return TRUE;
+}
+
+static gboolean
+stop_main_loop (gpointer user_data)
+{
+  g_main_loop_quit (user_data);
+
+  return FALSE;
+}
+
+static void
+stage_frame_throttle (void)
+{
+  ThrottleData data = { NULL, };
+  GMainLoop *main_loop;
+  guint paint_id, redraw_id;
+
+  if (!clutter_feature_available (CLUTTER_FEATURE_SWAP_EVENTS))
+    {
+      g_test_skip ("The stage window does not have swap events");
+      return;
+    }
+
+  data.stage = clutter_test_get_stage ();
+
+  data.child = clutter_actor_new ();
+  clutter_actor_set_background_color (data.child, CLUTTER_COLOR_Red);
+  clutter_actor_set_position (data.child, 10, 10);
+  clutter_actor_set_size (data.child, 20, 20);
+  clutter_actor_add_child (data.stage, data.child);
+
+  paint_id = g_signal_connect (data.stage, "paint",
+                               G_CALLBACK (on_stage_paint),
+                               &data);
+
+  clutter_actor_show (data.stage);
+
+  /* request many more redraws than the frames that can be swapped */
+  main_loop = g_main_loop_new (NULL, FALSE);
+  redraw_id = g_timeout_add (1, queue_child_redraw, &data);
+  g_timeout_add (500, stop_main_loop, main_loop);
+
+  g_main_loop_run (main_loop);
+
+  g_source_remove (redraw_id);
+  g_signal_handler_disconnect (data.stage, paint_id);
+
+  if (g_test_verbose ())
+    g_print ("Swaps: %u, synchronized: %u\n", data.n_swaps, data.n_synced);
+
+  g_assert_cmpuint (data.n_swaps, >, 1);
+
+  if (data.closure != NULL)
+    cogl_onscreen_remove_frame_callback (data.onscreen, data.closure);
+
+  clutter_actor_destroy (data.child);
+  g_main_loop_unref (main_loop);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/stage/frame-throttle", stage_frame_throttle)
+)
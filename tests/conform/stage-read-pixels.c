@@ -0,0 +1,126 @@
+#include <string.h>
+#include <clutter/clutter.h>
+
+#define BUFFER_ROWSTRIDE        32
+
+typedef struct {
+  guchar buffer[4 * BUFFER_ROWSTRIDE];
+  guint n_reads;
+  gboolean buffer_read;
+  gboolean stage_read;
+} ReadPixelsData;
+
+static void
+check_red (const guchar *pixel)
+{
+  g_assert_cmpint (pixel[0], ==, 0xff);
+  g_assert_cmpint (pixel[1], ==, 0x00);
+  g_assert_cmpint (pixel[2], ==, 0x00);
+}
+
+static void
+buffer_read_cb (ClutterStage *stage,
+                const guchar *pixels,
+                gint          width,
+                gint          height,
+                gint          rowstride,
+                gpointer      user_data)
+{
+  ReadPixelsData *data = user_data;
+  gint x, y;
+
+  /* the first read-back is delivered first */
+  g_assert_cmpint (data->n_reads, ==, 0);
+  data->n_reads += 1;
+
+  g_assert (pixels == data->buffer);
+  g_assert_cmpint (width, ==, 4);
+  g_assert_cmpint (height, ==, 4);
+  g_assert_cmpint (rowstride, ==, BUFFER_ROWSTRIDE);
+
+  for (y = 0; y < height; y++)
+    {
+      for (x = 0; x < width; x++)
+        check_red (pixels + y * rowstride + x * 4);
+
+      /* the padding at the end of each row is left untouched */
+      g_assert_cmpint (pixels[y * rowstride + width * 4], ==, 0xaa);
+    }
+}
+
+static void
+buffer_read_notify (gpointer user_data)
+{
+  ReadPixelsData *data = user_data;
+
+  data->buffer_read = TRUE;
+}
+
+static void
+stage_read_cb (ClutterStage *stage,
+               const guchar *pixels,
+               gint          width,
+               gint          height,
+               gint          rowstride,
+               gpointer      user_data)
+{
+  ReadPixelsData *data = user_data;
+
+  g_assert_cmpint (data->n_reads, ==, 1);
+  data->n_reads += 1;
+
+  g_assert (pixels != NULL);
+  g_assert_cmpint (width, ==, clutter_actor_get_width (CLUTTER_ACTOR (stage)));
+  g_assert_cmpint (rowstride, >=, width * 4);
+
+  /* inside the actor */
+  check_red (pixels + 20 * rowstride + 20 * 4);
+
+  /* outside the actor */
+  g_assert_cmpint (pixels[100 * rowstride + 100 * 4 + 0], ==, 0x00);
+  g_assert_cmpint (pixels[100 * rowstride + 100 * 4 + 1], ==, 0x00);
+  g_assert_cmpint (pixels[100 * rowstride + 100 * 4 + 2], ==, 0x00);
+
+  data->stage_read = TRUE;
+}
+
+static void
+stage_read_pixels_async (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *actor;
+  ReadPixelsData data = { { 0, }, };
+
+  clutter_actor_set_background_color (stage, CLUTTER_COLOR_Black);
+
+  actor = clutter_actor_new ();
+  clutter_actor_set_background_color (actor, CLUTTER_COLOR_Red);
+  clutter_actor_set_size (actor, 50, 50);
+  clutter_actor_add_child (stage, actor);
+
+  clutter_actor_show (stage);
+
+  memset (data.buffer, 0xaa, sizeof (data.buffer));
+
+  clutter_stage_read_pixels_async (CLUTTER_STAGE (stage),
+                                   10, 10, 4, 4,
+                                   data.buffer, BUFFER_ROWSTRIDE,
+                                   buffer_read_cb,
+                                   &data,
+                                   buffer_read_notify);
+  clutter_stage_read_pixels_async (CLUTTER_STAGE (stage),
+                                   0, 0, -1, -1,
+                                   NULL, 0,
+                                   stage_read_cb,
+                                   &data,
+                                   NULL);
+
+  while (!data.buffer_read || !data.stage_read)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpint (data.n_reads, ==, 2);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/stage/read-pixels-async", stage_read_pixels_async)
+)
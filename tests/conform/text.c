@@ -533,6 +533,116 @@ text_idempotent_use_markup (void)
   clutter_actor_destroy (CLUTTER_ACTOR (text));
 }
 
+static void
+text_paint_volume_clip (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActorBox box = { 0, 0, 200, 50 };
+  const ClutterPaintVolume *volume;
+  ClutterActor *text;
+  GString *contents;
+  int i;
+
+  contents = g_string_new (NULL);
+  for (i = 0; i < 100; i++)
+    g_string_append_printf (contents, "line %d\n", i);
+
+  text = clutter_text_new_with_text ("Sans 12", contents->str);
+  clutter_actor_add_child (stage, text);
+  clutter_actor_allocate (text, &box, CLUTTER_ALLOCATION_NONE);
+
+  volume = clutter_actor_get_paint_volume (text);
+  g_assert (volume != NULL);
+
+  if (g_test_verbose ())
+    g_print ("Paint volume: %.2f x %.2f\n",
+             clutter_paint_volume_get_width (volume),
+             clutter_paint_volume_get_height (volume));
+
+  /* the layout overflows the allocation, and gets clipped to it */
+  g_assert_cmpfloat (clutter_paint_volume_get_width (volume), <=, 200.f);
+  g_assert_cmpfloat (clutter_paint_volume_get_height (volume), <=, 50.f);
+
+  clutter_actor_destroy (text);
+  g_string_free (contents, TRUE);
+}
+
+typedef struct {
+  ClutterActor *stage;
+  cairo_rectangle_int_t clip;
+  guint n_paints;
+} CursorRedrawData;
+
+static void
+on_cursor_redraw_paint (ClutterActor     *actor,
+                        CursorRedrawData *data)
+{
+  clutter_stage_get_redraw_clip_bounds (CLUTTER_STAGE (data->stage), &data->clip);
+  data->n_paints += 1;
+}
+
+static void
+wait_for_paint (CursorRedrawData *data)
+{
+  guint n_paints = data->n_paints;
+
+  while (data->n_paints == n_paints)
+    g_main_context_iteration (NULL, TRUE);
+}
+
+static void
+text_cursor_redraw_clip (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  CursorRedrawData data = { stage, };
+  ClutterActor *text;
+  gfloat text_width;
+  int i;
+
+  text = clutter_text_new_with_text ("Sans 12", "The quick brown fox jumps over the lazy dog");
+  clutter_text_set_editable (CLUTTER_TEXT (text), TRUE);
+  clutter_text_set_cursor_position (CLUTTER_TEXT (text), 0);
+  clutter_actor_add_child (stage, text);
+
+  g_signal_connect (text, "paint", G_CALLBACK (on_cursor_redraw_paint), &data);
+
+  clutter_stage_set_key_focus (CLUTTER_STAGE (stage), text);
+  clutter_actor_show (stage);
+
+  /* the stage window does not clip the first few frames */
+  for (i = 0; i < 5; i++)
+    {
+      clutter_actor_queue_redraw (stage);
+      wait_for_paint (&data);
+    }
+
+  text_width = clutter_actor_get_width (text);
+
+  clutter_text_set_cursor_position (CLUTTER_TEXT (text), 1);
+  wait_for_paint (&data);
+
+  if (g_test_verbose ())
+    g_print ("Redraw clip: %d, %d, %d x %d (text width: %.2f)\n",
+             data.clip.x, data.clip.y,
+             data.clip.width, data.clip.height,
+             text_width);
+
+  if (data.clip.width >= clutter_actor_get_width (stage) &&
+      data.clip.height >= clutter_actor_get_height (stage))
+    {
+      g_test_skip ("Clipped redraws are not supported by the stage window");
+      clutter_actor_destroy (text);
+      return;
+    }
+
+  /* only the area of the old and the new cursor is repainted */
+  g_assert_cmpint (data.clip.x, <, 20);
+  g_assert_cmpfloat (data.clip.width, <, text_width / 2);
+  g_assert_cmpfloat (data.clip.height, <=, clutter_actor_get_height (text) + 2);
+
+  clutter_actor_destroy (text);
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/text/utf8-validation", text_utf8_validation)
   CLUTTER_TEST_UNIT ("/text/set-empty", text_set_empty)
@@ -547,4 +657,6 @@ CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/text/cursor", text_cursor)
   CLUTTER_TEST_UNIT ("/text/event", text_event)
   CLUTTER_TEST_UNIT ("/text/idempotent-use-markup", text_idempotent_use_markup)
+  CLUTTER_TEST_UNIT ("/text/paint-volume-clip", text_paint_volume_clip)
+  CLUTTER_TEST_UNIT ("/text/cursor-redraw-clip", text_cursor_redraw_clip)
 )
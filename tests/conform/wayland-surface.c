@@ -0,0 +1,264 @@
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <glib/gstdio.h>
+#include <clutter/clutter.h>
+#include <clutter/wayland/clutter-wayland-surface.h>
+#include <wayland-client.h>
+
+#define WIDTH   16
+#define HEIGHT  16
+#define STRIDE  (WIDTH * 4)
+
+#define RED     0xffff0000
+#define GREEN   0xff00ff00
+#define BLUE    0xff0000ff
+
+/* the format used to upload WL_SHM_FORMAT_ARGB8888 buffers */
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+#define SHM_PIXEL_FORMAT        COGL_PIXEL_FORMAT_BGRA_8888_PRE
+#else
+#define SHM_PIXEL_FORMAT        COGL_PIXEL_FORMAT_ARGB_8888_PRE
+#endif
+
+/* a compositor and one of its clients, connected through a socket
+ * pair and dispatched in turn from the same thread
+ */
+typedef struct {
+  struct wl_display *compositor;
+  struct wl_client *client;
+
+  struct wl_display *display;
+  struct wl_registry *registry;
+  struct wl_shm *shm;
+} TestConnection;
+
+static void
+registry_handle_global (void               *data,
+                        struct wl_registry *registry,
+                        uint32_t            name,
+                        const char         *interface,
+                        uint32_t            version)
+{
+  TestConnection *conn = data;
+
+  if (strcmp (interface, "wl_shm") == 0)
+    conn->shm = wl_registry_bind (registry, name, &wl_shm_interface, 1);
+}
+
+static void
+registry_handle_global_remove (void               *data,
+                               struct wl_registry *registry,
+                               uint32_t            name)
+{
+}
+
+static const struct wl_registry_listener registry_listener = {
+  registry_handle_global,
+  registry_handle_global_remove
+};
+
+static void
+sync_done (void               *data,
+           struct wl_callback *callback,
+           uint32_t            serial)
+{
+  gboolean *done = data;
+
+  *done = TRUE;
+  wl_callback_destroy (callback);
+}
+
+static const struct wl_callback_listener sync_listener = {
+  sync_done
+};
+
+static void
+roundtrip (TestConnection *conn)
+{
+  struct wl_event_loop *loop = wl_display_get_event_loop (conn->compositor);
+  struct wl_callback *callback;
+  gboolean done = FALSE;
+
+  callback = wl_display_sync (conn->display);
+  wl_callback_add_listener (callback, &sync_listener, &done);
+
+  while (!done)
+    {
+      g_assert_cmpint (wl_display_flush (conn->display), >=, 0);
+
+      wl_event_loop_dispatch (loop, 0);
+      wl_display_flush_clients (conn->compositor);
+
+      g_assert_cmpint (wl_display_dispatch (conn->display), >=, 0);
+    }
+}
+
+static void
+test_connection_init (TestConnection *conn)
+{
+  int fds[2];
+
+  conn->compositor = wl_display_create ();
+  g_assert (conn->compositor != NULL);
+  g_assert_cmpint (wl_display_init_shm (conn->compositor), ==, 0);
+
+  g_assert_cmpint (socketpair (AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds), ==, 0);
+
+  conn->client = wl_client_create (conn->compositor, fds[0]);
+  conn->display = wl_display_connect_to_fd (fds[1]);
+  g_assert (conn->client != NULL && conn->display != NULL);
+
+  conn->registry = wl_display_get_registry (conn->display);
+  wl_registry_add_listener (conn->registry, &registry_listener, conn);
+
+  /* one round trip for the globals, one for the binding */
+  roundtrip (conn);
+  roundtrip (conn);
+  g_assert (conn->shm != NULL);
+}
+
+static void
+test_connection_clear (TestConnection *conn)
+{
+  wl_shm_destroy (conn->shm);
+  wl_registry_destroy (conn->registry);
+  wl_display_disconnect (conn->display);
+
+  wl_client_destroy (conn->client);
+  wl_display_destroy (conn->compositor);
+}
+
+static struct wl_resource *
+get_buffer_resource (TestConnection   *conn,
+                     struct wl_buffer *buffer)
+{
+  return wl_client_get_object (conn->client,
+                               wl_proxy_get_id ((struct wl_proxy *) buffer));
+}
+
+static void
+fill_rect (guint32 *pixels,
+           int      x,
+           int      y,
+           int      width,
+           int      height,
+           guint32  color)
+{
+  int i, j;
+
+  for (j = y; j < y + height; j++)
+    for (i = x; i < x + width; i++)
+      pixels[j * WIDTH + i] = color;
+}
+
+static guint32
+get_texture_pixel (CoglTexture *texture,
+                   int          x,
+                   int          y)
+{
+  guint32 pixels[WIDTH * HEIGHT];
+
+  cogl_texture_get_data (texture, SHM_PIXEL_FORMAT, STRIDE, (guint8 *) pixels);
+
+  return pixels[y * WIDTH + x];
+}
+
+static void
+wayland_surface_shm_damage (void)
+{
+  TestConnection conn = { NULL, };
+  ClutterWaylandSurface *surface;
+  struct wl_shm_pool *pool;
+  struct wl_buffer *buffers[2];
+  struct wl_resource *buffer_a, *buffer_b;
+  CoglTexture *texture_a, *texture_b;
+  guint32 *pixels_a, *pixels_b;
+  gchar *path;
+  gsize size = STRIDE * HEIGHT;
+  int fd;
+
+  test_connection_init (&conn);
+
+  fd = g_file_open_tmp ("clutter-wayland-surface-XXXXXX", &path, NULL);
+  g_assert_cmpint (fd, >=, 0);
+  g_unlink (path);
+  g_free (path);
+
+  g_assert_cmpint (ftruncate (fd, size * 2), ==, 0);
+
+  pixels_a = mmap (NULL, size * 2, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  g_assert (pixels_a != MAP_FAILED);
+  pixels_b = pixels_a + WIDTH * HEIGHT;
+
+  pool = wl_shm_create_pool (conn.shm, fd, size * 2);
+  buffers[0] = wl_shm_pool_create_buffer (pool, 0, WIDTH, HEIGHT, STRIDE,
+                                          WL_SHM_FORMAT_ARGB8888);
+  buffers[1] = wl_shm_pool_create_buffer (pool, size, WIDTH, HEIGHT, STRIDE,
+                                          WL_SHM_FORMAT_ARGB8888);
+  roundtrip (&conn);
+
+  buffer_a = get_buffer_resource (&conn, buffers[0]);
+  buffer_b = get_buffer_resource (&conn, buffers[1]);
+  g_assert (buffer_a != NULL && buffer_b != NULL);
+
+  surface = CLUTTER_WAYLAND_SURFACE (clutter_wayland_surface_new (NULL));
+  g_object_ref_sink (surface);
+
+  /* the first buffer is uploaded as a whole */
+  fill_rect (pixels_a, 0, 0, WIDTH, HEIGHT, RED);
+  fill_rect (pixels_b, 0, 0, WIDTH, HEIGHT, RED);
+
+  g_assert (clutter_wayland_surface_attach_buffer (surface, buffer_a, NULL));
+  clutter_wayland_surface_damage_buffer (surface, buffer_a, 0, 0, WIDTH, HEIGHT);
+
+  texture_a = clutter_wayland_surface_get_cogl_texture (surface);
+  g_assert (texture_a != NULL);
+  g_assert_cmphex (get_texture_pixel (texture_a, 5, 5), ==, RED);
+
+  /* the second buffer gets its own texture, and a damaged region */
+  g_assert (clutter_wayland_surface_attach_buffer (surface, buffer_b, NULL));
+
+  texture_b = clutter_wayland_surface_get_cogl_texture (surface);
+  g_assert (texture_b != NULL && texture_b != texture_a);
+
+  fill_rect (pixels_b, 4, 4, 4, 4, BLUE);
+  clutter_wayland_surface_damage_buffer (surface, buffer_b, 4, 4, 4, 4);
+
+  g_assert_cmphex (get_texture_pixel (texture_b, 5, 5), ==, BLUE);
+  g_assert_cmphex (get_texture_pixel (texture_b, 12, 12), ==, RED);
+
+  /* the client copies the damaged region into the first buffer; the
+   * pixel outside of it is changed without being damaged, so it must
+   * not make it to the texture, which is only updated with the region
+   * that was damaged while it was not in use
+   */
+  fill_rect (pixels_a, 4, 4, 4, 4, BLUE);
+  fill_rect (pixels_a, 12, 12, 1, 1, GREEN);
+
+  g_assert (clutter_wayland_surface_attach_buffer (surface, buffer_a, NULL));
+  g_assert (clutter_wayland_surface_get_cogl_texture (surface) == texture_a);
+
+  g_assert_cmphex (get_texture_pixel (texture_a, 5, 5), ==, BLUE);
+  g_assert_cmphex (get_texture_pixel (texture_a, 0, 0), ==, RED);
+  g_assert_cmphex (get_texture_pixel (texture_a, 12, 12), ==, RED);
+
+  clutter_actor_destroy (CLUTTER_ACTOR (surface));
+  g_object_unref (surface);
+
+  wl_buffer_destroy (buffers[0]);
+  wl_buffer_destroy (buffers[1]);
+  wl_shm_pool_destroy (pool);
+  roundtrip (&conn);
+
+  munmap (pixels_a, size * 2);
+  close (fd);
+
+  test_connection_clear (&conn);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/wayland-surface/shm-damage", wayland_surface_shm_damage)
+)
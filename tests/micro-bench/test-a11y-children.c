@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <atk/atk.h>
+#include <clutter/clutter.h>
+
+#define N_CHILDREN 10000
+#define N_PASSES 5
+
+static gint n_children = N_CHILDREN;
+static gint n_passes = N_PASSES;
+
+static GOptionEntry entries[] = {
+  {
+    "num-children", 'c',
+    0,
+    G_OPTION_ARG_INT, &n_children,
+    "Number of children", "CHILDREN"
+  },
+  {
+    "num-passes", 'p',
+    0,
+    G_OPTION_ARG_INT, &n_passes,
+    "Number of passes", "PASSES"
+  },
+  { NULL }
+};
+
+/* enumerates the children of @parent the way an assistive technology
+ * does, asking each child for its index in the parent as well
+ */
+static void
+enumerate_children (AtkObject *parent)
+{
+  gint i, n;
+
+  n = atk_object_get_n_accessible_children (parent);
+  for (i = 0; i < n; i++)
+    {
+      AtkObject *child = atk_object_ref_accessible_child (parent, i);
+
+      if (atk_object_get_index_in_parent (child) != i)
+        g_error ("Child %d has the wrong index in its parent", i);
+
+      g_object_unref (child);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+  ClutterActor *container, *child;
+  AtkObject *accessible;
+  GTimer *timer;
+  GError *error = NULL;
+  gint i;
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              &error) != CLUTTER_INIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  container = clutter_actor_new ();
+  g_object_ref_sink (container);
+
+  accessible = clutter_actor_get_accessible (container);
+  if (accessible == NULL)
+    {
+      g_printerr ("Accessibility is not enabled\n");
+      return EXIT_FAILURE;
+    }
+
+  printf ("Accessibility navigation test with "
+          "%d children and %d passes\n",
+          n_children,
+          n_passes);
+
+  timer = g_timer_new ();
+
+  for (i = 0; i < n_children; i++)
+    {
+      child = clutter_actor_new ();
+      clutter_actor_add_child (container, child);
+    }
+
+  printf ("Adding children: %.3f ms\n",
+          g_timer_elapsed (timer, NULL) * 1000.0);
+
+  for (i = 0; i < n_passes; i++)
+    {
+      g_timer_start (timer);
+      enumerate_children (accessible);
+      printf ("Pass %d: %.3f ms\n",
+              i + 1,
+              g_timer_elapsed (timer, NULL) * 1000.0);
+    }
+
+  g_timer_start (timer);
+
+  while ((child = clutter_actor_get_last_child (container)) != NULL)
+    clutter_actor_destroy (child);
+
+  printf ("Removing children: %.3f ms\n",
+          g_timer_elapsed (timer, NULL) * 1000.0);
+
+  g_timer_destroy (timer);
+  g_object_unref (container);
+
+  return EXIT_SUCCESS;
+}
@@ -9,6 +9,7 @@
 static int font_size;
 static int n_chars;
 static int rows, cols;
+static gboolean animate_color = FALSE;
 
 static void
 on_paint (ClutterActor *actor, gconstpointer *data)
@@ -35,9 +36,31 @@ on_paint (ClutterActor *actor, gconstpointer *data)
   ++fps;
 }
 
+static void
+update_colors (ClutterActor *stage)
+{
+  static int frame = 0;
+  ClutterActorIter iter;
+  ClutterActor *child;
+  ClutterColor color;
+
+  /* changing the color of a label does not change its layout, so
+   * this measures the cost of painting static text with a different
+   * color at each frame
+   */
+  clutter_color_from_hls (&color, (frame++ * 3) % 360, 0.75, 1.0);
+
+  clutter_actor_iter_init (&iter, stage);
+  while (clutter_actor_iter_next (&iter, &child))
+    clutter_text_set_color (CLUTTER_TEXT (child), &color);
+}
+
 static gboolean
 queue_redraw (gpointer stage)
 {
+  if (animate_color)
+    update_colors (CLUTTER_ACTOR (stage));
+
   clutter_actor_queue_redraw (CLUTTER_ACTOR (stage));
 
   return G_SOURCE_CONTINUE;
@@ -116,14 +139,15 @@ main (int argc, char *argv[])
   if (clutter_init (&argc, &argv) != CLUTTER_INIT_SUCCESS)
     return 1;
 
-  if (argc != 3)
+  if (argc != 3 && !(argc == 4 && strcmp (argv[3], "--animate-color") == 0))
     {
-      g_printerr ("Usage test-text-perf FONT_SIZE N_CHARS\n");
+      g_printerr ("Usage test-text-perf FONT_SIZE N_CHARS [--animate-color]\n");
       exit (1);
     }
 
   font_size = atoi (argv[1]);
   n_chars = atoi (argv[2]);
+  animate_color = argc == 4;
 
   g_print ("Monospace %dpx, string length = %d\n", font_size, n_chars);
 
@@ -0,0 +1,992 @@
+/* A suite of stable benchmark scenarios, meant for tracking performance
+ * regressions from one commit to the next.
+ *
+ * Each scenario runs for a fixed number of frames, after a number of
+ * warm-up frames; the time of each frame is measured between the end
+ * of two consecutive frames, so it includes event processing, the
+ * advancement of the timelines, relayout and paint. The results are
+ * printed as JSON, e.g.:
+ *
+ *   CLUTTER_BACKEND=headless ./test-benchmark --frames=500 > results.json
+ *
+ * Using the headless backend, enabled at configure time with
+ * --enable-headless-backend, is recommended, as frames are then not
+ * throttled by the vertical refresh, and transitions advance by the
+ * same amount at each frame.
+ *
+ * On GNU libc the heap allocations of each frame are counted as well;
+ * set G_SLICE=always-malloc to include the GSlice allocations.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <json-glib/json-glib.h>
+#include <clutter/clutter.h>
+
+#define N_FRAMES        300
+#define N_WARMUP        30
+
+static gint n_frames = N_FRAMES;
+static gint n_warmup = N_WARMUP;
+static gchar **scenario_names = NULL;
+static gchar *output_file = NULL;
+
+static GOptionEntry entries[] = {
+  {
+    "frames", 'f',
+    0,
+    G_OPTION_ARG_INT, &n_frames,
+    "Number of measured frames", "FRAMES"
+  },
+  {
+    "warmup", 'w',
+    0,
+    G_OPTION_ARG_INT, &n_warmup,
+    "Number of warm-up frames", "FRAMES"
+  },
+  {
+    "scenario", 's',
+    0,
+    G_OPTION_ARG_STRING_ARRAY, &scenario_names,
+    "Run only the given scenario; can be repeated", "NAME"
+  },
+  {
+    "output", 'o',
+    0,
+    G_OPTION_ARG_FILENAME, &output_file,
+    "Write the results to a file instead of the standard output", "FILE"
+  },
+  { NULL }
+};
+
+/* Allocation counting; on GNU libc we can interpose the allocator of
+ * the whole process from the executable, and forward to the real one.
+ *
+ * Every entry point that returns heap memory is counted, including the
+ * aligned ones, and the live bytes are tracked through the usable size
+ * of each block. Memory that does not come from malloc() is not seen:
+ * GSlice keeps its own magazines unless G_SLICE=always-malloc is set in
+ * the environment, and mmap() is used directly by Cogl and the drivers
+ * for buffer storage.
+ */
+#ifdef __GLIBC__
+#define HAVE_ALLOCATION_COUNT   1
+
+#include <errno.h>
+#include <malloc.h>
+
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t n_members, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+extern void *__libc_memalign (size_t alignment, size_t size);
+extern void  __libc_free (void *ptr);
+
+static volatile gint n_allocations = 0;
+static volatile gssize n_live_bytes = 0;
+
+static inline void *
+track_allocation (void *ptr)
+{
+  if (ptr != NULL)
+    {
+      g_atomic_int_inc (&n_allocations);
+      g_atomic_pointer_add (&n_live_bytes, malloc_usable_size (ptr));
+    }
+
+  return ptr;
+}
+
+static inline void
+track_release (void *ptr)
+{
+  if (ptr != NULL)
+    g_atomic_pointer_add (&n_live_bytes, - (gssize) malloc_usable_size (ptr));
+}
+
+void *
+malloc (size_t size)
+{
+  return track_allocation (__libc_malloc (size));
+}
+
+void *
+calloc (size_t n_members,
+        size_t size)
+{
+  return track_allocation (__libc_calloc (n_members, size));
+}
+
+void *
+realloc (void   *ptr,
+         size_t  size)
+{
+  void *res;
+
+  track_release (ptr);
+
+  res = __libc_realloc (ptr, size);
+
+  /* a failed reallocation leaves the original block alone */
+  if (res == NULL && ptr != NULL && size != 0)
+    {
+      g_atomic_pointer_add (&n_live_bytes, malloc_usable_size (ptr));
+      return NULL;
+    }
+
+  return track_allocation (res);
+}
+
+void *
+memalign (size_t alignment,
+          size_t size)
+{
+  return track_allocation (__libc_memalign (alignment, size));
+}
+
+void *
+aligned_alloc (size_t alignment,
+               size_t size)
+{
+  return track_allocation (__libc_memalign (alignment, size));
+}
+
+int
+posix_memalign (void   **res,
+                size_t   alignment,
+                size_t   size)
+{
+  void *ptr;
+
+  if (alignment % sizeof (void *) != 0 ||
+      (alignment & (alignment - 1)) != 0)
+    return EINVAL;
+
+  ptr = __libc_memalign (alignment, size);
+  if (ptr == NULL && size != 0)
+    return ENOMEM;
+
+  *res = track_allocation (ptr);
+
+  return 0;
+}
+
+void
+free (void *ptr)
+{
+  track_release (ptr);
+
+  __libc_free (ptr);
+}
+#endif /* __GLIBC__ */
+
+static guint
+get_allocation_count (void)
+{
+#ifdef HAVE_ALLOCATION_COUNT
+  return g_atomic_int_get (&n_allocations);
+#else
+  return 0;
+#endif
+}
+
+static gssize
+get_live_bytes (void)
+{
+#ifdef HAVE_ALLOCATION_COUNT
+  return g_atomic_pointer_add (&n_live_bytes, 0);
+#else
+  return 0;
+#endif
+}
+
+typedef struct {
+  const gchar *name;
+  const gchar *description;
+
+  void (* setup)    (ClutterActor *stage);
+  void (* frame)    (ClutterActor *stage,
+                     guint         frame_no);
+  void (* teardown) (ClutterActor *stage);
+
+  /* the number of events queued at each frame, if any */
+  guint n_events;
+} Scenario;
+
+/* The random number generator used by all scenarios; it is seeded
+ * again before each scenario, so that each run is identical
+ */
+static GRand *rand_gen = NULL;
+
+static void
+set_random_color (ClutterActor *actor)
+{
+  ClutterColor color;
+
+  color.red = g_rand_int_range (rand_gen, 0, 256);
+  color.green = g_rand_int_range (rand_gen, 0, 256);
+  color.blue = g_rand_int_range (rand_gen, 0, 256);
+  color.alpha = 255;
+
+  clutter_actor_set_background_color (actor, &color);
+}
+
+static void
+destroy_all_children (ClutterActor *stage)
+{
+  clutter_actor_destroy_all_children (stage);
+}
+
+/* actor-creation: creates and destroys a batch of actors at each frame */
+#define N_CREATED_ACTORS        500
+
+static void
+actor_creation_frame (ClutterActor *stage,
+                      guint         frame_no)
+{
+  gint i;
+
+  clutter_actor_destroy_all_children (stage);
+
+  for (i = 0; i < N_CREATED_ACTORS; i++)
+    {
+      ClutterActor *actor = clutter_actor_new ();
+
+      clutter_actor_set_position (actor, i % 25 * 20, i / 25 * 20);
+      clutter_actor_set_size (actor, 18, 18);
+      set_random_color (actor);
+
+      clutter_actor_add_child (stage, actor);
+    }
+}
+
+/* deep-relayout: changes the size of the leaf of a deep hierarchy of
+ * box layouts at each frame, which relayouts the whole chain
+ */
+#define RELAYOUT_DEPTH          100
+
+static ClutterActor *relayout_leaf = NULL;
+
+static void
+deep_relayout_setup (ClutterActor *stage)
+{
+  ClutterActor *parent = stage;
+  gint i;
+
+  for (i = 0; i < RELAYOUT_DEPTH; i++)
+    {
+      ClutterActor *box = clutter_actor_new ();
+      ClutterActor *sibling = clutter_actor_new ();
+
+      clutter_actor_set_layout_manager (box, clutter_box_layout_new ());
+
+      clutter_actor_set_size (sibling, 2, 2);
+      set_random_color (sibling);
+      clutter_actor_add_child (box, sibling);
+
+      clutter_actor_add_child (parent, box);
+      parent = box;
+    }
+
+  relayout_leaf = clutter_actor_new ();
+  set_random_color (relayout_leaf);
+  clutter_actor_add_child (parent, relayout_leaf);
+}
+
+static void
+deep_relayout_frame (ClutterActor *stage,
+                     guint         frame_no)
+{
+  clutter_actor_set_size (relayout_leaf, 10 + frame_no % 20, 10);
+}
+
+static void
+deep_relayout_teardown (ClutterActor *stage)
+{
+  relayout_leaf = NULL;
+
+  clutter_actor_destroy_all_children (stage);
+}
+
+/* picking: picks at random positions of a grid of reactive actors */
+#define PICK_GRID_SIZE          50
+#define N_PICKS                 100
+
+static void
+picking_setup (ClutterActor *stage)
+{
+  gint i, j;
+
+  for (i = 0; i < PICK_GRID_SIZE; i++)
+    {
+      for (j = 0; j < PICK_GRID_SIZE; j++)
+        {
+          ClutterActor *actor = clutter_actor_new ();
+
+          clutter_actor_set_position (actor, i * 8, j * 8);
+          clutter_actor_set_size (actor, 7, 7);
+          clutter_actor_set_reactive (actor, TRUE);
+          set_random_color (actor);
+
+          clutter_actor_add_child (stage, actor);
+        }
+    }
+}
+
+static void
+picking_frame (ClutterActor *stage,
+               guint         frame_no)
+{
+  gint i;
+
+  for (i = 0; i < N_PICKS; i++)
+    {
+      gint x = g_rand_int_range (rand_gen, 0, PICK_GRID_SIZE * 8);
+      gint y = g_rand_int_range (rand_gen, 0, PICK_GRID_SIZE * 8);
+
+      clutter_stage_get_actor_at_pos (CLUTTER_STAGE (stage),
+                                      CLUTTER_PICK_REACTIVE,
+                                      x, y);
+    }
+}
+
+/* tree-walk: paints a wide tree of small actors, and walks it at each
+ * frame reading the state of each actor
+ */
+#define TREE_FAN_OUT            10
+#define TREE_DEPTH              4
+
+static void
+tree_walk_add_children (ClutterActor *parent,
+                        gint          depth)
+{
+  gint i;
+
+  for (i = 0; i < TREE_FAN_OUT; i++)
+    {
+      ClutterActor *actor = clutter_actor_new ();
+
+      clutter_actor_set_position (actor, i * 2, depth * 2);
+      clutter_actor_set_size (actor, 2, 2);
+      set_random_color (actor);
+      clutter_actor_add_child (parent, actor);
+
+      if (depth + 1 < TREE_DEPTH)
+        tree_walk_add_children (actor, depth + 1);
+    }
+}
+
+static void
+tree_walk_setup (ClutterActor *stage)
+{
+  tree_walk_add_children (stage, 0);
+}
+
+static gfloat
+tree_walk_visit (ClutterActor *actor)
+{
+  ClutterActorIter iter;
+  ClutterActor *child;
+  ClutterActorBox box;
+  gfloat retval;
+
+  clutter_actor_get_allocation_box (actor, &box);
+  retval = clutter_actor_box_get_area (&box)
+         * clutter_actor_get_paint_opacity (actor);
+
+  clutter_actor_iter_init (&iter, actor);
+  while (clutter_actor_iter_next (&iter, &child))
+    retval += tree_walk_visit (child);
+
+  return retval;
+}
+
+static void
+tree_walk_frame (ClutterActor *stage,
+                 guint         frame_no)
+{
+  volatile gfloat total;
+
+  total = tree_walk_visit (stage);
+  (void) total;
+}
+
+/* transitions: runs an implicit transition on a large number of actors */
+#define N_TRANSITIONS           1000
+
+static void
+transitions_setup (ClutterActor *stage)
+{
+  gint i;
+
+  for (i = 0; i < N_TRANSITIONS; i++)
+    {
+      ClutterActor *actor = clutter_actor_new ();
+      ClutterTransition *transition;
+
+      clutter_actor_set_position (actor, i % 40 * 12, i / 40 * 12);
+      clutter_actor_set_size (actor, 10, 10);
+      set_random_color (actor);
+      clutter_actor_add_child (stage, actor);
+
+      transition = clutter_property_transition_new ("opacity");
+      clutter_transition_set_from (transition, G_TYPE_UINT, 255);
+      clutter_transition_set_to (transition, G_TYPE_UINT, 0);
+      clutter_timeline_set_duration (CLUTTER_TIMELINE (transition), 1000);
+      clutter_timeline_set_repeat_count (CLUTTER_TIMELINE (transition), -1);
+      clutter_timeline_set_auto_reverse (CLUTTER_TIMELINE (transition), TRUE);
+
+      clutter_actor_add_transition (actor, "fade", transition);
+      g_object_unref (transition);
+    }
+}
+
+/* text-shaping: sets new random strings on text actors at each frame */
+#define N_TEXT_ACTORS           50
+#define N_WORDS                 8
+
+static const gchar *words[] = {
+  "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing",
+  "elit", "sed", "do", "eiusmod", "tempor", "incididunt", "ut", "labore",
+  "et", "dolore", "magna", "aliqua", "ἀρχή", "λόγος", "кириллица", "שלום",
+};
+
+static void
+text_shaping_setup (ClutterActor *stage)
+{
+  gint i;
+
+  for (i = 0; i < N_TEXT_ACTORS; i++)
+    {
+      ClutterActor *text = clutter_text_new ();
+
+      clutter_text_set_font_name (CLUTTER_TEXT (text), "Sans 12px");
+      clutter_actor_set_position (text, 0, i * 16);
+      clutter_actor_add_child (stage, text);
+    }
+}
+
+static void
+text_shaping_frame (ClutterActor *stage,
+                    guint         frame_no)
+{
+  ClutterActor *child;
+  GString *buffer = g_string_new (NULL);
+
+  for (child = clutter_actor_get_first_child (stage);
+       child != NULL;
+       child = clutter_actor_get_next_sibling (child))
+    {
+      gint i;
+
+      g_string_set_size (buffer, 0);
+
+      for (i = 0; i < N_WORDS; i++)
+        {
+          gint word = g_rand_int_range (rand_gen, 0, G_N_ELEMENTS (words));
+
+          if (i > 0)
+            g_string_append_c (buffer, ' ');
+
+          g_string_append (buffer, words[word]);
+        }
+
+      clutter_text_set_text (CLUTTER_TEXT (child), buffer->str);
+    }
+
+  g_string_free (buffer, TRUE);
+}
+
+/* event-dispatch: queues key events for an actor at the bottom of a
+ * hierarchy with handlers on each level, and a motion event over a
+ * grid of reactive actors
+ */
+#define EVENT_DEPTH             20
+#define N_KEY_EVENTS            100
+
+static ClutterActor *event_focus = NULL;
+
+static gboolean
+on_event (ClutterActor *actor,
+          ClutterEvent *event,
+          gpointer      data)
+{
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+static void
+event_dispatch_setup (ClutterActor *stage)
+{
+  ClutterActor *parent = stage;
+  gint i;
+
+  picking_setup (stage);
+
+  for (i = 0; i < EVENT_DEPTH; i++)
+    {
+      ClutterActor *actor = clutter_actor_new ();
+
+      clutter_actor_set_reactive (actor, TRUE);
+      g_signal_connect (actor, "captured-event", G_CALLBACK (on_event), NULL);
+      g_signal_connect (actor, "event", G_CALLBACK (on_event), NULL);
+      clutter_actor_add_child (parent, actor);
+
+      parent = actor;
+    }
+
+  event_focus = parent;
+  clutter_stage_set_key_focus (CLUTTER_STAGE (stage), event_focus);
+}
+
+static void
+event_dispatch_frame (ClutterActor *stage,
+                      guint         frame_no)
+{
+  ClutterDeviceManager *manager = clutter_device_manager_get_default ();
+  ClutterInputDevice *pointer, *keyboard;
+  ClutterEvent *event;
+  gint i;
+
+  pointer = clutter_device_manager_get_core_device (manager, CLUTTER_POINTER_DEVICE);
+  keyboard = clutter_device_manager_get_core_device (manager, CLUTTER_KEYBOARD_DEVICE);
+
+  event = clutter_event_new (CLUTTER_MOTION);
+  clutter_event_set_stage (event, CLUTTER_STAGE (stage));
+  clutter_event_set_device (event, pointer);
+  clutter_event_set_coords (event,
+                            g_rand_int_range (rand_gen, 0, PICK_GRID_SIZE * 8),
+                            g_rand_int_range (rand_gen, 0, PICK_GRID_SIZE * 8));
+  clutter_event_put (event);
+  clutter_event_free (event);
+
+  for (i = 0; i < N_KEY_EVENTS; i++)
+    {
+      event = clutter_event_new (i % 2 == 0 ? CLUTTER_KEY_PRESS
+                                            : CLUTTER_KEY_RELEASE);
+      clutter_event_set_stage (event, CLUTTER_STAGE (stage));
+      clutter_event_set_source (event, event_focus);
+      clutter_event_set_device (event, keyboard);
+      clutter_event_set_key_symbol (event, CLUTTER_KEY_a + (i / 2) % 26);
+      clutter_event_set_key_unicode (event, 'a' + (i / 2) % 26);
+      clutter_event_put (event);
+      clutter_event_free (event);
+    }
+}
+
+static void
+event_dispatch_teardown (ClutterActor *stage)
+{
+  event_focus = NULL;
+
+  clutter_stage_set_key_focus (CLUTTER_STAGE (stage), NULL);
+  clutter_actor_destroy_all_children (stage);
+}
+
+/* key-storm: queues a large number of key events with non-Latin
+ * key symbols at each frame, most of them auto-repeats, for the
+ * same hierarchy used by event-dispatch
+ */
+#define N_STORM_EVENTS          1000
+#define STORM_REPEATS           8
+
+static void
+key_storm_frame (ClutterActor *stage,
+                 guint         frame_no)
+{
+  ClutterDeviceManager *manager = clutter_device_manager_get_default ();
+  ClutterInputDevice *keyboard;
+  ClutterEvent *event;
+  gint i;
+
+  keyboard = clutter_device_manager_get_core_device (manager, CLUTTER_KEYBOARD_DEVICE);
+
+  for (i = 0; i < N_STORM_EVENTS; i++)
+    {
+      /* each key is pressed, repeated, and then released */
+      gint step = i % (STORM_REPEATS + 2);
+      guint keyval = CLUTTER_KEY_Cyrillic_yu + (i / (STORM_REPEATS + 2)) % 32;
+
+      event = clutter_event_new (step == STORM_REPEATS + 1 ? CLUTTER_KEY_RELEASE
+                                                           : CLUTTER_KEY_PRESS);
+      clutter_event_set_stage (event, CLUTTER_STAGE (stage));
+      clutter_event_set_source (event, event_focus);
+      clutter_event_set_device (event, keyboard);
+      clutter_event_set_key_symbol (event, keyval);
+      clutter_event_set_key_unicode (event, clutter_keysym_to_unicode (keyval));
+
+      if (step > 0 && step <= STORM_REPEATS)
+        clutter_event_set_flags (event, CLUTTER_EVENT_FLAG_SYNTHETIC);
+
+      clutter_event_put (event);
+      clutter_event_free (event);
+    }
+}
+
+/* image-upload: uploads new contents into a ClutterImage at each frame */
+#define IMAGE_SIZE              512
+
+static ClutterContent *upload_image = NULL;
+static guchar *upload_data = NULL;
+
+static void
+image_upload_setup (ClutterActor *stage)
+{
+  ClutterActor *actor = clutter_actor_new ();
+
+  upload_image = clutter_image_new ();
+  upload_data = g_malloc (IMAGE_SIZE * IMAGE_SIZE * 4);
+
+  clutter_actor_set_size (actor, IMAGE_SIZE, IMAGE_SIZE);
+  clutter_actor_set_content (actor, upload_image);
+  clutter_actor_add_child (stage, actor);
+}
+
+static void
+image_upload_frame (ClutterActor *stage,
+                    guint         frame_no)
+{
+  GError *error = NULL;
+
+  memset (upload_data, frame_no & 0xff, IMAGE_SIZE * IMAGE_SIZE * 4);
+
+  if (!clutter_image_set_data (CLUTTER_IMAGE (upload_image),
+                               upload_data,
+                               COGL_PIXEL_FORMAT_RGBA_8888,
+                               IMAGE_SIZE, IMAGE_SIZE,
+                               IMAGE_SIZE * 4,
+                               &error))
+    g_error ("Unable to upload the image: %s", error->message);
+}
+
+static void
+image_upload_teardown (ClutterActor *stage)
+{
+  clutter_actor_destroy_all_children (stage);
+
+  g_clear_object (&upload_image);
+  g_clear_pointer (&upload_data, g_free);
+}
+
+static const Scenario scenarios[] = {
+  {
+    "actor-creation", "Creation and destruction of actors",
+    NULL, actor_creation_frame, destroy_all_children
+  },
+  {
+    "deep-relayout", "Relayout of a deep hierarchy of layout managers",
+    deep_relayout_setup, deep_relayout_frame, deep_relayout_teardown
+  },
+  {
+    "picking", "Picking over a large number of reactive actors",
+    picking_setup, picking_frame, destroy_all_children
+  },
+  {
+    "tree-walk", "Painting and traversal of a wide tree of actors",
+    tree_walk_setup, tree_walk_frame, destroy_all_children
+  },
+  {
+    "transitions", "Transitions running on a large number of actors",
+    transitions_setup, NULL, destroy_all_children
+  },
+  {
+    "text-shaping", "Layout and shaping of changing text",
+    text_shaping_setup, text_shaping_frame, destroy_all_children
+  },
+  {
+    "event-dispatch", "Dispatch of key and motion events",
+    event_dispatch_setup, event_dispatch_frame, event_dispatch_teardown
+  },
+  {
+    "key-storm", "Dispatch of a large number of non-Latin key events",
+    event_dispatch_setup, key_storm_frame, event_dispatch_teardown,
+    N_STORM_EVENTS
+  },
+  {
+    "image-upload", "Upload of image data at each frame",
+    image_upload_setup, image_upload_frame, image_upload_teardown
+  },
+};
+
+typedef struct {
+  const Scenario *scenario;
+  ClutterActor *stage;
+
+  guint frame_no;
+
+  gint64 last_time;
+  guint last_allocations;
+
+  gssize start_live_bytes;
+  gssize end_live_bytes;
+
+  gint64 *frame_times;
+  guint *allocations;
+} BenchmarkState;
+
+static gboolean
+pre_paint_cb (gpointer data)
+{
+  BenchmarkState *state = data;
+
+  if (state->scenario->frame != NULL)
+    state->scenario->frame (state->stage, state->frame_no);
+
+  /* keep the master clock running */
+  clutter_actor_queue_redraw (state->stage);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+post_paint_cb (gpointer data)
+{
+  BenchmarkState *state = data;
+  gint64 now = g_get_monotonic_time ();
+  guint allocations = get_allocation_count ();
+
+  if (state->last_time != 0)
+    {
+      if (state->frame_no >= n_warmup)
+        {
+          guint sample = state->frame_no - n_warmup;
+
+          state->frame_times[sample] = now - state->last_time;
+          state->allocations[sample] = allocations - state->last_allocations;
+        }
+
+      state->frame_no += 1;
+    }
+
+  state->last_time = now;
+  state->last_allocations = get_allocation_count ();
+
+  if (state->frame_no == n_warmup)
+    state->start_live_bytes = get_live_bytes ();
+
+  if (state->frame_no == n_warmup + n_frames)
+    {
+      state->end_live_bytes = get_live_bytes ();
+      clutter_main_quit ();
+    }
+
+  return G_SOURCE_CONTINUE;
+}
+
+static int
+compare_times (gconstpointer a,
+               gconstpointer b)
+{
+  gint64 time_a = *(const gint64 *) a;
+  gint64 time_b = *(const gint64 *) b;
+
+  return (time_a > time_b) - (time_a < time_b);
+}
+
+static void
+add_results (JsonBuilder          *builder,
+             const BenchmarkState *state)
+{
+  gint64 *sorted;
+  gint64 total_time = 0;
+  guint64 total_allocations = 0;
+  gint i;
+
+  for (i = 0; i < n_frames; i++)
+    {
+      total_time += state->frame_times[i];
+      total_allocations += state->allocations[i];
+    }
+
+  sorted = g_memdup (state->frame_times, sizeof (gint64) * n_frames);
+  qsort (sorted, n_frames, sizeof (gint64), compare_times);
+
+  json_builder_begin_object (builder);
+
+  json_builder_set_member_name (builder, "name");
+  json_builder_add_string_value (builder, state->scenario->name);
+  json_builder_set_member_name (builder, "description");
+  json_builder_add_string_value (builder, state->scenario->description);
+  json_builder_set_member_name (builder, "frames");
+  json_builder_add_int_value (builder, n_frames);
+  json_builder_set_member_name (builder, "warmup");
+  json_builder_add_int_value (builder, n_warmup);
+
+  /* all times are in microseconds */
+  json_builder_set_member_name (builder, "mean");
+  json_builder_add_double_value (builder, (double) total_time / n_frames);
+  json_builder_set_member_name (builder, "median");
+  json_builder_add_int_value (builder, sorted[n_frames / 2]);
+  json_builder_set_member_name (builder, "p99");
+  json_builder_add_int_value (builder, sorted[(n_frames * 99) / 100]);
+  json_builder_set_member_name (builder, "min");
+  json_builder_add_int_value (builder, sorted[0]);
+  json_builder_set_member_name (builder, "max");
+  json_builder_add_int_value (builder, sorted[n_frames - 1]);
+
+  if (state->scenario->n_events > 0 && total_time > 0)
+    {
+      json_builder_set_member_name (builder, "events-per-second");
+      json_builder_add_double_value (builder,
+                                     (double) state->scenario->n_events
+                                     * n_frames * G_USEC_PER_SEC
+                                     / total_time);
+    }
+
+#ifdef HAVE_ALLOCATION_COUNT
+  json_builder_set_member_name (builder, "allocations");
+  json_builder_add_double_value (builder, (double) total_allocations / n_frames);
+
+  /* heap growth across the measured frames, in bytes */
+  json_builder_set_member_name (builder, "live-bytes");
+  json_builder_add_int_value (builder,
+                              state->end_live_bytes - state->start_live_bytes);
+#endif
+
+  json_builder_end_object (builder);
+
+  g_free (sorted);
+}
+
+static void
+run_scenario (JsonBuilder    *builder,
+              ClutterActor   *stage,
+              const Scenario *scenario)
+{
+  BenchmarkState state = { 0, };
+  guint pre_paint_id, post_paint_id;
+
+  g_rand_set_seed (rand_gen, 12345678);
+
+  state.scenario = scenario;
+  state.stage = stage;
+  state.frame_times = g_new0 (gint64, n_frames);
+  state.allocations = g_new0 (guint, n_frames);
+
+  if (scenario->setup != NULL)
+    scenario->setup (stage);
+
+  pre_paint_id =
+    clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_PRE_PAINT |
+                                           CLUTTER_REPAINT_FLAGS_QUEUE_REDRAW_ON_ADD,
+                                           pre_paint_cb,
+                                           &state, NULL);
+  post_paint_id =
+    clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_POST_PAINT,
+                                           post_paint_cb,
+                                           &state, NULL);
+
+  clutter_main ();
+
+  clutter_threads_remove_repaint_func (pre_paint_id);
+  clutter_threads_remove_repaint_func (post_paint_id);
+
+  if (scenario->teardown != NULL)
+    scenario->teardown (stage);
+
+  add_results (builder, &state);
+
+  g_free (state.frame_times);
+  g_free (state.allocations);
+}
+
+static gboolean
+should_run (const Scenario *scenario)
+{
+  gint i;
+
+  if (scenario_names == NULL)
+    return TRUE;
+
+  for (i = 0; scenario_names[i] != NULL; i++)
+    {
+      if (strcmp (scenario_names[i], scenario->name) == 0)
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+int
+main (int argc, char *argv[])
+{
+  JsonBuilder *builder;
+  JsonGenerator *generator;
+  JsonNode *root;
+  ClutterActor *stage;
+  GError *error = NULL;
+  gint i;
+
+  /* we want free-running frames if the backend syncs to vblank */
+  g_setenv ("vblank_mode", "0", FALSE);
+  g_setenv ("CLUTTER_VBLANK", "none", FALSE);
+  g_setenv ("CLUTTER_DEFAULT_FPS", "1000", FALSE);
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              &error) != CLUTTER_INIT_SUCCESS)
+    {
+      g_printerr ("Unable to initialize Clutter: %s\n",
+                  error != NULL ? error->message : "unknown error");
+      return EXIT_FAILURE;
+    }
+
+  if (n_frames <= 0 || n_warmup < 0)
+    {
+      g_printerr ("Invalid number of frames\n");
+      return EXIT_FAILURE;
+    }
+
+  rand_gen = g_rand_new ();
+
+  stage = clutter_stage_new ();
+  clutter_actor_set_size (stage, 512, 512);
+  clutter_actor_show (stage);
+
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+  json_builder_set_member_name (builder, "scenarios");
+  json_builder_begin_array (builder);
+
+  for (i = 0; i < G_N_ELEMENTS (scenarios); i++)
+    {
+      if (!should_run (&scenarios[i]))
+        continue;
+
+      run_scenario (builder, stage, &scenarios[i]);
+    }
+
+  json_builder_end_array (builder);
+  json_builder_end_object (builder);
+
+  root = json_builder_get_root (builder);
+  generator = json_generator_new ();
+  json_generator_set_root (generator, root);
+  json_generator_set_pretty (generator, TRUE);
+
+  if (output_file != NULL)
+    {
+      if (!json_generator_to_file (generator, output_file, &error))
+        {
+          g_printerr ("Unable to write the results: %s\n", error->message);
+          return EXIT_FAILURE;
+        }
+    }
+  else
+    {
+      gchar *data = json_generator_to_data (generator, NULL);
+
+      g_print ("%s\n", data);
+      g_free (data);
+    }
+
+  json_node_free (root);
+  g_object_unref (generator);
+  g_object_unref (builder);
+
+  clutter_actor_destroy (stage);
+  g_rand_free (rand_gen);
+
+  return EXIT_SUCCESS;
+}
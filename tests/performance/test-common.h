@@ -1,10 +1,12 @@
 #include <stdlib.h>
 #include <glib.h>
 #include <clutter/clutter.h>
+#include <json-glib/json-glib.h>
 
 static GTimer *testtimer = NULL;
 static gint testframes = 0;
 static float testmaxtime = 1.0;
+static gboolean testjson = FALSE;
 
 /* initialize environment to be suitable for fps testing */
 void clutter_perf_fps_init (void)
@@ -21,6 +23,12 @@ void clutter_perf_fps_init (void)
   else
     testmaxtime = 10.0;
 
+  /* machine readable reports, e.g. for running with the headless
+   * backend in a continuous integration environment
+   */
+  if (g_strcmp0 (g_getenv ("CLUTTER_PERFORMANCE_REPORT"), "json") == 0)
+    testjson = TRUE;
+
   g_random_set_seed (12345678);
 }
 
@@ -39,8 +47,41 @@ void clutter_perf_fake_mouse (ClutterStage *stage)
 
 void clutter_perf_fps_report (const gchar *id)
 {
-  g_print ("\n@ %s: %.2f fps \n",
-       id, testframes / g_timer_elapsed (testtimer, NULL));
+  gdouble elapsed = g_timer_elapsed (testtimer, NULL);
+
+  if (testjson)
+    {
+      JsonBuilder *builder = json_builder_new ();
+      JsonGenerator *generator;
+      JsonNode *root;
+      gchar *data;
+
+      json_builder_begin_object (builder);
+      json_builder_set_member_name (builder, "test");
+      json_builder_add_string_value (builder, id);
+      json_builder_set_member_name (builder, "frames");
+      json_builder_add_int_value (builder, testframes);
+      json_builder_set_member_name (builder, "elapsed");
+      json_builder_add_double_value (builder, elapsed);
+      json_builder_set_member_name (builder, "fps");
+      json_builder_add_double_value (builder, testframes / elapsed);
+      json_builder_end_object (builder);
+
+      root = json_builder_get_root (builder);
+      generator = json_generator_new ();
+      json_generator_set_root (generator, root);
+
+      data = json_generator_to_data (generator, NULL);
+      g_print ("%s\n", data);
+
+      g_free (data);
+      json_node_free (root);
+      g_object_unref (generator);
+      g_object_unref (builder);
+    }
+  else
+    g_print ("\n@ %s: %.2f fps \n",
+             id, testframes / elapsed);
 }
 
 static void perf_stage_paint_cb (ClutterStage *stage, gpointer *data)